@@ -0,0 +1,709 @@
+// Micro benchmarks behind the figures in docs/PERFORMANCE.md. Configure with -DNDVIS_BUILD_BENCHMARKS=ON
+// and -DCMAKE_BUILD_TYPE=Release, then run `ndvis-core-bench [case ...]`; no arguments runs every case.
+// Times are per call, the best of five rounds after a warm-up.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "ndvis/detail/covariance.hpp"
+#include "ndvis/detail/dimension_dispatch.hpp"
+#include "ndvis/detail/eigen.hpp"
+#include "ndvis/detail/jacobi.hpp"
+#include "ndvis/detail/simd.hpp"
+#include "ndvis/detail/subspace.hpp"
+#include "ndvis/geometry.hpp"
+#include "ndvis/hyperplane.hpp"
+#include "ndvis/overlays.hpp"
+#include "ndvis/parallel.hpp"
+#include "ndvis/pca.hpp"
+#include "ndvis/progressive_pca.hpp"
+#include "ndvis/projection.hpp"
+#include "ndvis/qr.hpp"
+#include "ndvis/rotations.hpp"
+#include "ndvis/slice_sweep.hpp"
+#include "ndvis/streaming_pca.hpp"
+
+namespace {
+
+// Keeps results observable so the timed calls are not optimized away.
+volatile double g_sink = 0.0;
+
+// Deterministic LCG, as in the tests.
+float next_random(unsigned int& state) {
+  state = state * 1664525U + 1013904223U;
+  return static_cast<float>(state >> 8) / static_cast<float>(1U << 24) * 2.0f - 1.0f;
+}
+
+void fill_random(float* values, std::size_t count, unsigned int seed) {
+  unsigned int state = seed;
+  for (std::size_t i = 0; i < count; ++i) {
+    values[i] = next_random(state);
+  }
+}
+
+// Microseconds per call of `fn`: repeats are doubled until a round takes 20 ms, then the fastest of five
+// rounds is reported. Calls slower than 100 ms are timed once after the warm-up.
+template <typename Fn>
+double time_us(Fn&& fn) {
+  using Clock = std::chrono::steady_clock;
+  const auto elapsed_us = [](Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+  };
+  fn();
+  std::size_t repeats = 1;
+  double round_us = 0.0;
+  for (;;) {
+    const Clock::time_point start = Clock::now();
+    for (std::size_t i = 0; i < repeats; ++i) {
+      fn();
+    }
+    round_us = elapsed_us(start);
+    if (round_us >= 20000.0 || repeats >= (std::size_t{1} << 24)) {
+      break;
+    }
+    repeats *= 2;
+  }
+  double best = round_us / static_cast<double>(repeats);
+  if (best > 100000.0) {
+    return best;
+  }
+  for (int round = 0; round < 4; ++round) {
+    const Clock::time_point start = Clock::now();
+    for (std::size_t i = 0; i < repeats; ++i) {
+      fn();
+    }
+    const double per_call = elapsed_us(start) / static_cast<double>(repeats);
+    best = per_call < best ? per_call : best;
+  }
+  return best;
+}
+
+// Random Wishart matrix X^T X / m with X an m x n matrix of uniform entries, m = 2n.
+std::vector<double> wishart(std::size_t order, unsigned int seed) {
+  const std::size_t rows = 2 * order;
+  std::vector<float> samples(rows * order);
+  fill_random(samples.data(), samples.size(), seed);
+  std::vector<double> matrix(order * order, 0.0);
+  for (std::size_t r = 0; r < rows; ++r) {
+    for (std::size_t i = 0; i < order; ++i) {
+      const double xi = samples[r * order + i];
+      for (std::size_t j = 0; j < order; ++j) {
+        matrix[i * order + j] += xi * samples[r * order + j];
+      }
+    }
+  }
+  for (double& value : matrix) {
+    value /= static_cast<double>(rows);
+  }
+  return matrix;
+}
+
+// Full-spectrum Jacobi and Householder + QL, and the k = 3 subspace solve used for leading components.
+// The full solvers overwrite their input, so each call includes an n x n copy.
+void bench_eigen() {
+  std::printf("eigen: random Wishart, full spectrum (Jacobi, QL) and top-3 subspace iteration, us per solve\n");
+  std::printf("%6s %14s %14s %14s %14s %14s\n", "n", "jacobi", "ql", "subspace k=3", "ql residual",
+              "jacobi sweeps");
+  const std::size_t orders[] = {3, 6, 12, 32, 64, 128, 256, 384, 512, 768};
+  for (const std::size_t order : orders) {
+    const std::vector<double> matrix = wishart(order, 7U + static_cast<unsigned int>(order));
+    std::vector<double> work(order * order);
+    std::vector<double> vectors(order * order);
+    const auto full = [&](ndvis::detail::EigenSolver solver) {
+      ndvis::detail::EigenParams params{};
+      params.solver = solver;
+      return time_us([&] {
+        std::memcpy(work.data(), matrix.data(), matrix.size() * sizeof(double));
+        ndvis::detail::symmetric_eigen(work.data(), vectors.data(), order, params);
+        g_sink = g_sink + work[0];
+      });
+    };
+    const double jacobi = order <= 256 ? full(ndvis::detail::EigenSolver::kJacobi) : -1.0;
+    const double ql = full(ndvis::detail::EigenSolver::kTridiagonalQl);
+    double subspace = -1.0;
+    if (order >= 6) {
+      std::vector<double> values(3);
+      std::vector<double> leading(order * 3);
+      subspace = time_us([&] {
+        ndvis::detail::subspace_iteration(matrix.data(), order, 3, ndvis::detail::SubspaceParams{}, values.data(),
+                                          leading.data());
+        g_sink = g_sink + values[0];
+      });
+    }
+    ndvis::detail::JacobiReport report{};
+    std::memcpy(work.data(), matrix.data(), matrix.size() * sizeof(double));
+    ndvis::detail::EigenParams ql_params{};
+    ql_params.solver = ndvis::detail::EigenSolver::kTridiagonalQl;
+    ndvis::detail::symmetric_eigen(work.data(), vectors.data(), order, ql_params, &report);
+    ndvis::detail::JacobiReport jacobi_report{};
+    if (order <= 256) {
+      std::memcpy(work.data(), matrix.data(), matrix.size() * sizeof(double));
+      ndvis::detail::jacobi_symmetric(work.data(), vectors.data(), order, ndvis::detail::JacobiParams{},
+                                      &jacobi_report);
+    }
+    std::printf("%6zu", order);
+    for (const double value : {jacobi, ql, subspace}) {
+      if (value < 0.0) {
+        std::printf(" %14s", "-");
+      } else {
+        std::printf(" %14.2f", value);
+      }
+    }
+    std::printf(" %14.1e", report.max_residual);
+    if (order <= 256) {
+      std::printf(" %14zu\n", jacobi_report.sweeps);
+    } else {
+      std::printf(" %14s\n", "-");
+    }
+  }
+}
+
+// Levels the running CPU supports, scalar first.
+std::vector<ndvis::detail::SimdLevel> supported_simd_levels() {
+  using ndvis::detail::SimdLevel;
+  std::vector<SimdLevel> levels;
+  for (const SimdLevel level : {SimdLevel::kScalar, SimdLevel::kSse41, SimdLevel::kAvx2, SimdLevel::kAvx512,
+                                SimdLevel::kNeon, SimdLevel::kWasmSimd128}) {
+    if (ndvis::detail::simd_level_supported(level)) {
+      levels.push_back(level);
+    }
+  }
+  return levels;
+}
+
+// project_with_operator on random SoA vertices at every supported SIMD level.
+void bench_projection() {
+  std::printf("projection: project_with_operator, us per call\n");
+  const std::vector<ndvis::detail::SimdLevel> levels = supported_simd_levels();
+  std::printf("%6s %8s", "n", "V");
+  for (const ndvis::detail::SimdLevel level : levels) {
+    std::printf(" %10s", ndvis::detail::simd_level_name(level));
+  }
+  std::printf("\n");
+  const struct {
+    std::size_t dimension;
+    std::size_t vertex_count;
+  } sizes[] = {{4, 150000}, {12, 150000}, {16, 16384}, {32, 16384}};
+  for (const auto& size : sizes) {
+    std::vector<float> vertices(size.dimension * size.vertex_count);
+    fill_random(vertices.data(), vertices.size(), 11U);
+    std::vector<float> projection_operator(ndvis::kProjectionRows * size.dimension);
+    fill_random(projection_operator.data(), projection_operator.size(), 13U);
+    std::vector<float> positions(size.vertex_count * 3);
+    std::printf("%6zu %8zu", size.dimension, size.vertex_count);
+    for (const ndvis::detail::SimdLevel level : levels) {
+      ndvis::detail::set_simd_level(level);
+      std::printf(" %10.1f", time_us([&] {
+                    ndvis::project_with_operator(ndvis::ConstBufferView{vertices.data(), vertices.size()},
+                                                 size.dimension, size.vertex_count, projection_operator.data(),
+                                                 positions.data());
+                    g_sink = g_sink + positions[0];
+                  }));
+    }
+    std::printf("\n");
+  }
+  ndvis::detail::set_simd_level(ndvis::detail::detect_simd_level());
+}
+
+// All n(n-1)/2 planes through apply_rotations (fused batch) against one apply_givens call per plane.
+// Each call starts from the identity, so the copy is part of both columns.
+void bench_givens() {
+  std::printf("givens: all n(n-1)/2 planes, us per sequence\n");
+  std::printf("%6s %14s %14s\n", "n", "per-plane", "batch");
+  for (const std::size_t order : {std::size_t{4}, std::size_t{8}, std::size_t{12}, std::size_t{16},
+                                  std::size_t{32}}) {
+    std::vector<ndvis::RotationPlane> planes;
+    unsigned int state = 17U;
+    for (unsigned int i = 0; i < order; ++i) {
+      for (unsigned int j = i + 1; j < order; ++j) {
+        planes.push_back(ndvis::RotationPlane{i, j, next_random(state)});
+      }
+    }
+    std::vector<float> identity(order * order, 0.0f);
+    for (std::size_t i = 0; i < order; ++i) {
+      identity[i * order + i] = 1.0f;
+    }
+    std::vector<float> matrix(order * order);
+    const double per_plane = time_us([&] {
+      std::memcpy(matrix.data(), identity.data(), identity.size() * sizeof(float));
+      for (const ndvis::RotationPlane& plane : planes) {
+        ndvis::apply_givens(matrix.data(), order, plane);
+      }
+      g_sink = g_sink + matrix[1];
+    });
+    const double batch = time_us([&] {
+      std::memcpy(matrix.data(), identity.data(), identity.size() * sizeof(float));
+      ndvis::apply_rotations(matrix.data(), order, planes.data(), planes.size());
+      g_sink = g_sink + matrix[1];
+    });
+    std::printf("%6zu %14.3f %14.3f\n", order, per_plane, batch);
+  }
+}
+
+// Each reorthonormalize method on a rotation with float drift added, and the drift it leaves behind.
+void bench_reorthonormalize() {
+  std::printf("reorthonormalize: rotation + uniform 1e-5 noise, us per call and drift after\n");
+  std::printf("%6s %10s %12s %12s %12s %10s %10s %10s\n", "n", "drift", "gram-schmidt", "householder",
+              "newton", "gs after", "hh after", "ns after");
+  using ndvis::OrthonormalizeMethod;
+  for (const std::size_t order : {std::size_t{8}, std::size_t{16}, std::size_t{32}, std::size_t{64}}) {
+    std::vector<float> drifted(order * order, 0.0f);
+    for (std::size_t i = 0; i < order; ++i) {
+      drifted[i * order + i] = 1.0f;
+    }
+    std::vector<ndvis::RotationPlane> planes;
+    unsigned int state = 19U;
+    for (unsigned int i = 0; i < order; ++i) {
+      for (unsigned int j = i + 1; j < order; ++j) {
+        planes.push_back(ndvis::RotationPlane{i, j, next_random(state)});
+      }
+    }
+    ndvis::apply_rotations(drifted.data(), order, planes.data(), planes.size());
+    for (float& value : drifted) {
+      value += 1.0e-5f * next_random(state);
+    }
+    const float drift = ndvis::compute_orthogonality_drift(drifted.data(), order);
+    std::printf("%6zu %10.1e", order, drift);
+
+    std::vector<float> matrix(order * order);
+    float after[3] = {0.0f, 0.0f, 0.0f};
+    int column = 0;
+    for (const OrthonormalizeMethod method :
+         {OrthonormalizeMethod::kModifiedGramSchmidt, OrthonormalizeMethod::kHouseholder,
+          OrthonormalizeMethod::kNewtonSchulz}) {
+      std::vector<double> workspace(ndvis::reorthonormalize_workspace_size(order, method));
+      std::printf(" %12.2f", time_us([&] {
+                    std::memcpy(matrix.data(), drifted.data(), drifted.size() * sizeof(float));
+                    ndvis::reorthonormalize(matrix.data(), order, method, workspace.data(), workspace.size());
+                    g_sink = g_sink + matrix[0];
+                  }));
+      after[column++] = ndvis::compute_orthogonality_drift(matrix.data(), order);
+    }
+    std::printf(" %10.1e %10.1e %10.1e\n", after[0], after[1], after[2]);
+  }
+}
+
+// Kernels with per-dimension instances: n <= kMaxFixedDimension runs a fixed-n instance, larger n the
+// generic loop, so 16 against 17 shows the step between the two.
+void bench_dimension() {
+  std::printf("dimension: fixed-n instances up to n=%zu, generic above, us per call\n",
+              ndvis::detail::kMaxFixedDimension);
+  std::printf("%6s %10s %14s %14s\n", "n", "path", "drift", "gram-schmidt");
+  for (const std::size_t order : {std::size_t{4}, std::size_t{8}, std::size_t{12}, std::size_t{16},
+                                  std::size_t{17}, std::size_t{24}}) {
+    std::vector<float> rotation(order * order, 0.0f);
+    for (std::size_t i = 0; i < order; ++i) {
+      rotation[i * order + i] = 1.0f;
+    }
+    std::vector<ndvis::RotationPlane> planes;
+    unsigned int state = 23U;
+    for (unsigned int i = 0; i < order; ++i) {
+      for (unsigned int j = i + 1; j < order; ++j) {
+        planes.push_back(ndvis::RotationPlane{i, j, next_random(state)});
+      }
+    }
+    ndvis::apply_rotations(rotation.data(), order, planes.data(), planes.size());
+    std::vector<float> matrix(order * order);
+    const double drift = time_us([&] { g_sink = g_sink + ndvis::compute_orthogonality_drift(rotation.data(), order); });
+    const double gram_schmidt = time_us([&] {
+      std::memcpy(matrix.data(), rotation.data(), rotation.size() * sizeof(float));
+      ndvis::reorthonormalize(matrix.data(), order);
+      g_sink = g_sink + matrix[0];
+    });
+    std::printf("%6zu %10s %14.3f %14.3f\n", order,
+                order <= ndvis::detail::kMaxFixedDimension ? "fixed" : "generic", drift, gram_schmidt);
+  }
+}
+
+// Covariance accumulation with the scalar and the detected kernel, and the full workspace PCA on top of it.
+void bench_covariance() {
+  const ndvis::detail::SimdLevel detected = ndvis::detail::detect_simd_level();
+  std::printf("covariance: 150k random vertices, us per call (covariance scalar / %s, full PCA)\n",
+              ndvis::detail::simd_level_name(detected));
+  std::printf("%6s %14s %14s %14s\n", "n", "cov scalar", "cov simd", "pca");
+  const std::size_t vertex_count = 150000;
+  for (const std::size_t dimension : {std::size_t{4}, std::size_t{12}, std::size_t{32}}) {
+    std::vector<float> vertices(dimension * vertex_count);
+    fill_random(vertices.data(), vertices.size(), 29U);
+    std::vector<double> mean(dimension);
+    std::vector<double> covariance(dimension * dimension);
+    std::vector<double> scratch(ndvis::detail::covariance_workspace_size(dimension));
+    double covariance_us[2] = {0.0, 0.0};
+    int column = 0;
+    for (const ndvis::detail::SimdLevel level : {ndvis::detail::SimdLevel::kScalar, detected}) {
+      ndvis::detail::set_simd_level(level);
+      covariance_us[column++] = time_us([&] {
+        ndvis::detail::compute_covariance(vertices.data(), vertex_count, dimension, mean.data(), covariance.data(),
+                                          scratch.data());
+        g_sink = g_sink + covariance[0];
+      });
+    }
+    std::vector<double> workspace(ndvis::pca_workspace_size(dimension));
+    std::vector<float> basis(3 * dimension);
+    const double pca = time_us([&] {
+      ndvis::compute_pca_basis_with_workspace(vertices.data(), vertex_count, dimension, basis.data(), nullptr,
+                                              workspace.data(), workspace.size());
+      g_sink = g_sink + basis[0];
+    });
+    std::printf("%6zu %14.1f %14.1f %14.1f\n", dimension, covariance_us[0], covariance_us[1], pca);
+  }
+}
+
+// Live-feed frames: append a 100-point batch to 150k points and re-solve, against a from-scratch PCA.
+void bench_streaming() {
+  std::printf("streaming: 150k points + 100 per frame, us per frame\n");
+  std::printf("%6s %14s %14s %14s\n", "n", "streaming", "sweeps/frame", "from scratch");
+  const std::size_t vertex_count = 150000;
+  const std::size_t batch = 100;
+  const std::size_t batch_count = 64;
+  for (const std::size_t dimension : {std::size_t{4}, std::size_t{12}, std::size_t{32}}) {
+    std::vector<float> vertices(dimension * vertex_count);
+    fill_random(vertices.data(), vertices.size(), 31U);
+    // Anisotropic, so the eigenbasis is well defined and the warm start has something to keep.
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      for (std::size_t v = 0; v < vertex_count; ++v) {
+        vertices[axis * vertex_count + v] *= 1.0f + static_cast<float>(axis);
+      }
+    }
+    std::vector<float> batches(batch_count * dimension * batch);
+    fill_random(batches.data(), batches.size(), 37U);
+    for (std::size_t b = 0; b < batch_count; ++b) {
+      for (std::size_t axis = 0; axis < dimension; ++axis) {
+        for (std::size_t v = 0; v < batch; ++v) {
+          batches[(b * dimension + axis) * batch + v] *= 1.0f + static_cast<float>(axis);
+        }
+      }
+    }
+    std::vector<float> basis(3 * dimension);
+
+    ndvis::StreamingPca streaming(dimension);
+    streaming.add_batch(vertices.data(), vertex_count);
+    streaming.compute_basis(basis.data(), nullptr);
+    std::size_t sweeps = 0;
+    for (std::size_t b = 0; b < batch_count; ++b) {
+      streaming.add_batch(batches.data() + b * dimension * batch, batch);
+      ndvis::JacobiReport report{};
+      streaming.compute_basis(basis.data(), nullptr, &report);
+      sweeps += report.sweeps;
+    }
+    std::size_t frame = 0;
+    const double per_frame = time_us([&] {
+      streaming.add_batch(batches.data() + (frame++ % batch_count) * dimension * batch, batch);
+      streaming.compute_basis(basis.data(), nullptr);
+      g_sink = g_sink + basis[0];
+    });
+
+    std::vector<double> workspace(ndvis::pca_workspace_size(dimension));
+    const double scratch = time_us([&] {
+      ndvis::compute_pca_basis_with_workspace(vertices.data(), vertex_count, dimension, basis.data(), nullptr,
+                                              workspace.data(), workspace.size());
+      g_sink = g_sink + basis[0];
+    });
+    std::printf("%6zu %14.1f %14.2f %14.1f\n", dimension, per_frame,
+                static_cast<double>(sweeps) / static_cast<double>(batch_count), scratch);
+  }
+}
+
+// Progressive PCA on 2M points: the sample solve from begin(), a refine_step slice, the exact PCA, and the
+// Davis-Kahan bound next to the actual per-axis angle between the sample and exact bases.
+void bench_progressive() {
+  std::printf("progressive: 2M anisotropic points, default 8192-point sample\n");
+  std::printf("%6s %12s %14s %12s %12s %12s\n", "n", "begin us", "step 64k us", "exact us", "axis bound",
+              "axis sine");
+  const std::size_t vertex_count = 2000000;
+  const std::size_t step = 65536;
+  for (const std::size_t dimension : {std::size_t{4}, std::size_t{12}}) {
+    std::vector<float> vertices(dimension * vertex_count);
+    fill_random(vertices.data(), vertices.size(), 41U);
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      for (std::size_t v = 0; v < vertex_count; ++v) {
+        vertices[axis * vertex_count + v] *= 1.0f + static_cast<float>(axis);
+      }
+    }
+    ndvis::ProgressivePca progressive(dimension);
+    const double begin = time_us([&] { progressive.begin(vertices.data(), vertex_count); });
+    std::vector<float> sample_basis(3 * dimension);
+    ndvis::PcaConfidence confidence{};
+    progressive.approximate_basis(sample_basis.data(), nullptr, &confidence);
+
+    const double refine = time_us([&] {
+      progressive.begin(vertices.data(), vertex_count);
+      while (!progressive.refine_step(step)) {
+      }
+    });
+    const double steps = static_cast<double>((vertex_count + step - 1) / step);
+
+    std::vector<double> workspace(ndvis::pca_workspace_size(dimension));
+    std::vector<float> exact_basis(3 * dimension);
+    const double exact = time_us([&] {
+      ndvis::compute_pca_basis_with_workspace(vertices.data(), vertex_count, dimension, exact_basis.data(), nullptr,
+                                              workspace.data(), workspace.size());
+      g_sink = g_sink + exact_basis[0];
+    });
+    double worst_sine = 0.0;
+    for (std::size_t component = 0; component < 3; ++component) {
+      double dot = 0.0;
+      for (std::size_t axis = 0; axis < dimension; ++axis) {
+        dot += static_cast<double>(sample_basis[component * dimension + axis]) *
+               exact_basis[component * dimension + axis];
+      }
+      const double sine = __builtin_sqrt(1.0 - (dot * dot < 1.0 ? dot * dot : 1.0));
+      worst_sine = sine > worst_sine ? sine : worst_sine;
+    }
+    std::printf("%6zu %12.1f %14.1f %12.1f %12.3f %12.3f\n", dimension, begin, (refine - begin) / steps, exact,
+                confidence.component_error, worst_sine);
+  }
+}
+
+// The shared signed-distance pass at the scalar and detected levels, classification on top of it, and the
+// plane tests that read it on the 16-cube: slice_polytope and the overlay slice (projection included).
+void bench_distances() {
+  const ndvis::detail::SimdLevel detected = ndvis::detail::detect_simd_level();
+  std::printf("distances: 16384 random vertices, us per call (scalar / %s)\n", ndvis::detail::simd_level_name(detected));
+  std::printf("%6s %14s %14s %14s\n", "n", "dist scalar", "dist simd", "classify");
+  const std::size_t vertex_count = 16384;
+  for (const std::size_t dimension : {std::size_t{4}, std::size_t{8}, std::size_t{16}}) {
+    std::vector<float> vertices(dimension * vertex_count);
+    fill_random(vertices.data(), vertices.size(), 43U);
+    std::vector<float> normal(dimension);
+    fill_random(normal.data(), normal.size(), 47U);
+    const ndvis::Hyperplane plane{normal.data(), dimension, 0.1f};
+    const ndvis::ConstBufferView view{vertices.data(), vertices.size()};
+    std::vector<float> distances(vertex_count);
+    std::vector<int> classes(vertex_count);
+    double distance_us[2] = {0.0, 0.0};
+    int column = 0;
+    for (const ndvis::detail::SimdLevel level : {ndvis::detail::SimdLevel::kScalar, detected}) {
+      ndvis::detail::set_simd_level(level);
+      distance_us[column++] = time_us([&] {
+        ndvis::compute_signed_distances(view, vertex_count, dimension, plane, distances.data());
+        g_sink = g_sink + distances[0];
+      });
+    }
+    const double classify = time_us([&] {
+      ndvis::classify_vertices(view, vertex_count, dimension, plane, classes.data());
+      g_sink = g_sink + classes[0];
+    });
+    std::printf("%6zu %14.1f %14.1f %14.1f\n", dimension, distance_us[0], distance_us[1], classify);
+  }
+
+  const int cube_dimension = 16;
+  const std::size_t n = static_cast<std::size_t>(cube_dimension);
+  const std::size_t cube_vertices = ndvis::hypercube_vertex_count(cube_dimension);
+  const std::size_t cube_edges = ndvis::hypercube_edge_count(cube_dimension);
+  std::vector<float> vertices(cube_vertices * n);
+  std::vector<unsigned int> edges(cube_edges * 2);
+  ndvis::generate_hypercube(cube_dimension, ndvis::BufferView{vertices.data(), vertices.size()},
+                            ndvis::IndexBufferView{edges.data(), edges.size()});
+  std::vector<float> normal(n);
+  fill_random(normal.data(), normal.size(), 53U);
+  std::vector<float> points(cube_edges * n);
+  std::vector<float> workspace(ndvis::slice_workspace_size(cube_vertices));
+  const double slice = time_us([&] {
+    const ndvis::SliceResult result = ndvis::slice_polytope(
+        ndvis::ConstBufferView{vertices.data(), vertices.size()}, cube_vertices, n,
+        ndvis::ConstIndexBufferView{edges.data(), edges.size()}, ndvis::Hyperplane{normal.data(), n, 0.3f},
+        ndvis::BufferView{points.data(), points.size()}, ndvis::IndexBufferView{}, workspace.data(), workspace.size());
+    g_sink = g_sink + static_cast<double>(result.intersection_count);
+  });
+
+  std::vector<float> rotation(n * n, 0.0f);
+  for (std::size_t i = 0; i < n; ++i) {
+    rotation[i * n + i] = 1.0f;
+  }
+  std::vector<float> basis(3 * n);
+  fill_random(basis.data(), basis.size(), 59U);
+  const ndvis::GeometryInputs geometry{vertices.data(), cube_vertices, n, edges.data(), cube_edges,
+                                       rotation.data(), basis.data()};
+  const ndvis::HyperplaneInputs hyperplane{normal.data(), 0.3f, true};
+  const ndvis::CalculusInputs calculus{};
+  std::vector<float> projected(cube_vertices * 3);
+  std::vector<float> slice_positions(cube_edges * 3);
+  std::size_t slice_count = 0;
+  ndvis::OverlayBuffers buffers{};
+  buffers.projected_vertices = projected.data();
+  buffers.projected_stride = cube_vertices;
+  buffers.slice_positions = slice_positions.data();
+  buffers.slice_capacity = cube_edges;
+  buffers.slice_count = &slice_count;
+  const double overlay = time_us([&] {
+    ndvis::compute_overlays(geometry, hyperplane, calculus, buffers);
+    g_sink = g_sink + static_cast<double>(slice_count);
+  });
+  std::printf("16-cube (%zu vertices, %zu edges): slice_polytope %.1f us, overlay slice %.1f us\n", cube_vertices,
+              cube_edges, slice, overlay);
+}
+
+// side^dimension grid over [-1, 1]^dimension (SoA) with an edge between neighbours along every axis.
+struct Grid {
+  std::size_t vertex_count{0};
+  std::vector<float> vertices;
+  std::vector<unsigned int> edges;
+};
+
+Grid make_grid(std::size_t side, std::size_t dimension) {
+  Grid grid;
+  grid.vertex_count = 1;
+  for (std::size_t axis = 0; axis < dimension; ++axis) {
+    grid.vertex_count *= side;
+  }
+  grid.vertices.resize(grid.vertex_count * dimension);
+  for (std::size_t v = 0; v < grid.vertex_count; ++v) {
+    std::size_t rest = v;
+    std::size_t stride = 1;
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      const std::size_t coordinate = rest % side;
+      rest /= side;
+      grid.vertices[axis * grid.vertex_count + v] =
+          -1.0f + 2.0f * static_cast<float>(coordinate) / static_cast<float>(side - 1);
+      if (coordinate + 1 < side) {
+        grid.edges.push_back(static_cast<unsigned int>(v));
+        grid.edges.push_back(static_cast<unsigned int>(v + stride));
+      }
+      stride *= side;
+    }
+  }
+  return grid;
+}
+
+// Normal used for the offset sweeps; the offsets cover [-0.75, 0.75].
+std::vector<float> sweep_normal(std::size_t dimension) {
+  std::vector<float> normal(dimension);
+  fill_random(normal.data(), normal.size(), 61U);
+  return normal;
+}
+
+float sweep_offset(std::size_t frame, std::size_t frame_count) {
+  return -0.75f + 1.5f * static_cast<float>(frame) / static_cast<float>(frame_count - 1);
+}
+
+// A 64-frame offset sweep on the 18^4 grid through SliceSweepIndex against slice_polytope per frame.
+void bench_sweep() {
+  const std::size_t dimension = 4;
+  const std::size_t frame_count = 64;
+  const Grid grid = make_grid(18, dimension);
+  const std::size_t edge_count = grid.edges.size() / 2;
+  const std::vector<float> normal = sweep_normal(dimension);
+  const ndvis::ConstBufferView view{grid.vertices.data(), grid.vertices.size()};
+  const ndvis::ConstIndexBufferView edge_view{grid.edges.data(), grid.edges.size()};
+  std::vector<float> points(edge_count * dimension);
+
+  ndvis::SliceSweepIndex index;
+  const double build = time_us([&] { index.build(view, grid.vertex_count, dimension, edge_view, normal.data()); });
+  std::size_t hits = 0;
+  const double sweep = time_us([&] {
+    hits = 0;
+    for (std::size_t frame = 0; frame < frame_count; ++frame) {
+      hits += index.slice(sweep_offset(frame, frame_count), ndvis::BufferView{points.data(), points.size()},
+                          ndvis::IndexBufferView{})
+                  .intersection_count;
+    }
+  });
+  std::vector<float> workspace(ndvis::slice_workspace_size(grid.vertex_count));
+  const double scan = time_us([&] {
+    for (std::size_t frame = 0; frame < frame_count; ++frame) {
+      const ndvis::Hyperplane plane{normal.data(), dimension, sweep_offset(frame, frame_count)};
+      g_sink = g_sink + static_cast<double>(ndvis::slice_polytope(view, grid.vertex_count, dimension, edge_view,
+                                                                  plane, ndvis::BufferView{points.data(), points.size()},
+                                                                  ndvis::IndexBufferView{}, workspace.data(),
+                                                                  workspace.size())
+                                                .intersection_count);
+    }
+  });
+  std::printf("sweep: 18^4 grid (%zu vertices, %zu edges), %zu frames, %.0f hits per frame\n", grid.vertex_count,
+              edge_count, frame_count, static_cast<double>(hits) / static_cast<double>(frame_count));
+  std::printf("build %.1f ms, index %.3f ms per frame, full scan %.3f ms per frame\n", build / 1000.0,
+              sweep / 1000.0 / static_cast<double>(frame_count), scan / 1000.0 / static_cast<double>(frame_count));
+}
+
+// The same 64 offsets as one slice_polytope_batch call against 64 slice_polytope calls.
+void bench_batch() {
+  const std::size_t dimension = 4;
+  const std::size_t offset_count = 64;
+  const Grid grid = make_grid(18, dimension);
+  const std::size_t edge_count = grid.edges.size() / 2;
+  const std::vector<float> normal = sweep_normal(dimension);
+  const ndvis::ConstBufferView view{grid.vertices.data(), grid.vertices.size()};
+  const ndvis::ConstIndexBufferView edge_view{grid.edges.data(), grid.edges.size()};
+  std::vector<float> offsets(offset_count);
+  for (std::size_t i = 0; i < offset_count; ++i) {
+    offsets[i] = sweep_offset(i, offset_count);
+  }
+
+  std::vector<float> slice_points(edge_count * dimension);
+  std::vector<float> workspace(ndvis::slice_workspace_size(grid.vertex_count));
+  std::size_t hits = 0;
+  const double calls = time_us([&] {
+    hits = 0;
+    for (const float offset : offsets) {
+      hits += ndvis::slice_polytope(view, grid.vertex_count, dimension, edge_view,
+                                    ndvis::Hyperplane{normal.data(), dimension, offset},
+                                    ndvis::BufferView{slice_points.data(), slice_points.size()},
+                                    ndvis::IndexBufferView{}, workspace.data(), workspace.size())
+                  .intersection_count;
+    }
+  });
+  std::vector<float> batch_points(hits * dimension);
+  std::vector<std::size_t> starts(offset_count + 1);
+  const double batch = time_us([&] {
+    g_sink = g_sink + static_cast<double>(ndvis::slice_polytope_batch(
+                          view, grid.vertex_count, dimension, edge_view, normal.data(), offsets.data(), offset_count,
+                          ndvis::BufferView{batch_points.data(), batch_points.size()}, ndvis::IndexBufferView{},
+                          starts.data()));
+  });
+  std::printf("batch: 18^4 grid (%zu vertices, %zu edges), %zu offsets, %zu hits in total\n", grid.vertex_count,
+              edge_count, offset_count, hits);
+  std::printf("slice_polytope_batch %.2f ms, %zu slice_polytope calls %.2f ms\n", batch / 1000.0, offset_count,
+              calls / 1000.0);
+}
+
+struct BenchCase {
+  const char* name;
+  void (*run)();
+};
+
+constexpr BenchCase kCases[] = {
+    {"eigen", bench_eigen},
+    {"projection", bench_projection},
+    {"givens", bench_givens},
+    {"reorthonormalize", bench_reorthonormalize},
+    {"dimension", bench_dimension},
+    {"covariance", bench_covariance},
+    {"streaming", bench_streaming},
+    {"progressive", bench_progressive},
+    {"distances", bench_distances},
+    {"sweep", bench_sweep},
+    {"batch", bench_batch},
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  // Single-threaded unless a case says otherwise, so the numbers compare across machines.
+  ndvis::set_thread_count(1);
+  int status = 0;
+  for (const BenchCase& bench : kCases) {
+    bool selected = argc < 2;
+    for (int arg = 1; arg < argc; ++arg) {
+      selected = selected || std::strcmp(argv[arg], bench.name) == 0;
+    }
+    if (selected) {
+      bench.run();
+      std::printf("\n");
+    }
+  }
+  for (int arg = 1; arg < argc; ++arg) {
+    bool known = false;
+    for (const BenchCase& bench : kCases) {
+      known = known || std::strcmp(argv[arg], bench.name) == 0;
+    }
+    if (!known) {
+      std::fprintf(stderr, "unknown case: %s\n", argv[arg]);
+      status = 1;
+    }
+  }
+  return status;
+}
@@ -24,22 +24,127 @@ struct NdvisBasis3 {
   size_t dimension;
 };
 
+// Threads used by ndvis-core kernels, including the caller (0 = hardware concurrency, 1 = inline only).
+// Counts above 4x hardware concurrency (or 256) are clamped.
+void ndvis_set_thread_count(size_t count);
+size_t ndvis_get_thread_count(void);
+
 size_t ndvis_hypercube_vertex_count(int dimension);
 size_t ndvis_hypercube_edge_count(int dimension);
 void ndvis_generate_hypercube(int dimension, NdvisBuffer vertices, NdvisIndexBuffer edges);
+// 2-faces as edge lists: face f is face_edges[offsets[f] .. offsets[f + 1]) (offsets: face_count + 1; 4 edges per face)
+size_t ndvis_hypercube_face_count(int dimension);
+void ndvis_generate_hypercube_faces(int dimension, NdvisIndexBuffer offsets, NdvisIndexBuffer face_edges);
 
 size_t ndvis_simplex_vertex_count(int dimension);
 size_t ndvis_simplex_edge_count(int dimension);
 void ndvis_generate_simplex(int dimension, NdvisBuffer vertices, NdvisIndexBuffer edges);
+// Triangles, 3 edges per face
+size_t ndvis_simplex_face_count(int dimension);
+void ndvis_generate_simplex_faces(int dimension, NdvisIndexBuffer offsets, NdvisIndexBuffer face_edges);
 
 size_t ndvis_orthoplex_vertex_count(int dimension);
 size_t ndvis_orthoplex_edge_count(int dimension);
 void ndvis_generate_orthoplex(int dimension, NdvisBuffer vertices, NdvisIndexBuffer edges);
+// Triangles, 3 edges per face (one 4-edge square at dimension 2)
+size_t ndvis_orthoplex_face_count(int dimension);
+void ndvis_generate_orthoplex_faces(int dimension, NdvisIndexBuffer offsets, NdvisIndexBuffer face_edges);
 // Caller must preallocate `basis` and `vertices` buffers before invoking.
 void ndvis_compute_pca_basis(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisBasis3 basis);
 // Caller must preallocate `basis`, `vertices`, and `eigenvalues` buffers (use malloc/_malloc in WASM) before invoking.
 void ndvis_compute_pca_with_values(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisBasis3 basis, NdvisBuffer eigenvalues);
 
+// Doubles of caller workspace needed by ndvis_compute_pca_with_workspace (depends only on dimension,
+// so one buffer serves every call at that dimension).
+size_t ndvis_pca_workspace_size(size_t dimension);
+// ndvis_compute_pca_with_values without heap allocation (eigenvalues.data may be NULL).
+// Returns 0 on success, 1 on invalid inputs or a short workspace.
+int ndvis_compute_pca_with_workspace(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisBasis3 basis, NdvisBuffer eigenvalues, double* workspace, size_t workspace_length);
+
+// Eigensolver diagnostics for ndvis_compute_pca_with_report (converged: 1 once the off-diagonal norm
+// fell below tolerance, 0 if the sweep budget ran out first).
+struct NdvisJacobiReport {
+  size_t sweeps;
+  size_t rotations;
+  double off_norm;
+  double max_residual;
+  int converged;
+};
+
+// As ndvis_compute_pca_with_values, additionally filling `report` (may be NULL).
+void ndvis_compute_pca_with_report(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisBasis3 basis, NdvisBuffer eigenvalues, NdvisJacobiReport* report);
+
+enum NdvisEigenSolver {
+  NDVIS_EIGEN_SOLVER_AUTO = 0,
+  NDVIS_EIGEN_SOLVER_JACOBI = 1,
+  NDVIS_EIGEN_SOLVER_TRIDIAGONAL_QL = 2,
+};
+
+// As ndvis_compute_pca_with_report with an explicit eigensolver (AUTO picks Householder + QL from
+// dimension 6 on). `report` may be NULL; for QL its sweeps count QL iterations.
+void ndvis_compute_pca_with_solver(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisBasis3 basis, NdvisBuffer eigenvalues, int solver, NdvisJacobiReport* report);
+
+// Leading `count` principal components only (block subspace iteration for large dimensions).
+// components: count * dimension floats, one component per row. eigenvalues: count floats (data may be NULL).
+void ndvis_compute_pca_components(NdvisBuffer vertices, size_t vertex_count, size_t dimension, size_t count, NdvisBuffer components, NdvisBuffer eigenvalues);
+
+// Per-label outputs of ndvis_compute_cluster_pca (bases: label_count * 3 * dimension floats; means and
+// eigenvalues: label_count * dimension; covariances: label_count * dimension * dimension; counts:
+// label_count). Every buffer except bases may have NULL data.
+struct NdvisClusterPcaOutputs {
+  NdvisBuffer bases;
+  NdvisBuffer means;
+  NdvisBuffer covariances;
+  NdvisBuffer eigenvalues;
+  NdvisIndexBuffer counts;
+};
+
+// PCA per labeled cluster in one pass (labels: vertex_count entries; values >= label_count are skipped).
+// Returns 0 on success, 1 on invalid inputs or when a requested output is shorter than listed above.
+int ndvis_compute_cluster_pca(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisIndexBuffer labels, size_t label_count, NdvisClusterPcaOutputs outputs);
+
+// Streaming PCA over batches of points (see ndvis::StreamingPca). Batches are SoA with stride vertex_count.
+typedef struct NdvisStreamingPca NdvisStreamingPca;
+
+NdvisStreamingPca* ndvis_streaming_pca_create(size_t dimension);
+void ndvis_streaming_pca_destroy(NdvisStreamingPca* pca);
+void ndvis_streaming_pca_reset(NdvisStreamingPca* pca);
+void ndvis_streaming_pca_add(NdvisStreamingPca* pca, NdvisBuffer vertices, size_t vertex_count);
+void ndvis_streaming_pca_remove(NdvisStreamingPca* pca, NdvisBuffer vertices, size_t vertex_count);
+size_t ndvis_streaming_pca_count(const NdvisStreamingPca* pca);
+// Warm-started solve; same outputs as ndvis_compute_pca_with_report (eigenvalues.data and report may be NULL).
+void ndvis_streaming_pca_compute(NdvisStreamingPca* pca, NdvisBasis3 basis, NdvisBuffer eigenvalues, NdvisJacobiReport* report);
+
+// Progressive PCA (see ndvis::ProgressivePca): a reservoir-sample basis right after _begin, then the exact
+// basis once _refine has covered every vertex. The vertex buffer must outlive the refinement.
+typedef struct NdvisProgressivePca NdvisProgressivePca;
+
+// Davis-Kahan confidence of the sample basis (subspace_error / component_error: estimated sine of the
+// largest principal angle, in [0, 1]; exact: 1 when the sample covered every vertex).
+struct NdvisPcaConfidence {
+  size_t sample_count;
+  size_t vertex_count;
+  double eigengap;
+  double min_gap;
+  double perturbation;
+  double subspace_error;
+  double component_error;
+  int exact;
+};
+
+// sample_size 0 solves on every vertex; seed fixes the sample.
+NdvisProgressivePca* ndvis_progressive_pca_create(size_t dimension, size_t sample_size, unsigned long long seed);
+void ndvis_progressive_pca_destroy(NdvisProgressivePca* pca);
+// Returns 0 on success, 1 on invalid inputs.
+int ndvis_progressive_pca_begin(NdvisProgressivePca* pca, NdvisBuffer vertices, size_t vertex_count);
+// Processes up to max_vertices of the exact pass; returns 1 once the refined basis is available, else 0.
+int ndvis_progressive_pca_refine(NdvisProgressivePca* pca, size_t max_vertices);
+double ndvis_progressive_pca_progress(const NdvisProgressivePca* pca);
+// Sample basis (eigenvalues.data and confidence may be NULL). Returns 0 on success, 1 on invalid inputs.
+int ndvis_progressive_pca_approximate(const NdvisProgressivePca* pca, NdvisBasis3 basis, NdvisBuffer eigenvalues, NdvisPcaConfidence* confidence);
+// Exact basis. Returns 0 on success, 1 on invalid inputs or while refinement is still pending.
+int ndvis_progressive_pca_refined(const NdvisProgressivePca* pca, NdvisBasis3 basis, NdvisBuffer eigenvalues);
+
 // Overlay computation API
 struct NdvisOverlayGeometry {
   const float* vertices;
@@ -117,10 +222,58 @@ float ndvis_point_to_hyperplane_distance(const float* point, NdvisHyperplane hyp
 // Classify vertices relative to hyperplane (-1, 0, or +1)
 void ndvis_classify_vertices(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisHyperplane hyperplane, int* out_classifications);
 
+// Signed distance of every vertex to the hyperplane (SIMD over the SoA columns); out_distances holds vertex_count floats
+void ndvis_compute_signed_distances(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisHyperplane hyperplane, float* out_distances);
+
+// Classify precomputed signed distances (-1, 0, or +1)
+void ndvis_classify_distances(const float* distances, size_t count, int* out_classifications);
+
 // Slice a polytope with a hyperplane
 // Caller must preallocate out_points (dimension * max_edges) and out_edge_indices (max_edges)
 NdvisSliceResult ndvis_slice_polytope(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisIndexBuffer edges, NdvisHyperplane hyperplane, NdvisBuffer out_points, NdvisIndexBuffer out_edge_indices);
 
+// Floats of workspace ndvis_slice_polytope_with_workspace needs for vertex_count vertices
+size_t ndvis_slice_workspace_size(size_t vertex_count);
+
+// ndvis_slice_polytope without heap allocation; returns an empty result if workspace_length is short
+NdvisSliceResult ndvis_slice_polytope_with_workspace(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisIndexBuffer edges, NdvisHyperplane hyperplane, NdvisBuffer out_points, NdvisIndexBuffer out_edge_indices, float* workspace, size_t workspace_length);
+
+// Slice with distances from ndvis_compute_signed_distances (vertex_count floats), e.g. kept from an earlier frame
+NdvisSliceResult ndvis_slice_polytope_with_distances(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisIndexBuffer edges, const float* distances, NdvisBuffer out_points, NdvisIndexBuffer out_edge_indices);
+
+// Slice an implicit hypercube (no vertex/edge buffers); matches slicing generate_hypercube data up to distance
+// rounding (see ndvis::slice_hypercube)
+NdvisSliceResult ndvis_slice_hypercube(int dimension, NdvisHyperplane hyperplane, NdvisBuffer out_points, NdvisIndexBuffer out_edge_indices);
+
+// Slice at offset_count offsets of one normal in a single edge pass (see ndvis::slice_polytope_batch).
+// Slice k: out_slice_starts[k]..out_slice_starts[k + 1] (offset_count + 1 entries); its points are an SoA
+// block at out_points.data + dimension * out_slice_starts[k]. Returns the total intersection count.
+size_t ndvis_slice_polytope_batch(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisIndexBuffer edges, const float* normal, const float* offsets, size_t offset_count, NdvisBuffer out_points, NdvisIndexBuffer out_edge_indices, size_t* out_slice_starts);
+
+// Cross-section as a wireframe (see ndvis::slice_section): distinct section vertices (SoA in out_points,
+// stride vertex_count) and index pairs joining the ones that share a 2-face, so it renders without a
+// connectivity pass. out_edges and out_vertex_edges (source edge per section vertex) may have NULL data.
+struct NdvisSectionResult {
+  size_t vertex_count;
+  size_t edge_count;
+  NdvisBuffer points;  // dimension * vertex_count
+  NdvisIndexBuffer edges;  // 2 * edge_count
+  int truncated;  // 1 when out_points or out_edges was too small
+};
+
+NdvisSectionResult ndvis_slice_section(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisIndexBuffer edges, NdvisIndexBuffer face_offsets, NdvisIndexBuffer face_edges, NdvisHyperplane hyperplane, NdvisBuffer out_points, NdvisIndexBuffer out_edges, NdvisIndexBuffer out_vertex_edges);
+
+// Offset sweep index (see ndvis::SliceSweepIndex): built once per geometry and normal, then each
+// _slice returns what ndvis_slice_polytope would at that offset in O(log E + K). The vertex and edge
+// buffers must outlive the index or the next _build.
+typedef struct NdvisSliceSweep NdvisSliceSweep;
+
+NdvisSliceSweep* ndvis_slice_sweep_create(void);
+void ndvis_slice_sweep_destroy(NdvisSliceSweep* sweep);
+// normal: dimension floats. Returns 0 on success, 1 on invalid inputs.
+int ndvis_slice_sweep_build(NdvisSliceSweep* sweep, NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisIndexBuffer edges, const float* normal);
+NdvisSliceResult ndvis_slice_sweep_slice(NdvisSliceSweep* sweep, float offset, NdvisBuffer out_points, NdvisIndexBuffer out_edge_indices);
+
 // Rotation API
 struct NdvisRotationPlane {
   unsigned int i;
@@ -143,12 +296,106 @@ void ndvis_project_geometry(
 // Apply a batch of Givens rotation planes to a rotation matrix (in-place, row-major)
 void ndvis_apply_rotations(float* matrix, size_t order, const NdvisRotationPlane* planes, size_t plane_count);
 
+// Exact 4D rotation state: left/right unit quaternions (w, x, y, z), R v = left * v * right.
+// Orthogonal by construction; rebuild the 4x4 matrix only when projecting.
+struct NdvisRotation4 {
+  float left[4];
+  float right[4];
+};
+
+void ndvis_rotation4_identity(NdvisRotation4* rotation);
+
+// Same effect as ndvis_apply_rotations on the 4x4 matrix (planes with i or j >= 4 are skipped)
+void ndvis_rotation4_apply(NdvisRotation4* rotation, const NdvisRotationPlane* planes, size_t plane_count);
+
+// Write the row-major 4x4 matrix (16 floats)
+void ndvis_rotation4_to_matrix(const NdvisRotation4* rotation, float* out_matrix);
+
+// Drift-driven re-orthonormalization (layout shared with ndvis::DriftScheduler). Initialize with
+// ndvis_drift_scheduler_init; the counters report how often the sampled check and QR actually ran.
+struct NdvisDriftScheduler {
+  float threshold;
+  size_t sample_pairs;
+  float rounding_bound;
+  float last_estimate;
+  size_t sample_cursor;
+  size_t steps;
+  size_t checks;
+  size_t reorthonormalizations;
+};
+
+void ndvis_drift_scheduler_init(NdvisDriftScheduler* scheduler, float threshold);
+
+// Apply planes and re-orthonormalize only when the drift estimate crosses the threshold.
+// Returns 1 when QR ran this call, 0 otherwise.
+int ndvis_apply_rotations_scheduled(NdvisDriftScheduler* scheduler, float* matrix, size_t order, const NdvisRotationPlane* planes, size_t plane_count);
+
+enum NdvisExpMapMethod {
+  NDVIS_EXPMAP_CAYLEY = 0,
+  NDVIS_EXPMAP_PADE = 1,
+};
+
+// Rotate by per-plane angular velocities (theta = radians per unit time) over dt in a single step:
+// R <- R * exp(Omega * dt), Omega skew-symmetric with Omega[i][j] = theta. Returns 0 on success.
+int ndvis_apply_angular_velocity(float* matrix, size_t order, const NdvisRotationPlane* velocities, size_t velocity_count, float dt, int method);
+
+// Skew generator Omega (order * order floats, row-major) from per-plane angular velocities, for callers
+// that keep it across frames.
+void ndvis_build_rotation_generator(const NdvisRotationPlane* velocities, size_t velocity_count, size_t order, float* out_generator);
+
+// Doubles of caller workspace needed by ndvis_apply_angular_velocity_with_workspace for `method`.
+size_t ndvis_angular_velocity_workspace_size(size_t order, int method);
+
+// R <- R * exp(generator * dt) without allocating. Returns 0 on success, 1 on invalid inputs, a short
+// workspace or a singular denominator.
+int ndvis_apply_angular_velocity_with_workspace(float* matrix, size_t order, const float* generator, float dt, int method, double* workspace, size_t workspace_length);
+
+// Build the fused projection operator M = basis3^T * R (3 * dimension floats, row-major)
+void ndvis_build_projection_operator(
+    const float* rotation_matrix,
+    size_t rotation_stride,
+    const float* basis3,
+    size_t basis_stride,
+    size_t dimension,
+    float* out_operator);
+
+// Incrementally re-project after applying `planes` to R (call ndvis_apply_rotations with the same planes).
+// Rotates `projection_operator` in place and updates `positions` (vertex_count * 3) in O(V * touched axes).
+void ndvis_project_geometry_incremental(
+    const float* vertices,
+    size_t vertex_count,
+    size_t dimension,
+    float* projection_operator,
+    const NdvisRotationPlane* planes,
+    size_t plane_count,
+    float* positions,
+    size_t positions_length);
+
+// Project generated polytopes straight from the operator without reading vertices.
+// positions_length must cover vertex_count * 3 for the given generator and dimension.
+void ndvis_project_hypercube(int dimension, const float* projection_operator, float* positions, size_t positions_length);
+void ndvis_project_simplex(int dimension, const float* projection_operator, float* positions, size_t positions_length);
+void ndvis_project_orthoplex(int dimension, const float* projection_operator, float* positions, size_t positions_length);
+
 // Compute orthogonality drift metric: Frobenius norm of (R^T R - I)
 float ndvis_compute_orthogonality_drift(const float* matrix, size_t order);
 
 // Re-orthonormalize a rotation matrix using QR decomposition (modified Gram-Schmidt)
 void ndvis_reorthonormalize(float* matrix, size_t order);
 
+enum NdvisOrthonormalizeMethod {
+  NDVIS_ORTHONORMALIZE_GRAM_SCHMIDT = 0,
+  NDVIS_ORTHONORMALIZE_HOUSEHOLDER = 1,
+  NDVIS_ORTHONORMALIZE_NEWTON_SCHULZ = 2,
+};
+
+// Doubles of caller workspace needed by ndvis_reorthonormalize_with_workspace for `method`.
+size_t ndvis_reorthonormalize_workspace_size(size_t order, int method);
+
+// Re-orthonormalize with a selectable algorithm (double accumulation for Householder/Newton-Schulz)
+// without allocating. Returns 0 on success, 1 on invalid inputs or a short workspace.
+int ndvis_reorthonormalize_with_workspace(float* matrix, size_t order, int method, double* workspace, size_t workspace_length);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+
+namespace ndvis::detail {
+
+// Sample mean and covariance (normalized by vertex_count - 1, or 1 for a single vertex) of SoA vertices,
+// accumulated in double. out_mean: dimension doubles. out_covariance: dimension x dimension, symmetric.
+// Vertices are split into at most 8 partials whose bounds depend only on vertex_count, accumulated on the
+// worker pool and reduced in order, so the result is bitwise identical for any thread count.
+// vertex_count must be nonzero.
+void compute_covariance(const float* vertices, std::size_t vertex_count, std::size_t dimension, double* out_mean,
+                        double* out_covariance);
+
+// Doubles of scratch compute_covariance needs; independent of vertex_count.
+[[nodiscard]] std::size_t covariance_workspace_size(std::size_t dimension);
+
+// Allocation-free form: `workspace` holds covariance_workspace_size(dimension) doubles.
+void compute_covariance(const float* vertices, std::size_t vertex_count, std::size_t dimension, double* out_mean,
+                        double* out_covariance, double* workspace);
+
+// As above with axis columns `stride` floats apart (stride >= vertex_count): passing vertices + begin and
+// the full array's vertex count as the stride covers [begin, begin + vertex_count) of a larger SoA array.
+void compute_covariance_strided(const float* vertices, std::size_t vertex_count, std::size_t stride,
+                                std::size_t dimension, double* out_mean, double* out_covariance, double* workspace);
+
+}  // namespace ndvis::detail
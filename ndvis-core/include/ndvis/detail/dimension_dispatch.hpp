@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace ndvis::detail {
+
+// Dimensions with compile-time specialized kernels. Kernels are templates on a dimension `Dim`
+// where Dim == 0 is the generic runtime-dimension path, used outside this range.
+inline constexpr std::size_t kMinFixedDimension = 2;
+inline constexpr std::size_t kMaxFixedDimension = 16;
+
+// Unrolls an axis loop: completely when the trip count is a template dimension, and by 16 with a
+// computed entry point when it is only known at run time.
+#if defined(__clang__) || defined(__GNUC__)
+#define NDVIS_UNROLL_DIMENSION _Pragma("GCC unroll 16")
+#else
+#define NDVIS_UNROLL_DIMENSION
+#endif
+
+// The runtime dimension a Dim-templated kernel should loop over.
+template <std::size_t Dim>
+[[nodiscard]] constexpr std::size_t fixed_or(std::size_t dimension) {
+  return Dim != 0 ? Dim : dimension;
+}
+
+// Maker provides `template <std::size_t Dim> static constexpr Entry get()` returning the kernel for Dim.
+// The table holds get<kMinFixedDimension>() .. get<kMaxFixedDimension>().
+template <typename Maker>
+[[nodiscard]] constexpr auto make_dimension_table() {
+  return []<std::size_t... Offset>(std::index_sequence<Offset...>) {
+    using Entry = decltype(Maker::template get<kMinFixedDimension>());
+    return std::array<Entry, sizeof...(Offset)>{Maker::template get<Offset + kMinFixedDimension>()...};
+  }(std::make_index_sequence<kMaxFixedDimension - kMinFixedDimension + 1>{});
+}
+
+// Specialized kernel for `dimension`, or the generic get<0>() outside the fixed range.
+template <typename Maker>
+[[nodiscard]] auto select_for_dimension(std::size_t dimension) {
+  static constexpr auto table = make_dimension_table<Maker>();
+  if (dimension < kMinFixedDimension || dimension > kMaxFixedDimension) {
+    return Maker::template get<0>();
+  }
+  return table[dimension - kMinFixedDimension];
+}
+
+}  // namespace ndvis::detail
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+
+#include "ndvis/detail/jacobi.hpp"
+
+namespace ndvis::detail {
+
+enum class EigenSolver {
+  // Jacobi below kTridiagonalMinOrder, Householder + QL from there on.
+  kAuto,
+  kJacobi,
+  kTridiagonalQl,
+};
+
+// From this order on, Householder + QL beats cyclic Jacobi (see docs/PERFORMANCE.md).
+constexpr std::size_t kTridiagonalMinOrder = 6;
+
+struct EigenParams {
+  EigenSolver solver{EigenSolver::kAuto};
+  JacobiParams jacobi{};
+  // QL iterations allowed per eigenvalue; two or three are typical.
+  std::size_t max_ql_iterations{30};
+};
+
+// Householder reduction to tridiagonal form (tred2) followed by implicit-shift QL (tql2), O(n^3) with a
+// small constant and no sweep count to tune. Same contract as jacobi_symmetric: on return `matrix` holds
+// the eigenvalues on its diagonal (zeros elsewhere) and `eigenvectors` the eigenvectors as columns. In the
+// report, `sweeps` counts QL iterations and `rotations` the plane rotations applied; residuals are only
+// computed when a report is requested. Allocation-free unless a report is requested.
+void tridiagonal_ql_symmetric(double* matrix, double* eigenvectors, std::size_t order, std::size_t max_iterations,
+                              JacobiReport* report = nullptr);
+
+// Dispatches to jacobi_symmetric or tridiagonal_ql_symmetric per params.solver.
+void symmetric_eigen(double* matrix, double* eigenvectors, std::size_t order, const EigenParams& params,
+                     JacobiReport* report = nullptr);
+
+}  // namespace ndvis::detail
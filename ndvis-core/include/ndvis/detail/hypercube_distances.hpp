@@ -0,0 +1,54 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "ndvis/hyperplane.hpp"
+
+namespace ndvis::detail {
+
+// Implicit hypercube distances: the vertex index is cut into groups of kDistanceTableBits bits and
+// each group's partial dot product sum_a (+/-1) * normal[a] is tabulated once (in double).
+constexpr int kDistanceTableBits = 11;
+constexpr int kMaxDistanceTables = 3;  // covers the 31-bit kMaxDimension of geometry.cpp
+
+// Signed distance normal . v - offset of implicit hypercube vertex v (coordinates +/-1 from the index bits),
+// without materializing the cube.
+class HypercubeDistances {
+ public:
+  HypercubeDistances(int dimension, const Hyperplane& hyperplane) : offset_(hyperplane.offset) {
+    for (int first = 0; first < dimension && group_count_ < kMaxDistanceTables; first += kDistanceTableBits) {
+      const int bits = std::min(kDistanceTableBits, dimension - first);
+      auto& table = tables_[group_count_];
+      table.resize(static_cast<std::size_t>(1) << bits);
+      for (std::size_t entry = 0; entry < table.size(); ++entry) {
+        double sum = 0.0;
+        for (int bit = 0; bit < bits; ++bit) {
+          const double normal = hyperplane.normal[first + bit];
+          sum += ((entry >> bit) & 1U) ? normal : -normal;
+        }
+        table[entry] = sum;
+      }
+      shifts_[group_count_] = first;
+      ++group_count_;
+    }
+  }
+
+  float operator()(std::size_t vertex) const {
+    double sum = 0.0;
+    for (int group = 0; group < group_count_; ++group) {
+      const auto& table = tables_[group];
+      sum += table[(vertex >> shifts_[group]) & (table.size() - 1)];
+    }
+    return static_cast<float>(sum - offset_);
+  }
+
+ private:
+  std::vector<double> tables_[kMaxDistanceTables];
+  int shifts_[kMaxDistanceTables]{};
+  int group_count_{0};
+  double offset_;
+};
+
+}  // namespace ndvis::detail
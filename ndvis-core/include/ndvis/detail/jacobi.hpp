@@ -5,14 +5,34 @@
 namespace ndvis::detail {
 
 struct JacobiParams {
-  // Maximum number of sweeps to perform; higher values improve convergence on ill-conditioned matrices.
+  // Maximum number of cyclic sweeps; each sweep visits all order * (order - 1) / 2 pivots.
+  // Convergence is quadratic once the pivots are small, so 6-10 sweeps are typical for n <= 64.
   std::size_t max_sweeps{32};
-  // Absolute tolerance for stopping once all off-diagonal elements fall below this threshold.
+  // Stop once the off-diagonal Frobenius norm falls below tolerance * ||A||_F of the input matrix.
   double tolerance{1.0e-10};
 };
 
-void jacobi_symmetric(double* matrix, double* eigenvectors, std::size_t order, const JacobiParams& params);
+struct JacobiReport {
+  // Sweeps actually performed and rotations applied across them (pivots below threshold are skipped).
+  std::size_t sweeps{0};
+  std::size_t rotations{0};
+  // Off-diagonal Frobenius norm left in the diagonalized matrix.
+  double off_norm{0.0};
+  // max_k ||A v_k - lambda_k v_k||_2 against the input matrix.
+  double max_residual{0.0};
+  bool converged{false};
+};
+
+// Row-cyclic threshold Jacobi. On return `matrix` holds the eigenvalues on its diagonal and
+// `eigenvectors` the eigenvectors as columns (row-major). `report` is optional; filling its residual
+// keeps a copy of the input, so pass nullptr when it is not needed.
+void jacobi_symmetric(double* matrix, double* eigenvectors, std::size_t order, const JacobiParams& params,
+                      JacobiReport* report = nullptr);
 void sort_eigenpairs(double* eigenvalues, double* eigenvectors, std::size_t order);
 
-}  // namespace ndvis::detail
+// max_k ||A v_k - lambda_k v_k||_2 with lambda_k on the diagonal of `diagonalized` and v_k the columns
+// of `eigenvectors` (the JacobiReport::max_residual of any solver with this output layout).
+[[nodiscard]] double max_eigen_residual(const double* input, const double* diagonalized, const double* eigenvectors,
+                                        std::size_t order);
 
+}  // namespace ndvis::detail
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+
+#include "ndvis/detail/simd.hpp"
+
+namespace ndvis::detail {
+
+// Projects vertices [begin, end) of an axis-major SoA buffer with a 3 x dimension operator,
+// writing interleaved xyz to out_positions[v * 3].
+using ProjectKernel = void (*)(const float* vertices, std::size_t vertex_count, std::size_t dimension,
+                               const float* projection_operator, float* out_positions, std::size_t begin,
+                               std::size_t end);
+
+[[nodiscard]] ProjectKernel select_project_kernel(SimdLevel level);
+[[nodiscard]] ProjectKernel active_project_kernel();
+
+// Signed distances normal . v - offset of vertices [begin, end) of an axis-major SoA buffer. Every level
+// multiplies and adds separately in axis order (no fused multiply-add), so all levels return the scalar
+// kernel's bits and classification does not depend on the CPU.
+using DistanceKernel = void (*)(const float* vertices, std::size_t vertex_count, std::size_t dimension,
+                                const float* normal, float offset, float* out_distances, std::size_t begin,
+                                std::size_t end);
+
+[[nodiscard]] DistanceKernel select_distance_kernel(SimdLevel level);
+[[nodiscard]] DistanceKernel active_distance_kernel();
+
+}  // namespace ndvis::detail
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+
+namespace ndvis::detail {
+
+// Instruction-set tiers for the vectorized kernels, ordered from weakest to strongest per family.
+enum class SimdLevel {
+  kScalar = 0,
+  kSse41,
+  kAvx2,
+  kAvx512,
+  kNeon,
+  kWasmSimd128,
+};
+
+// Best level supported by the build and the running CPU (queried once, then cached).
+[[nodiscard]] SimdLevel detect_simd_level();
+
+// Level the dispatched kernels currently use. Defaults to detect_simd_level().
+[[nodiscard]] SimdLevel active_simd_level();
+
+// Force a level (e.g. kScalar for parity tests). Levels the CPU cannot run are clamped to the detected one.
+void set_simd_level(SimdLevel level);
+
+[[nodiscard]] bool simd_level_supported(SimdLevel level);
+[[nodiscard]] const char* simd_level_name(SimdLevel level);
+
+}  // namespace ndvis::detail
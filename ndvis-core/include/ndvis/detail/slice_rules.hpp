@@ -0,0 +1,50 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace ndvis::detail {
+
+// Distances closer to the hyperplane than this count as on it.
+constexpr float kSliceEpsilon = 1e-5f;
+
+inline int classify_distance(float distance) {
+  if (std::abs(distance) < kSliceEpsilon) {
+    return 0;  // On hyperplane
+  }
+  return distance > 0.0f ? 1 : -1;  // Front (positive side) / back (negative side)
+}
+
+// Edge intersects hyperplane if endpoints are on opposite sides
+// (or exactly one is on the hyperplane)
+inline bool edge_crosses(int class0, int class1) {
+  return class0 * class1 < 0 || (class0 == 0 && class1 != 0) || (class0 != 0 && class1 == 0);
+}
+
+inline bool edge_crosses_distances(float d0, float d1) {
+  return edge_crosses(classify_distance(d0), classify_distance(d1));
+}
+
+// Margin to widen a [min, max] dot-product range by before testing offsets against it. fl(dot - b) carries
+// a relative error only, so twice the on-plane epsilon (or a few ulps of the bound, whichever is larger)
+// keeps every offset the exact rules accept; candidates are then re-tested with them.
+inline float crossing_slack(float bound) {
+  const float absolute_slack = 2.0f * kSliceEpsilon;
+  const float relative_slack = std::abs(bound) * 0x1.0p-22f;
+  return absolute_slack > relative_slack ? absolute_slack : relative_slack;
+}
+
+// Interpolation parameter t along v0 -> v1 such that dot(normal, v0 + t * (v1 - v0)) = offset
+inline float crossing_parameter(float d0, float d1) {
+  float t = 0.0f;
+  if (std::abs(d0 - d1) > kSliceEpsilon) {
+    t = d0 / (d0 - d1);
+  } else if (std::abs(d0) < kSliceEpsilon) {
+    t = 0.0f;
+  } else {
+    t = 1.0f;
+  }
+  return std::max(0.0f, std::min(1.0f, t));
+}
+
+}  // namespace ndvis::detail
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+
+namespace ndvis::detail {
+
+struct SubspaceParams {
+  // Iterations before giving up (the caller then falls back to full Jacobi).
+  std::size_t max_iterations{200};
+  // Stop once every requested Ritz pair has ||A x - theta x|| <= tolerance * theta_max.
+  double tolerance{1.0e-8};
+  // Extra block columns beyond the requested count; convergence goes as (lambda_{k+guard+1} / lambda_k)^iter.
+  std::size_t guard_vectors{5};
+};
+
+struct SubspaceReport {
+  std::size_t iterations{0};
+  double max_residual{0.0};
+  bool converged{false};
+};
+
+// Leading `count` eigenpairs of a symmetric positive semi-definite matrix (e.g. a covariance) by block
+// subspace iteration with Rayleigh-Ritz: O(order^2 * block) per iteration instead of full Jacobi sweeps.
+// out_eigenvalues: count values, descending. out_eigenvectors: order x count, row-major, one eigenvector
+// per column (the same layout as jacobi_symmetric restricted to its first `count` columns).
+// Returns false without touching the outputs when it did not converge within params.max_iterations.
+bool subspace_iteration(const double* matrix, std::size_t order, std::size_t count, const SubspaceParams& params,
+                        double* out_eigenvalues, double* out_eigenvectors, SubspaceReport* report = nullptr);
+
+}  // namespace ndvis::detail
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace ndvis::detail {
+
+using ChunkFunction = void (*)(void* context, std::size_t chunk, std::size_t begin, std::size_t end);
+
+// Number of chunks [0, item_count) is split into: at most thread_count(), and no chunk smaller than
+// min_chunk items. Returns 1 when the work should run inline on the calling thread.
+[[nodiscard]] std::size_t parallel_chunk_count(std::size_t item_count, std::size_t min_chunk);
+
+// Bounds of chunk `chunk` out of `chunk_count`; chunks are contiguous and ordered, so per-chunk results
+// concatenated by chunk index are deterministic regardless of scheduling.
+[[nodiscard]] inline std::size_t chunk_begin(std::size_t item_count, std::size_t chunk_count, std::size_t chunk) {
+  return item_count * chunk / chunk_count;
+}
+
+// Runs fn(context, chunk, begin, end) for every chunk on the worker pool and the calling thread, then waits.
+void run_chunks(std::size_t item_count, std::size_t chunk_count, ChunkFunction fn, void* context);
+
+template <typename Fn>
+void parallel_for_chunks(std::size_t item_count, std::size_t chunk_count, Fn&& fn) {
+  if (item_count == 0) {
+    return;
+  }
+  if (chunk_count <= 1) {
+    fn(std::size_t{0}, std::size_t{0}, item_count);
+    return;
+  }
+  using Callable = std::remove_reference_t<Fn>;
+  run_chunks(
+      item_count,
+      chunk_count,
+      [](void* context, std::size_t chunk, std::size_t begin, std::size_t end) {
+        (*static_cast<Callable*>(context))(chunk, begin, end);
+      },
+      const_cast<void*>(static_cast<const void*>(&fn)));
+}
+
+// Convenience form for kernels whose chunks write disjoint outputs: fn(begin, end).
+template <typename Fn>
+void parallel_for(std::size_t item_count, std::size_t min_chunk, Fn&& fn) {
+  parallel_for_chunks(item_count, parallel_chunk_count(item_count, min_chunk),
+                      [&fn](std::size_t, std::size_t begin, std::size_t end) { fn(begin, end); });
+}
+
+}  // namespace ndvis::detail
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+
+#include "ndvis/rotations.hpp"
+
+namespace ndvis {
+
+// Decides when a rotation matrix needs reorthonormalize, without paying the O(n^3) of
+// compute_orthogonality_drift every frame. Each Givens step adds its expected rounding (in
+// quadrature); once that crosses `threshold`, a window of column pairs is measured (O(n) per pair,
+// the window rotates across calls), and QR runs only if the measured estimate also crosses it.
+// Plain data so the C API can share the layout (NdvisDriftScheduler).
+struct DriftScheduler {
+  float threshold{1e-4f};         // Frobenius ||R^T R - I|| that triggers re-orthonormalization
+  std::size_t sample_pairs{0};    // column pairs measured per check (0 = 2 * order)
+  float rounding_bound{0.0f};     // expected drift accumulated since the last check or QR
+  float last_estimate{0.0f};      // most recent sampled estimate
+  std::size_t sample_cursor{0};   // next column pair of the rotating window
+  std::size_t steps{0};           // recorded rotation batches
+  std::size_t checks{0};          // sampled estimates taken
+  std::size_t reorthonormalizations{0};
+};
+
+// Estimate ||R^T R - I||_F from `pair_count` column pairs (i <= j, upper triangle in row order,
+// wrapping) starting at `first_pair`. Covering all n(n+1)/2 pairs gives the exact drift.
+[[nodiscard]] float estimate_orthogonality_drift(const float* matrix, std::size_t order, std::size_t first_pair,
+                                                 std::size_t pair_count);
+
+// Account for `plane_count` Givens planes applied to an order x order matrix.
+void drift_scheduler_record(DriftScheduler& scheduler, std::size_t order, std::size_t plane_count);
+
+// Check and, if needed, reorthonormalize. Returns true when QR ran.
+bool drift_scheduler_maintain(DriftScheduler& scheduler, float* matrix, std::size_t order);
+
+// apply_rotations + drift_scheduler_record + drift_scheduler_maintain. Returns true when QR ran.
+bool apply_rotations_scheduled(DriftScheduler& scheduler, float* matrix, std::size_t order,
+                               const RotationPlane* planes, std::size_t plane_count);
+
+}  // namespace ndvis
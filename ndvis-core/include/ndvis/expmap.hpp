@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+
+#include "ndvis/rotations.hpp"
+
+namespace ndvis {
+
+enum class ExpMapMethod {
+  kCayley = 0,  // (I - A/2)^-1 (I + A/2): one solve, exactly orthogonal, second-order accurate
+  kPade,        // [6/6] Pade with scaling and squaring: matches exp(A) to double rounding
+};
+
+// Skew-symmetric generator from per-plane angular velocities (theta = radians per unit time).
+// Entry (i, j) gets +theta and (j, i) gets -theta, so exp(generator * t) for a single plane equals
+// apply_givens with angle theta * t. out_generator: order * order, row-major.
+void build_rotation_generator(const RotationPlane* velocities, std::size_t velocity_count, std::size_t order,
+                              float* out_generator);
+
+// R <- R * exp(generator * dt) with every animated plane folded into one matrix multiply.
+// The exponential and the product are accumulated in double. Returns false (matrix untouched) on bad
+// inputs or a singular denominator.
+bool apply_angular_velocity(float* matrix, std::size_t order, const float* generator, float dt,
+                            ExpMapMethod method);
+
+// Doubles of workspace the allocation-free apply_angular_velocity needs for `method`.
+[[nodiscard]] std::size_t angular_velocity_workspace_size(std::size_t order, ExpMapMethod method);
+
+// As above inside caller workspace, so a per-frame step does not allocate. Also returns false when the
+// workspace is shorter than angular_velocity_workspace_size(order, method).
+bool apply_angular_velocity(float* matrix, std::size_t order, const float* generator, float dt,
+                            ExpMapMethod method, double* workspace, std::size_t workspace_length);
+
+}  // namespace ndvis
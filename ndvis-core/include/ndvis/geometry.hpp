@@ -12,16 +12,72 @@ struct PolytopeBuffers {
   IndexBufferView edges{};  // Pairs of vertex indices (u,v)
 };
 
+// 2-faces as lists of edge indices (CSR): face f owns edges[offsets[f] .. offsets[f + 1]), listed in order
+// around the polygon. The generators below write hypercube faces as squares (4 edges per face) and
+// simplex and orthoplex faces as triangles (3 edges per face).
+struct FaceBuffers {
+  std::size_t face_count{0};
+  IndexBufferView offsets{};  // face_count + 1
+  IndexBufferView edges{};
+};
+
+struct ConstFaceView {
+  ConstIndexBufferView offsets{};
+  ConstIndexBufferView edges{};
+};
+
+// Hypercube described by its dimension alone. Vertex coordinates and edges are decoded from index bits
+// in the order generate_hypercube writes them, so kernels can walk 20+-dimensional cubes without
+// materializing dimension * 2^n floats and n * 2^(n-1) edge pairs.
+struct ImplicitHypercube {
+  int dimension{0};
+};
+
+// Coordinate of hypercube vertex `vertex` on `axis`: +1 when that bit is set, -1 otherwise.
+[[nodiscard]] inline float hypercube_vertex_coordinate(std::size_t vertex, std::size_t axis) {
+  return ((vertex >> axis) & 1U) ? 1.0f : -1.0f;
+}
+
+// Endpoints of hypercube edge `edge`: edges are axis-major, and within axis a the rank r selects the
+// r-th vertex with bit a clear (r with a zero bit inserted at position a) and its neighbor across a.
+inline void hypercube_edge_vertices(int dimension, std::size_t edge, std::size_t* out_v0, std::size_t* out_v1) {
+  const std::size_t half = static_cast<std::size_t>(1) << (dimension - 1);
+  const std::size_t axis = edge / half;
+  const std::size_t rank = edge % half;
+  const std::size_t low_mask = (static_cast<std::size_t>(1) << axis) - 1;
+  const std::size_t v0 = ((rank & ~low_mask) << 1) | (rank & low_mask);
+  *out_v0 = v0;
+  *out_v1 = v0 | (static_cast<std::size_t>(1) << axis);
+}
+
+// Index of the hypercube edge leaving `vertex` along `axis` (bit `axis` of `vertex` clear); the inverse of
+// hypercube_edge_vertices.
+[[nodiscard]] inline std::size_t hypercube_edge_index(int dimension, std::size_t vertex, std::size_t axis) {
+  const std::size_t half = static_cast<std::size_t>(1) << (dimension - 1);
+  const std::size_t low_mask = (static_cast<std::size_t>(1) << axis) - 1;
+  const std::size_t rank = ((vertex >> (axis + 1)) << axis) | (vertex & low_mask);
+  return axis * half + rank;
+}
+
 [[nodiscard]] std::size_t hypercube_vertex_count(int dimension);
 [[nodiscard]] std::size_t hypercube_edge_count(int dimension);
 PolytopeBuffers generate_hypercube(int dimension, BufferView vertices, IndexBufferView edges);
+[[nodiscard]] std::size_t hypercube_face_count(int dimension);
+// offsets: face_count + 1 entries, edges: 4 * face_count. Edge indices refer to generate_hypercube output.
+FaceBuffers generate_hypercube_faces(int dimension, IndexBufferView offsets, IndexBufferView edges);
 
 [[nodiscard]] std::size_t simplex_vertex_count(int dimension);
 [[nodiscard]] std::size_t simplex_edge_count(int dimension);
 PolytopeBuffers generate_simplex(int dimension, BufferView vertices, IndexBufferView edges);
+[[nodiscard]] std::size_t simplex_face_count(int dimension);
+// offsets: face_count + 1 entries, edges: 3 * face_count.
+FaceBuffers generate_simplex_faces(int dimension, IndexBufferView offsets, IndexBufferView edges);
 
 [[nodiscard]] std::size_t orthoplex_vertex_count(int dimension);
 [[nodiscard]] std::size_t orthoplex_edge_count(int dimension);
 PolytopeBuffers generate_orthoplex(int dimension, BufferView vertices, IndexBufferView edges);
+[[nodiscard]] std::size_t orthoplex_face_count(int dimension);
+// offsets: face_count + 1 entries, edges: 3 * face_count (4 for the single square face at dimension 2).
+FaceBuffers generate_orthoplex_faces(int dimension, IndexBufferView offsets, IndexBufferView edges);
 
 }  // namespace ndvis
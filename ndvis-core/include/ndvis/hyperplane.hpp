@@ -2,6 +2,7 @@
 
 #include <cstddef>
 
+#include "ndvis/geometry.hpp"
 #include "ndvis/types.hpp"
 
 namespace ndvis {
@@ -39,6 +40,84 @@ SliceResult slice_polytope(
     IndexBufferView out_edge_indices
 );
 
+// Signed distance normal . v - offset of every vertex, written to out_distances[0, vertex_count). Runs the
+// widest SIMD kernel the CPU supports over the SoA columns; every level returns the same bits. The buffer
+// can be kept across frames and handed to classify_distances and slice_polytope_with_distances.
+void compute_signed_distances(
+    ConstBufferView vertices,
+    std::size_t vertex_count,
+    std::size_t dimension,
+    const Hyperplane& hyperplane,
+    float* out_distances
+);
+
+// -1 / 0 / +1 per distance, with the same on-plane tolerance as classify_vertices.
+void classify_distances(const float* distances, std::size_t count, int* out_classifications);
+
+// slice_polytope from precomputed compute_signed_distances output (vertex_count floats); no vertex is
+// re-evaluated and nothing is allocated.
+SliceResult slice_polytope_with_distances(
+    ConstBufferView vertices,
+    std::size_t vertex_count,
+    std::size_t dimension,
+    ConstIndexBufferView edges,
+    const float* distances,
+    BufferView out_points,
+    IndexBufferView out_edge_indices
+);
+
+// Floats of workspace slice_polytope needs (one signed distance per vertex).
+[[nodiscard]] std::size_t slice_workspace_size(std::size_t vertex_count);
+
+// As above without heap allocation: a count pass and a fill pass over the edges write straight into
+// out_points. Returns an empty result on invalid inputs or a workspace shorter than
+// slice_workspace_size(vertex_count).
+SliceResult slice_polytope(
+    ConstBufferView vertices,
+    std::size_t vertex_count,
+    std::size_t dimension,
+    ConstIndexBufferView edges,
+    const Hyperplane& hyperplane,
+    BufferView out_points,
+    IndexBufferView out_edge_indices,
+    float* workspace,
+    std::size_t workspace_length
+);
+
+// Slices one polytope at offset_count parallel offsets of the same normal (sweeps, slab stacks). Vertex
+// dot products are computed once; each edge then jumps (binary search over the sorted offsets) to the
+// offsets its endpoints span, so a pass over the edges serves every slice. Slice k, in the order given,
+// holds out_slice_starts[k + 1] - out_slice_starts[k] hits: edge indices at out_edge_indices[start_k...]
+// and an SoA block at out_points[dimension * start_k] with that count as its stride. Each slice equals
+// slice_polytope at its offset. When the buffers run out, later hits (and slices) are dropped.
+// out_slice_starts: offset_count + 1 entries. Returns the total hit count; 0 on invalid input or a
+// non-finite offset.
+std::size_t slice_polytope_batch(
+    ConstBufferView vertices,
+    std::size_t vertex_count,
+    std::size_t dimension,
+    ConstIndexBufferView edges,
+    const float* normal,
+    const float* offsets,
+    std::size_t offset_count,
+    BufferView out_points,
+    IndexBufferView out_edge_indices,
+    std::size_t* out_slice_starts
+);
+
+// Slice an implicit hypercube without vertex or edge buffers. Matches slice_polytope on generate_hypercube
+// output up to distance rounding: vertex distances are summed in double from small per-bit-group lookup
+// tables rather than by compute_signed_distances, so a vertex within rounding of the on-plane tolerance
+// can classify differently and points agree to float rounding, not bitwise. Edges are streamed in index
+// order, so hits keep slice_polytope's edge indices and ordering.
+// Edge indices are index_type, so dimensions whose edge count exceeds its range (n > 27) return empty.
+SliceResult slice_hypercube(
+    const ImplicitHypercube& cube,
+    const Hyperplane& hyperplane,
+    BufferView out_points,
+    IndexBufferView out_edge_indices
+);
+
 // Compute signed distance from a point to a hyperplane
 // point: n-dimensional point
 // hyperplane: hyperplane definition
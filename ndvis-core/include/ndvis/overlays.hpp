@@ -2,6 +2,7 @@
 
 #include <cstddef>
 
+#include "ndvis/geometry.hpp"
 #include "ndvis/types.hpp"
 
 namespace ndvis {
@@ -14,6 +15,8 @@ struct GeometryInputs {
   std::size_t edge_count;
   const float* rotation_matrix;  // dimension * dimension, row-major
   const float* basis3;           // 3 * dimension, column-major
+  // When dimension > 0, vertices/edges (and their counts) are ignored and decoded from index bits.
+  ImplicitHypercube implicit_hypercube{};
 };
 
 struct HyperplaneInputs {
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+
+namespace ndvis {
+
+// Number of threads ndvis-core kernels may use, including the calling thread.
+// 0 restores the default (hardware concurrency); 1 runs every kernel inline. Larger requests are clamped
+// to 4x hardware concurrency (at most 256).
+void set_thread_count(std::size_t count);
+[[nodiscard]] std::size_t thread_count();
+
+}  // namespace ndvis
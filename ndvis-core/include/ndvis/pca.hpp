@@ -2,9 +2,61 @@
 
 #include <cstddef>
 
+#include "ndvis/detail/eigen.hpp"
+#include "ndvis/detail/jacobi.hpp"
+#include "ndvis/types.hpp"
+
 namespace ndvis {
 
 void compute_pca_basis(const float* vertices, std::size_t vertex_count, std::size_t dimension, float* out_basis);
 void compute_pca_basis_with_values(const float* vertices, std::size_t vertex_count, std::size_t dimension, float* out_basis, float* out_eigenvalues);
 
+using JacobiReport = detail::JacobiReport;
+using EigenParams = detail::EigenParams;
+using EigenSolver = detail::EigenSolver;
+
+// As above, and reports the eigensolver's sweeps (QL iterations for the tridiagonal solver), remaining
+// off-diagonal norm and max eigen-residual (covariance units). out_eigenvalues and out_report may be null.
+void compute_pca_basis_with_values(const float* vertices, std::size_t vertex_count, std::size_t dimension,
+                                   float* out_basis, float* out_eigenvalues, JacobiReport* out_report);
+
+// As above with an explicit eigensolver choice (Jacobi, Householder + QL, or by dimension).
+void compute_pca_basis_with_values(const float* vertices, std::size_t vertex_count, std::size_t dimension,
+                                   float* out_basis, float* out_eigenvalues, const EigenParams& params,
+                                   JacobiReport* out_report);
+
+// Doubles of workspace compute_pca_basis_with_workspace needs (independent of vertex_count).
+[[nodiscard]] std::size_t pca_workspace_size(std::size_t dimension);
+
+// compute_pca_basis_with_values without heap allocation: mean, covariance, eigenpairs and covariance
+// scratch all live in `workspace`. Returns false on invalid inputs or a short workspace.
+bool compute_pca_basis_with_workspace(const float* vertices, std::size_t vertex_count, std::size_t dimension,
+                                      float* out_basis, float* out_eigenvalues, double* workspace,
+                                      std::size_t workspace_length);
+
+// Leading `count` principal components only. For large dimensions (n >= 512, count <= n / 2) this runs
+// block subspace iteration, O(n^2 * count) per iteration, instead of diagonalizing the full covariance;
+// compute_pca_basis takes the same route. out_components: count * dimension floats, one component per
+// row (the out_basis layout). out_eigenvalues: count floats, descending, may be null.
+void compute_pca_components(const float* vertices, std::size_t vertex_count, std::size_t dimension,
+                            std::size_t count, float* out_components, float* out_eigenvalues);
+
+// Per-cluster PCA outputs, indexed by label. Any pointer except `bases` may be null.
+struct ClusterPcaOutputs {
+  float* bases{nullptr};        // label_count * 3 * dimension; each label in the compute_pca_basis layout
+  float* means{nullptr};        // label_count * dimension
+  float* covariances{nullptr};  // label_count * dimension * dimension (normalized by count - 1)
+  float* eigenvalues{nullptr};  // label_count * dimension, descending
+  std::size_t* counts{nullptr};  // label_count
+};
+
+// PCA of every labeled subset in one pass over the vertices: labels[v] in [0, label_count) selects the
+// cluster of vertex v (other values are skipped). Moments are accumulated per label on fixed vertex
+// partials and merged in order, so results do not depend on the thread count; the small eigenproblems
+// are then solved with Jacobi in parallel. Empty labels get the identity basis and zeros.
+// Scratch: label_count * (1 + 2n + n(n+1)/2) doubles per partial. Up to 8 partials are used while they fit
+// in 16 MiB together, and never fewer than one, so e.g. 10k labels at n = 32 still take 47 MB.
+bool compute_cluster_pca(const float* vertices, std::size_t vertex_count, std::size_t dimension,
+                         const index_type* labels, std::size_t label_count, const ClusterPcaOutputs& outputs);
+
 }  // namespace ndvis
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ndvis/streaming_pca.hpp"
+
+namespace ndvis {
+
+struct ProgressivePcaParams {
+  // Points drawn (uniformly, without replacement) for the first solve; the whole set when it is smaller.
+  std::size_t sample_size{8192};
+  std::uint64_t seed{0x9e3779b97f4a7c15ULL};
+};
+
+// How far the sample basis can be from the full-data one. perturbation estimates ||C_sample - C||_F
+// from the sample's fourth moments (with the finite-population correction); by Davis-Kahan the sine of
+// the largest principal angle is at most perturbation / gap. When the sample covers every vertex (exact),
+// perturbation and both error bounds are zero; the gaps still describe the spectrum and stay non-zero.
+struct PcaConfidence {
+  std::size_t sample_count{0};
+  std::size_t vertex_count{0};
+  // lambda_3 - lambda_4 of the sample covariance (separation of the x/y/z subspace from the rest).
+  double eigengap{0.0};
+  // Smallest of lambda_1 - lambda_2, lambda_2 - lambda_3, lambda_3 - lambda_4 (separation of each axis).
+  double min_gap{0.0};
+  double perturbation{0.0};
+  // Davis-Kahan sin(theta) for the spanned subspace and for the individual axes, clamped to [0, 1].
+  double subspace_error{0.0};
+  double component_error{0.0};
+  bool exact{false};
+};
+
+// PCA for point sets too large to cover every frame. begin() solves on a reservoir sample, so an
+// approximate basis and its confidence are available at once; refine_step() then accumulates the exact
+// covariance over a bounded number of vertices per call (merged like StreamingPca batches), so the full
+// pass can be spread across frames. Neither call blocks for longer than its own slice of work.
+//
+// The vertex array passed to begin() must stay alive and unchanged until refined() or the next begin().
+class ProgressivePca {
+ public:
+  explicit ProgressivePca(std::size_t dimension, const ProgressivePcaParams& params = {});
+
+  std::size_t dimension() const { return dimension_; }
+
+  // Samples and solves. vertices: SoA, axis-major with stride vertex_count. When the sample covers every
+  // vertex the result is already exact and refined() is true.
+  void begin(const float* vertices, std::size_t vertex_count);
+
+  // Accumulates up to max_vertices more vertices of the exact pass and solves once the pass completes.
+  // Returns refined().
+  bool refine_step(std::size_t max_vertices);
+  bool refined() const { return refined_; }
+  // Fraction of the vertices the exact pass has covered, in [0, 1].
+  double progress() const;
+
+  // Sample result (compute_pca_basis_with_values layout; out_eigenvalues and out_confidence may be null).
+  void approximate_basis(float* out_basis, float* out_eigenvalues, PcaConfidence* out_confidence) const;
+  // Exact result; returns false and leaves the outputs untouched until refined().
+  bool refined_basis(float* out_basis, float* out_eigenvalues) const;
+
+ private:
+  void sample_indices(std::size_t vertex_count);
+
+  std::size_t dimension_;
+  ProgressivePcaParams params_;
+  const float* vertices_{nullptr};
+  std::size_t vertex_count_{0};
+  std::size_t refined_count_{0};
+  bool refined_{false};
+
+  std::vector<std::size_t> indices_;
+  std::vector<float> sample_;  // SoA, stride indices_.size()
+  std::vector<double> mean_;
+  std::vector<double> covariance_;
+  std::vector<double> eigenvectors_;
+  std::vector<double> eigenvalues_;
+  std::vector<double> covariance_scratch_;
+
+  std::vector<float> approximate_basis_;
+  std::vector<float> approximate_eigenvalues_;
+  PcaConfidence confidence_;
+
+  StreamingPca exact_;
+  std::vector<float> refined_basis_;
+  std::vector<float> refined_eigenvalues_;
+};
+
+}  // namespace ndvis
@@ -2,11 +2,60 @@
 
 #include <cstddef>
 
+#include "ndvis/geometry.hpp"
+#include "ndvis/rotations.hpp"
 #include "ndvis/types.hpp"
 
 namespace ndvis {
 
+// Number of rows in a fused projection operator (one per output component x/y/z).
+inline constexpr std::size_t kProjectionRows = 3;
+
 void project_to_3d(ConstBufferView vertices, std::size_t dimension, std::size_t vertex_count, const float* rotation_matrix,
                    std::size_t rotation_stride, ConstBasis3 basis, float* out_positions);
 
+// Fold the rotation into the projection basis: M = basis3^T * R.
+// out_operator: 3 * dimension floats, row-major (row c holds the weights of output component c).
+void build_projection_operator(const float* rotation_matrix, std::size_t rotation_stride, ConstBasis3 basis,
+                               float* out_operator);
+
+// Project SoA vertices with a prebuilt operator: out[v] = M * x_v (3n multiply-adds per vertex).
+void project_with_operator(ConstBufferView vertices, std::size_t dimension, std::size_t vertex_count,
+                           const float* projection_operator, float* out_positions);
+
+// Project a single n-dimensional point with a prebuilt operator.
+void project_point_with_operator(const float* point, std::size_t dimension, const float* projection_operator,
+                                 float* out3);
+
+// Apply Givens planes to a projection operator in place (M' = M * G), mirroring apply_givens on R.
+void apply_givens_to_operator(float* projection_operator, std::size_t dimension, const RotationPlane* planes,
+                              std::size_t plane_count);
+
+// Incremental re-projection after `planes` are applied to R (apply_rotations): rotates the operator and
+// advances previously projected positions by the change in the touched operator columns only,
+// O(V * k) for k distinct plane axes instead of O(V * n). Float error accumulates across calls, so
+// re-project from scratch after reorthonormalize or every few hundred frames.
+// projection_operator: 3 * dimension (in/out). inout_positions: vertex_count * 3 (in/out).
+void update_projection_incremental(ConstBufferView vertices, std::size_t dimension, std::size_t vertex_count,
+                                   float* projection_operator, const RotationPlane* planes, std::size_t plane_count,
+                                   float* inout_positions);
+
+// Structure-aware projection for polytopes from geometry.hpp. These never read the vertex buffer: they
+// rebuild the positions from the operator columns, in the same vertex order as the generators.
+// out_positions: vertex_count * 3 floats (see hypercube_vertex_count etc.).
+
+// Hypercube vertex v is sum_a (bit a of v ? +1 : -1) * M[:,a]. Splitting v into low/high bit groups
+// gives out[v] = low_table[lo] + high_sum[hi]: three adds per vertex, written sequentially.
+void project_hypercube(int dimension, const float* projection_operator, float* out_positions);
+
+inline void project_hypercube(const ImplicitHypercube& cube, const float* projection_operator, float* out_positions) {
+  project_hypercube(cube.dimension, projection_operator, out_positions);
+}
+
+// Simplex vertices project to the origin followed by the operator columns.
+void project_simplex(int dimension, const float* projection_operator, float* out_positions);
+
+// Orthoplex vertices project to +/- each operator column.
+void project_orthoplex(int dimension, const float* projection_operator, float* out_positions);
+
 }  // namespace ndvis
@@ -6,4 +6,22 @@ namespace ndvis {
 
 void reorthonormalize(float* matrix, std::size_t order);
 
+enum class OrthonormalizeMethod {
+  kModifiedGramSchmidt = 0,  // float, in place; same as reorthonormalize(matrix, order)
+  kHouseholder,              // unblocked Householder QR in double; Q with a positive R diagonal
+  kNewtonSchulz,             // polar factor via X <- X (3I - X^T X) / 2 in double; nearest orthogonal matrix
+};
+
+// Doubles of workspace reorthonormalize needs for `method` (0 for modified Gram-Schmidt).
+[[nodiscard]] std::size_t reorthonormalize_workspace_size(std::size_t order, OrthonormalizeMethod method);
+
+// Re-orthonormalize using caller-provided workspace; no method allocates (modified Gram-Schmidt needs no
+// workspace at all). Newton-Schulz falls back to Householder when the input is too far from orthogonal to
+// converge (its workspace covers both).
+// Returns false when inputs are invalid or the workspace is too small.
+// Unblocked reflectors are used on purpose: at n <= 64 the whole matrix sits in L1/L2 and a
+// blocked WY update would only add bookkeeping.
+bool reorthonormalize(float* matrix, std::size_t order, OrthonormalizeMethod method, double* workspace,
+                      std::size_t workspace_length);
+
 }  // namespace ndvis
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+
+#include "ndvis/rotations.hpp"
+
+namespace ndvis {
+
+// Unit quaternion w + x i + y j + z k; axis 0..3 of R^4 maps to (1, i, j, k).
+struct Quaternion {
+  float w{1.0f};
+  float x{0.0f};
+  float y{0.0f};
+  float z{0.0f};
+};
+
+// 4D rotation as a left/right isoclinic pair: R v = left * v * right. Composition costs two
+// quaternion products and a renormalization, and the matrix is orthogonal by construction, so the
+// n = 4 path needs neither the n x n Givens loop nor reorthonormalize.
+// Layout is shared with NdvisRotation4 (8 floats).
+struct Rotation4 {
+  Quaternion left{};
+  Quaternion right{};
+};
+
+// Same effect as apply_givens on the 4x4 matrix of `rotation` (R <- R * G).
+void apply_givens4(Rotation4& rotation, RotationPlane plane);
+
+void apply_rotations4(Rotation4& rotation, const RotationPlane* planes, std::size_t plane_count);
+
+// Rebuild the row-major 4x4 matrix (16 floats), e.g. for build_projection_operator.
+void rotation4_to_matrix(const Rotation4& rotation, float* out_matrix);
+
+}  // namespace ndvis
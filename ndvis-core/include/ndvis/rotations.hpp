@@ -13,7 +13,26 @@ struct RotationPlane {
 // Apply a single Givens rotation to a rotation matrix (in-place)
 void apply_givens(float* matrix, std::size_t order, RotationPlane plane);
 
-// Apply a batch of rotation planes sequentially (in-place)
+// Givens plane with its cosine/sine precomputed.
+struct GivensRotation {
+  unsigned int i{0};
+  unsigned int j{0};
+  float c{1.0f};
+  float s{0.0f};
+};
+
+// Precompute (c, s) for each plane, dropping planes outside `order` like apply_givens does.
+// out_rotations must hold plane_count entries; returns how many were written.
+std::size_t prepare_givens(const RotationPlane* planes, std::size_t plane_count, std::size_t order,
+                           GivensRotation* out_rotations);
+
+// Apply a prepared plane sequence in one sweep over the matrix: each row (or block of rows, transposed
+// so the same column of neighbouring rows sits in one vector) goes through every plane while it is
+// hot. Per-element arithmetic matches calling apply_givens plane by plane.
+void apply_givens_batch(float* matrix, std::size_t order, const GivensRotation* rotations,
+                        std::size_t rotation_count);
+
+// Apply a batch of rotation planes sequentially (in-place); fused through apply_givens_batch
 void apply_rotations(float* matrix, std::size_t order, const RotationPlane* planes, std::size_t plane_count);
 
 // Apply rotation planes incrementally to an existing rotation matrix
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+
+#include "ndvis/geometry.hpp"
+#include "ndvis/hyperplane.hpp"
+#include "ndvis/types.hpp"
+
+namespace ndvis {
+
+struct SectionResult {
+  std::size_t vertex_count{0};  // distinct section vertices
+  std::size_t edge_count{0};    // section edges
+  BufferView points{};          // SoA: dimension * vertex_count
+  IndexBufferView edges{};      // pairs of section vertex indices, 2 * edge_count
+  // Set when out_points or out_edges was too small; the dropped vertices' edges are dropped too.
+  bool truncated{false};
+};
+
+// Cross-section of a convex polytope as a connected (n-1)-polytope wireframe rather than a point cloud.
+// Crossing edges are found with the slice_polytope rules. An edge whose endpoint lies on the hyperplane
+// yields that vertex itself, shared by every edge through it, so each section vertex appears once.
+// Vertices are numbered in order of the first edge that reaches them. Two section vertices are joined
+// when they are the only ones on a common 2-face. A face lying in the hyperplane adds nothing itself;
+// its boundary comes from its neighbours. Edges are sorted and unique.
+// faces: 2-faces as edge lists (e.g. generate_hypercube_faces), with face_count + 1 offsets starting at 0.
+// out_edges and out_vertex_edges are optional; the latter receives a source polytope edge per section vertex.
+// Returns an empty result on invalid inputs.
+SectionResult slice_section(
+    ConstBufferView vertices,
+    std::size_t vertex_count,
+    std::size_t dimension,
+    ConstIndexBufferView edges,
+    ConstFaceView faces,
+    const Hyperplane& hyperplane,
+    BufferView out_points,
+    IndexBufferView out_edges,
+    IndexBufferView out_vertex_edges
+);
+
+}  // namespace ndvis
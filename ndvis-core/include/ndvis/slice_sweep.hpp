@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ndvis/hyperplane.hpp"
+#include "ndvis/types.hpp"
+
+namespace ndvis {
+
+// Offset sweeps with a fixed normal. build() evaluates normal . v once per vertex and files every edge's
+// [min, max] dot product in a centered interval tree, so slice(b) visits one root-to-leaf path plus the
+// edges it reports: O(log E + K) instead of a pass over every edge. The result (points, edge indices and
+// their order) is the same as slice_polytope with Hyperplane{normal, dimension, b}.
+//
+// The vertex and edge arrays passed to build() must stay alive and unchanged until the next build().
+class SliceSweepIndex {
+ public:
+  // Returns false (and leaves the index empty) on invalid inputs, an out-of-range edge vertex or a
+  // non-finite dot product.
+  bool build(ConstBufferView vertices, std::size_t vertex_count, std::size_t dimension, ConstIndexBufferView edges,
+             const float* normal);
+
+  bool built() const { return dimension_ != 0; }
+  std::size_t dimension() const { return dimension_; }
+  std::size_t vertex_count() const { return vertex_count_; }
+  std::size_t edge_count() const { return edge_count_; }
+
+  // Slices at offset b. Capacity rules match slice_polytope: hits beyond out_points (or out_edge_indices,
+  // when given) are dropped from the end. Reuses internal scratch, so repeated calls do not allocate once
+  // the largest hit count has been seen.
+  SliceResult slice(float offset, BufferView out_points, IndexBufferView out_edge_indices);
+
+ private:
+  struct Node {
+    float center;
+    std::uint32_t begin;  // range in by_lo_ / by_hi_ of the intervals containing center
+    std::uint32_t end;
+    std::int32_t left;
+    std::int32_t right;
+  };
+  struct Bound {
+    float key;
+    index_type edge;
+  };
+
+  std::int32_t build_node(index_type* first, index_type* last);
+  void collect_crossings(float offset);
+
+  const float* vertices_{nullptr};
+  const index_type* edges_{nullptr};
+  std::size_t vertex_count_{0};
+  std::size_t dimension_{0};
+  std::size_t edge_count_{0};
+
+  std::vector<float> dots_;   // normal . v per vertex
+  std::vector<float> lower_;  // per edge: min dot minus the query slack
+  std::vector<float> upper_;  // per edge: max dot plus the query slack
+  std::vector<Node> nodes_;
+  std::vector<Bound> by_lo_;  // per node, ascending lower bound
+  std::vector<Bound> by_hi_;  // per node, descending upper bound
+  std::vector<index_type> hits_;
+};
+
+}  // namespace ndvis
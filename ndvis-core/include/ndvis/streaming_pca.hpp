@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "ndvis/pca.hpp"
+
+namespace ndvis {
+
+// PCA over a point set that changes by whole batches. Mean and scatter (sum of centered outer products)
+// are merged per batch with the Chan/Welford pairwise update, so a batch costs O(batch * n^2) instead
+// of a pass over every point kept so far. Each solve rotates the covariance into the previous
+// eigenvectors first, where it is already nearly diagonal, so Jacobi finishes in two or three sweeps.
+//
+// Removing batches subtracts their contribution exactly in real arithmetic; in double the error grows
+// with the ratio of removed to remaining points, so rebuild with reset() + add_batch after removing
+// most of the data.
+class StreamingPca {
+ public:
+  explicit StreamingPca(std::size_t dimension);
+
+  std::size_t dimension() const { return dimension_; }
+  std::size_t count() const { return count_; }
+  const double* mean() const { return mean_.data(); }
+
+  void reset();
+
+  // vertices: SoA batch, axis-major with stride vertex_count (the layout compute_pca_basis takes).
+  void add_batch(const float* vertices, std::size_t vertex_count);
+  // Batch whose axis columns are `stride` floats apart, e.g. a vertex range of a larger SoA array.
+  void add_batch(const float* vertices, std::size_t vertex_count, std::size_t stride);
+  // Remove a batch previously added (the same values). Removing everything resets.
+  void remove_batch(const float* vertices, std::size_t vertex_count);
+
+  // Solve for the current covariance (normalized by count - 1) and write the compute_pca_basis_with_values
+  // outputs: out_basis 3 * dimension floats, out_eigenvalues dimension floats (may be null).
+  void compute_basis(float* out_basis, float* out_eigenvalues, JacobiReport* out_report = nullptr);
+
+ private:
+  void merge(const float* vertices, std::size_t vertex_count, std::size_t stride, double sign);
+
+  std::size_t dimension_;
+  std::size_t count_{0};
+  std::vector<double> mean_;
+  std::vector<double> scatter_;       // dimension x dimension
+  std::vector<double> eigenvectors_;  // columns, from the last solve (identity before the first)
+  std::vector<double> eigenvalues_;   // descending, from the last solve
+  std::vector<double> work_;          // covariance in the previous eigenbasis
+  std::vector<double> rotated_;       // C V, then the updated eigenvectors
+  std::vector<double> change_;        // Jacobi eigenvectors of work_
+  std::vector<double> batch_mean_;
+  std::vector<double> batch_covariance_;
+  std::vector<double> covariance_scratch_;
+};
+
+}  // namespace ndvis
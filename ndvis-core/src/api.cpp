@@ -1,17 +1,35 @@
 #include "ndvis/api.h"
 
+#include <vector>
+
+#include "ndvis/drift.hpp"
+#include "ndvis/expmap.hpp"
 #include "ndvis/geometry.hpp"
 #include "ndvis/pca.hpp"
+#include "ndvis/streaming_pca.hpp"
+#include "ndvis/progressive_pca.hpp"
+#include "ndvis/section.hpp"
+#include "ndvis/slice_sweep.hpp"
 #include "ndvis/hyperplane.hpp"
 #include "ndvis/overlays.hpp"
+#include "ndvis/parallel.hpp"
 #include "ndvis/rotations.hpp"
 #include "ndvis/qr.hpp"
+#include "ndvis/rotation4.hpp"
 #include "ndvis/projection.hpp"
 
 using namespace ndvis;
 
 extern "C" {
 
+void ndvis_set_thread_count(size_t count) {
+  set_thread_count(count);
+}
+
+size_t ndvis_get_thread_count(void) {
+  return thread_count();
+}
+
 std::size_t ndvis_hypercube_vertex_count(int dimension) {
   return hypercube_vertex_count(dimension);
 }
@@ -24,6 +42,14 @@ void ndvis_generate_hypercube(int dimension, NdvisBuffer vertices, NdvisIndexBuf
   generate_hypercube(dimension, BufferView{vertices.data, vertices.length}, IndexBufferView{edges.data, edges.length});
 }
 
+size_t ndvis_hypercube_face_count(int dimension) {
+  return hypercube_face_count(dimension);
+}
+
+void ndvis_generate_hypercube_faces(int dimension, NdvisIndexBuffer offsets, NdvisIndexBuffer face_edges) {
+  generate_hypercube_faces(dimension, IndexBufferView{offsets.data, offsets.length}, IndexBufferView{face_edges.data, face_edges.length});
+}
+
 std::size_t ndvis_simplex_vertex_count(int dimension) {
   return simplex_vertex_count(dimension);
 }
@@ -36,6 +62,14 @@ void ndvis_generate_simplex(int dimension, NdvisBuffer vertices, NdvisIndexBuffe
   generate_simplex(dimension, BufferView{vertices.data, vertices.length}, IndexBufferView{edges.data, edges.length});
 }
 
+size_t ndvis_simplex_face_count(int dimension) {
+  return simplex_face_count(dimension);
+}
+
+void ndvis_generate_simplex_faces(int dimension, NdvisIndexBuffer offsets, NdvisIndexBuffer face_edges) {
+  generate_simplex_faces(dimension, IndexBufferView{offsets.data, offsets.length}, IndexBufferView{face_edges.data, face_edges.length});
+}
+
 std::size_t ndvis_orthoplex_vertex_count(int dimension) {
   return orthoplex_vertex_count(dimension);
 }
@@ -49,6 +83,14 @@ void ndvis_generate_orthoplex(int dimension, NdvisBuffer vertices, NdvisIndexBuf
   generate_orthoplex(dimension, BufferView{vertices.data, vertices.length}, IndexBufferView{edges.data, edges.length});
 }
 
+size_t ndvis_orthoplex_face_count(int dimension) {
+  return orthoplex_face_count(dimension);
+}
+
+void ndvis_generate_orthoplex_faces(int dimension, NdvisIndexBuffer offsets, NdvisIndexBuffer face_edges) {
+  generate_orthoplex_faces(dimension, IndexBufferView{offsets.data, offsets.length}, IndexBufferView{face_edges.data, face_edges.length});
+}
+
 void ndvis_project_geometry(
     const float* vertices,
     size_t vertex_count,
@@ -100,6 +142,245 @@ void ndvis_compute_pca_with_values(NdvisBuffer vertices, size_t vertex_count, si
   compute_pca_basis_with_values(vertices.data, vertex_count, dimension, basis.data, eigenvalues.data);
 }
 
+size_t ndvis_pca_workspace_size(size_t dimension) {
+  return pca_workspace_size(dimension);
+}
+
+int ndvis_compute_pca_with_workspace(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisBasis3 basis, NdvisBuffer eigenvalues, double* workspace, size_t workspace_length) {
+  if (vertices.data == nullptr || basis.data == nullptr) {
+    return 1;
+  }
+  const std::size_t required = dimension * vertex_count;
+  if (vertices.length < required || basis.stride < dimension) {
+    return 1;
+  }
+  if (eigenvalues.data != nullptr && eigenvalues.length < dimension) {
+    return 1;
+  }
+  return compute_pca_basis_with_workspace(vertices.data, vertex_count, dimension, basis.data, eigenvalues.data,
+                                          workspace, workspace_length)
+             ? 0
+             : 1;
+}
+
+static void write_jacobi_report(const JacobiReport& jacobi, NdvisJacobiReport* report) {
+  if (report == nullptr) {
+    return;
+  }
+  report->sweeps = jacobi.sweeps;
+  report->rotations = jacobi.rotations;
+  report->off_norm = jacobi.off_norm;
+  report->max_residual = jacobi.max_residual;
+  report->converged = jacobi.converged ? 1 : 0;
+}
+
+void ndvis_compute_pca_with_report(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisBasis3 basis, NdvisBuffer eigenvalues, NdvisJacobiReport* report) {
+  if (vertices.data == nullptr || basis.data == nullptr || eigenvalues.data == nullptr) {
+    return;
+  }
+  const std::size_t required = dimension * vertex_count;
+  if (vertices.length < required || basis.stride < dimension || eigenvalues.length < dimension) {
+    return;
+  }
+  JacobiReport jacobi{};
+  compute_pca_basis_with_values(vertices.data, vertex_count, dimension, basis.data, eigenvalues.data, &jacobi);
+  write_jacobi_report(jacobi, report);
+}
+
+void ndvis_compute_pca_with_solver(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisBasis3 basis, NdvisBuffer eigenvalues, int solver, NdvisJacobiReport* report) {
+  if (vertices.data == nullptr || basis.data == nullptr || eigenvalues.data == nullptr) {
+    return;
+  }
+  const std::size_t required = dimension * vertex_count;
+  if (vertices.length < required || basis.stride < dimension || eigenvalues.length < dimension) {
+    return;
+  }
+  EigenParams params{};
+  switch (solver) {
+    case NDVIS_EIGEN_SOLVER_JACOBI:
+      params.solver = EigenSolver::kJacobi;
+      break;
+    case NDVIS_EIGEN_SOLVER_TRIDIAGONAL_QL:
+      params.solver = EigenSolver::kTridiagonalQl;
+      break;
+    default:
+      params.solver = EigenSolver::kAuto;
+      break;
+  }
+  JacobiReport jacobi{};
+  compute_pca_basis_with_values(vertices.data, vertex_count, dimension, basis.data, eigenvalues.data, params, &jacobi);
+  write_jacobi_report(jacobi, report);
+}
+
+void ndvis_compute_pca_components(NdvisBuffer vertices, size_t vertex_count, size_t dimension, size_t count, NdvisBuffer components, NdvisBuffer eigenvalues) {
+  if (vertices.data == nullptr || components.data == nullptr) {
+    return;
+  }
+  const std::size_t required = dimension * vertex_count;
+  if (vertices.length < required || components.length < count * dimension) {
+    return;
+  }
+  if (eigenvalues.data != nullptr && eigenvalues.length < count) {
+    return;
+  }
+  compute_pca_components(vertices.data, vertex_count, dimension, count, components.data, eigenvalues.data);
+}
+
+int ndvis_compute_cluster_pca(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisIndexBuffer labels, size_t label_count, NdvisClusterPcaOutputs outputs) {
+  if (vertices.data == nullptr || vertices.length < dimension * vertex_count) {
+    return 1;
+  }
+  if (labels.length < vertex_count || outputs.bases.data == nullptr ||
+      outputs.bases.length < label_count * 3 * dimension) {
+    return 1;
+  }
+  const auto too_short = [](const float* data, size_t length, size_t needed) {
+    return data != nullptr && length < needed;
+  };
+  if (too_short(outputs.means.data, outputs.means.length, label_count * dimension) ||
+      too_short(outputs.covariances.data, outputs.covariances.length, label_count * dimension * dimension) ||
+      too_short(outputs.eigenvalues.data, outputs.eigenvalues.length, label_count * dimension) ||
+      (outputs.counts.data != nullptr && outputs.counts.length < label_count)) {
+    return 1;
+  }
+  // Counts are size_t in the C++ API; the C buffer takes index-sized counts.
+  std::vector<std::size_t> counts(outputs.counts.data != nullptr ? label_count : 0);
+  ClusterPcaOutputs cluster{outputs.bases.data, outputs.means.data, outputs.covariances.data,
+                            outputs.eigenvalues.data, counts.empty() ? nullptr : counts.data()};
+  if (!compute_cluster_pca(vertices.data, vertex_count, dimension, labels.data, label_count, cluster)) {
+    return 1;
+  }
+  for (std::size_t label = 0; label < counts.size(); ++label) {
+    outputs.counts.data[label] = static_cast<ndvis_index_t>(counts[label]);
+  }
+  return 0;
+}
+
+struct NdvisStreamingPca {
+  explicit NdvisStreamingPca(std::size_t dimension) : pca(dimension) {}
+  StreamingPca pca;
+};
+
+NdvisStreamingPca* ndvis_streaming_pca_create(size_t dimension) {
+  if (dimension == 0) {
+    return nullptr;
+  }
+  return new NdvisStreamingPca(dimension);
+}
+
+void ndvis_streaming_pca_destroy(NdvisStreamingPca* pca) {
+  delete pca;
+}
+
+void ndvis_streaming_pca_reset(NdvisStreamingPca* pca) {
+  if (pca != nullptr) {
+    pca->pca.reset();
+  }
+}
+
+void ndvis_streaming_pca_add(NdvisStreamingPca* pca, NdvisBuffer vertices, size_t vertex_count) {
+  if (pca == nullptr || vertices.data == nullptr || vertices.length < pca->pca.dimension() * vertex_count) {
+    return;
+  }
+  pca->pca.add_batch(vertices.data, vertex_count);
+}
+
+void ndvis_streaming_pca_remove(NdvisStreamingPca* pca, NdvisBuffer vertices, size_t vertex_count) {
+  if (pca == nullptr || vertices.data == nullptr || vertices.length < pca->pca.dimension() * vertex_count) {
+    return;
+  }
+  pca->pca.remove_batch(vertices.data, vertex_count);
+}
+
+size_t ndvis_streaming_pca_count(const NdvisStreamingPca* pca) {
+  return pca == nullptr ? 0 : pca->pca.count();
+}
+
+void ndvis_streaming_pca_compute(NdvisStreamingPca* pca, NdvisBasis3 basis, NdvisBuffer eigenvalues, NdvisJacobiReport* report) {
+  if (pca == nullptr || basis.data == nullptr) {
+    return;
+  }
+  const std::size_t dimension = pca->pca.dimension();
+  if (basis.stride < dimension || (eigenvalues.data != nullptr && eigenvalues.length < dimension)) {
+    return;
+  }
+  JacobiReport jacobi{};
+  pca->pca.compute_basis(basis.data, eigenvalues.data, &jacobi);
+  write_jacobi_report(jacobi, report);
+}
+
+struct NdvisProgressivePca {
+  NdvisProgressivePca(std::size_t dimension, const ProgressivePcaParams& params) : pca(dimension, params) {}
+  ProgressivePca pca;
+};
+
+NdvisProgressivePca* ndvis_progressive_pca_create(size_t dimension, size_t sample_size, unsigned long long seed) {
+  if (dimension == 0) {
+    return nullptr;
+  }
+  ProgressivePcaParams params{};
+  params.sample_size = sample_size;
+  params.seed = seed;
+  return new NdvisProgressivePca(dimension, params);
+}
+
+void ndvis_progressive_pca_destroy(NdvisProgressivePca* pca) {
+  delete pca;
+}
+
+int ndvis_progressive_pca_begin(NdvisProgressivePca* pca, NdvisBuffer vertices, size_t vertex_count) {
+  if (pca == nullptr || vertices.data == nullptr || vertices.length < pca->pca.dimension() * vertex_count) {
+    return 1;
+  }
+  pca->pca.begin(vertices.data, vertex_count);
+  return 0;
+}
+
+int ndvis_progressive_pca_refine(NdvisProgressivePca* pca, size_t max_vertices) {
+  if (pca == nullptr) {
+    return 0;
+  }
+  return pca->pca.refine_step(max_vertices) ? 1 : 0;
+}
+
+double ndvis_progressive_pca_progress(const NdvisProgressivePca* pca) {
+  return pca == nullptr ? 0.0 : pca->pca.progress();
+}
+
+int ndvis_progressive_pca_approximate(const NdvisProgressivePca* pca, NdvisBasis3 basis, NdvisBuffer eigenvalues, NdvisPcaConfidence* confidence) {
+  if (pca == nullptr || basis.data == nullptr) {
+    return 1;
+  }
+  const std::size_t dimension = pca->pca.dimension();
+  if (basis.stride < dimension || (eigenvalues.data != nullptr && eigenvalues.length < dimension)) {
+    return 1;
+  }
+  PcaConfidence result{};
+  pca->pca.approximate_basis(basis.data, eigenvalues.data, &result);
+  if (confidence != nullptr) {
+    confidence->sample_count = result.sample_count;
+    confidence->vertex_count = result.vertex_count;
+    confidence->eigengap = result.eigengap;
+    confidence->min_gap = result.min_gap;
+    confidence->perturbation = result.perturbation;
+    confidence->subspace_error = result.subspace_error;
+    confidence->component_error = result.component_error;
+    confidence->exact = result.exact ? 1 : 0;
+  }
+  return 0;
+}
+
+int ndvis_progressive_pca_refined(const NdvisProgressivePca* pca, NdvisBasis3 basis, NdvisBuffer eigenvalues) {
+  if (pca == nullptr || basis.data == nullptr) {
+    return 1;
+  }
+  const std::size_t dimension = pca->pca.dimension();
+  if (basis.stride < dimension || (eigenvalues.data != nullptr && eigenvalues.length < dimension)) {
+    return 1;
+  }
+  return pca->pca.refined_basis(basis.data, eigenvalues.data) ? 0 : 1;
+}
+
 float ndvis_point_to_hyperplane_distance(const float* point, NdvisHyperplane hyperplane) {
   Hyperplane hp{hyperplane.normal, hyperplane.dimension, hyperplane.offset};
   return point_to_hyperplane_distance(point, hp);
@@ -113,6 +394,18 @@ void ndvis_classify_vertices(NdvisBuffer vertices, size_t vertex_count, size_t d
   classify_vertices(ConstBufferView{vertices.data, vertices.length}, vertex_count, dimension, hp, out_classifications);
 }
 
+void ndvis_compute_signed_distances(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisHyperplane hyperplane, float* out_distances) {
+  Hyperplane hp{hyperplane.normal, hyperplane.dimension, hyperplane.offset};
+  compute_signed_distances(ConstBufferView{vertices.data, vertices.length}, vertex_count, dimension, hp, out_distances);
+}
+
+void ndvis_classify_distances(const float* distances, size_t count, int* out_classifications) {
+  if (distances == nullptr || out_classifications == nullptr) {
+    return;
+  }
+  classify_distances(distances, count, out_classifications);
+}
+
 NdvisSliceResult ndvis_slice_polytope(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisIndexBuffer edges, NdvisHyperplane hyperplane, NdvisBuffer out_points, NdvisIndexBuffer out_edge_indices) {
   NdvisSliceResult c_result{0, {nullptr, 0}, {nullptr, 0}};
 
@@ -139,6 +432,160 @@ NdvisSliceResult ndvis_slice_polytope(NdvisBuffer vertices, size_t vertex_count,
   return c_result;
 }
 
+size_t ndvis_slice_workspace_size(size_t vertex_count) {
+  return slice_workspace_size(vertex_count);
+}
+
+NdvisSliceResult ndvis_slice_polytope_with_workspace(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisIndexBuffer edges, NdvisHyperplane hyperplane, NdvisBuffer out_points, NdvisIndexBuffer out_edge_indices, float* workspace, size_t workspace_length) {
+  NdvisSliceResult c_result{0, {nullptr, 0}, {nullptr, 0}};
+
+  Hyperplane hp{hyperplane.normal, hyperplane.dimension, hyperplane.offset};
+
+  SliceResult result = slice_polytope(
+      ConstBufferView{vertices.data, vertices.length},
+      vertex_count,
+      dimension,
+      ConstIndexBufferView{edges.data, edges.length},
+      hp,
+      BufferView{out_points.data, out_points.length},
+      IndexBufferView{out_edge_indices.data, out_edge_indices.length},
+      workspace,
+      workspace_length
+  );
+
+  c_result.intersection_count = result.intersection_count;
+  c_result.intersection_points = {result.intersection_points.data, result.intersection_points.length};
+  c_result.intersection_edges = {result.intersection_edges.data, result.intersection_edges.length};
+
+  return c_result;
+}
+
+NdvisSliceResult ndvis_slice_polytope_with_distances(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisIndexBuffer edges, const float* distances, NdvisBuffer out_points, NdvisIndexBuffer out_edge_indices) {
+  NdvisSliceResult c_result{0, {nullptr, 0}, {nullptr, 0}};
+
+  SliceResult result = slice_polytope_with_distances(
+      ConstBufferView{vertices.data, vertices.length},
+      vertex_count,
+      dimension,
+      ConstIndexBufferView{edges.data, edges.length},
+      distances,
+      BufferView{out_points.data, out_points.length},
+      IndexBufferView{out_edge_indices.data, out_edge_indices.length}
+  );
+
+  c_result.intersection_count = result.intersection_count;
+  c_result.intersection_points = {result.intersection_points.data, result.intersection_points.length};
+  c_result.intersection_edges = {result.intersection_edges.data, result.intersection_edges.length};
+
+  return c_result;
+}
+
+NdvisSliceResult ndvis_slice_hypercube(int dimension, NdvisHyperplane hyperplane, NdvisBuffer out_points, NdvisIndexBuffer out_edge_indices) {
+  NdvisSliceResult c_result{0, {nullptr, 0}, {nullptr, 0}};
+
+  if (out_points.data == nullptr) {
+    return c_result;
+  }
+
+  Hyperplane hp{hyperplane.normal, hyperplane.dimension, hyperplane.offset};
+
+  SliceResult result = slice_hypercube(
+      ImplicitHypercube{dimension},
+      hp,
+      BufferView{out_points.data, out_points.length},
+      IndexBufferView{out_edge_indices.data, out_edge_indices.length}
+  );
+
+  c_result.intersection_count = result.intersection_count;
+  c_result.intersection_points = {result.intersection_points.data, result.intersection_points.length};
+  c_result.intersection_edges = {result.intersection_edges.data, result.intersection_edges.length};
+
+  return c_result;
+}
+
+size_t ndvis_slice_polytope_batch(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisIndexBuffer edges, const float* normal, const float* offsets, size_t offset_count, NdvisBuffer out_points, NdvisIndexBuffer out_edge_indices, size_t* out_slice_starts) {
+  return slice_polytope_batch(
+      ConstBufferView{vertices.data, vertices.length},
+      vertex_count,
+      dimension,
+      ConstIndexBufferView{edges.data, edges.length},
+      normal,
+      offsets,
+      offset_count,
+      BufferView{out_points.data, out_points.length},
+      IndexBufferView{out_edge_indices.data, out_edge_indices.length},
+      out_slice_starts
+  );
+}
+
+NdvisSectionResult ndvis_slice_section(NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisIndexBuffer edges, NdvisIndexBuffer face_offsets, NdvisIndexBuffer face_edges, NdvisHyperplane hyperplane, NdvisBuffer out_points, NdvisIndexBuffer out_edges, NdvisIndexBuffer out_vertex_edges) {
+  NdvisSectionResult c_result{0, 0, {nullptr, 0}, {nullptr, 0}, 0};
+
+  Hyperplane hp{hyperplane.normal, hyperplane.dimension, hyperplane.offset};
+
+  SectionResult result = slice_section(
+      ConstBufferView{vertices.data, vertices.length},
+      vertex_count,
+      dimension,
+      ConstIndexBufferView{edges.data, edges.length},
+      ConstFaceView{ConstIndexBufferView{face_offsets.data, face_offsets.length},
+                    ConstIndexBufferView{face_edges.data, face_edges.length}},
+      hp,
+      BufferView{out_points.data, out_points.length},
+      IndexBufferView{out_edges.data, out_edges.length},
+      IndexBufferView{out_vertex_edges.data, out_vertex_edges.length}
+  );
+
+  c_result.vertex_count = result.vertex_count;
+  c_result.edge_count = result.edge_count;
+  c_result.points = {result.points.data, result.points.length};
+  c_result.edges = {result.edges.data, result.edges.length};
+  c_result.truncated = result.truncated ? 1 : 0;
+
+  return c_result;
+}
+
+struct NdvisSliceSweep {
+  SliceSweepIndex index;
+};
+
+NdvisSliceSweep* ndvis_slice_sweep_create(void) {
+  return new NdvisSliceSweep();
+}
+
+void ndvis_slice_sweep_destroy(NdvisSliceSweep* sweep) {
+  delete sweep;
+}
+
+int ndvis_slice_sweep_build(NdvisSliceSweep* sweep, NdvisBuffer vertices, size_t vertex_count, size_t dimension, NdvisIndexBuffer edges, const float* normal) {
+  if (sweep == nullptr) {
+    return 1;
+  }
+  const bool built = sweep->index.build(ConstBufferView{vertices.data, vertices.length}, vertex_count, dimension,
+                                        ConstIndexBufferView{edges.data, edges.length}, normal);
+  return built ? 0 : 1;
+}
+
+NdvisSliceResult ndvis_slice_sweep_slice(NdvisSliceSweep* sweep, float offset, NdvisBuffer out_points, NdvisIndexBuffer out_edge_indices) {
+  NdvisSliceResult c_result{0, {nullptr, 0}, {nullptr, 0}};
+
+  if (sweep == nullptr) {
+    return c_result;
+  }
+
+  SliceResult result = sweep->index.slice(
+      offset,
+      BufferView{out_points.data, out_points.length},
+      IndexBufferView{out_edge_indices.data, out_edge_indices.length}
+  );
+
+  c_result.intersection_count = result.intersection_count;
+  c_result.intersection_points = {result.intersection_points.data, result.intersection_points.length};
+  c_result.intersection_edges = {result.intersection_edges.data, result.intersection_edges.length};
+
+  return c_result;
+}
+
 int ndvis_compute_overlays(
     const NdvisOverlayGeometry* geometry_c,
     const NdvisOverlayHyperplane* hyperplane_c,
@@ -211,6 +658,136 @@ void ndvis_apply_rotations(float* matrix, size_t order, const NdvisRotationPlane
   ndvis::apply_rotations_incremental(matrix, order, cpp_planes, plane_count);
 }
 
+static_assert(sizeof(NdvisRotation4) == sizeof(ndvis::Rotation4), "rotation4 layouts must match");
+
+void ndvis_rotation4_identity(NdvisRotation4* rotation) {
+  if (rotation == nullptr) {
+    return;
+  }
+  *reinterpret_cast<ndvis::Rotation4*>(rotation) = ndvis::Rotation4{};
+}
+
+void ndvis_rotation4_apply(NdvisRotation4* rotation, const NdvisRotationPlane* planes, size_t plane_count) {
+  if (rotation == nullptr || planes == nullptr) {
+    return;
+  }
+  auto* cpp_planes = reinterpret_cast<const ndvis::RotationPlane*>(planes);
+  ndvis::apply_rotations4(*reinterpret_cast<ndvis::Rotation4*>(rotation), cpp_planes, plane_count);
+}
+
+void ndvis_rotation4_to_matrix(const NdvisRotation4* rotation, float* out_matrix) {
+  if (rotation == nullptr || out_matrix == nullptr) {
+    return;
+  }
+  ndvis::rotation4_to_matrix(*reinterpret_cast<const ndvis::Rotation4*>(rotation), out_matrix);
+}
+
+static_assert(sizeof(NdvisDriftScheduler) == sizeof(ndvis::DriftScheduler), "drift scheduler layouts must match");
+
+void ndvis_drift_scheduler_init(NdvisDriftScheduler* scheduler, float threshold) {
+  if (scheduler == nullptr) {
+    return;
+  }
+  ndvis::DriftScheduler initial{};
+  initial.threshold = threshold;
+  *reinterpret_cast<ndvis::DriftScheduler*>(scheduler) = initial;
+}
+
+int ndvis_apply_rotations_scheduled(NdvisDriftScheduler* scheduler, float* matrix, size_t order, const NdvisRotationPlane* planes, size_t plane_count) {
+  if (scheduler == nullptr || matrix == nullptr || planes == nullptr) {
+    return 0;
+  }
+  auto* cpp_planes = reinterpret_cast<const ndvis::RotationPlane*>(planes);
+  auto* cpp_scheduler = reinterpret_cast<ndvis::DriftScheduler*>(scheduler);
+  return ndvis::apply_rotations_scheduled(*cpp_scheduler, matrix, order, cpp_planes, plane_count) ? 1 : 0;
+}
+
+static ndvis::ExpMapMethod to_expmap_method(int method) {
+  return method == NDVIS_EXPMAP_PADE ? ndvis::ExpMapMethod::kPade : ndvis::ExpMapMethod::kCayley;
+}
+
+int ndvis_apply_angular_velocity(float* matrix, size_t order, const NdvisRotationPlane* velocities, size_t velocity_count, float dt, int method) {
+  if (matrix == nullptr || velocities == nullptr || order == 0) {
+    return 1;
+  }
+  auto* cpp_planes = reinterpret_cast<const ndvis::RotationPlane*>(velocities);
+  std::vector<float> generator(order * order);
+  ndvis::build_rotation_generator(cpp_planes, velocity_count, order, generator.data());
+  return ndvis::apply_angular_velocity(matrix, order, generator.data(), dt, to_expmap_method(method)) ? 0 : 1;
+}
+
+void ndvis_build_rotation_generator(const NdvisRotationPlane* velocities, size_t velocity_count, size_t order, float* out_generator) {
+  ndvis::build_rotation_generator(reinterpret_cast<const ndvis::RotationPlane*>(velocities), velocity_count, order,
+                                  out_generator);
+}
+
+size_t ndvis_angular_velocity_workspace_size(size_t order, int method) {
+  return ndvis::angular_velocity_workspace_size(order, to_expmap_method(method));
+}
+
+int ndvis_apply_angular_velocity_with_workspace(float* matrix, size_t order, const float* generator, float dt, int method, double* workspace, size_t workspace_length) {
+  return ndvis::apply_angular_velocity(matrix, order, generator, dt, to_expmap_method(method), workspace,
+                                       workspace_length)
+             ? 0
+             : 1;
+}
+
+void ndvis_build_projection_operator(
+    const float* rotation_matrix,
+    size_t rotation_stride,
+    const float* basis3,
+    size_t basis_stride,
+    size_t dimension,
+    float* out_operator) {
+  if (rotation_matrix == nullptr || basis3 == nullptr || out_operator == nullptr || dimension == 0) {
+    return;
+  }
+  const std::size_t basis_stride_use = basis_stride == 0 ? dimension : basis_stride;
+  ndvis::build_projection_operator(rotation_matrix, rotation_stride, ndvis::ConstBasis3{basis3, basis_stride_use, dimension},
+                                   out_operator);
+}
+
+void ndvis_project_geometry_incremental(
+    const float* vertices,
+    size_t vertex_count,
+    size_t dimension,
+    float* projection_operator,
+    const NdvisRotationPlane* planes,
+    size_t plane_count,
+    float* positions,
+    size_t positions_length) {
+  if (vertices == nullptr || projection_operator == nullptr || planes == nullptr || positions == nullptr) {
+    return;
+  }
+  if (positions_length < vertex_count * 3) {
+    return;
+  }
+  auto* cpp_planes = reinterpret_cast<const ndvis::RotationPlane*>(planes);
+  ndvis::update_projection_incremental(ndvis::ConstBufferView{vertices, dimension * vertex_count}, dimension,
+                                       vertex_count, projection_operator, cpp_planes, plane_count, positions);
+}
+
+void ndvis_project_hypercube(int dimension, const float* projection_operator, float* positions, size_t positions_length) {
+  if (positions_length < hypercube_vertex_count(dimension) * 3) {
+    return;
+  }
+  ndvis::project_hypercube(dimension, projection_operator, positions);
+}
+
+void ndvis_project_simplex(int dimension, const float* projection_operator, float* positions, size_t positions_length) {
+  if (positions_length < simplex_vertex_count(dimension) * 3) {
+    return;
+  }
+  ndvis::project_simplex(dimension, projection_operator, positions);
+}
+
+void ndvis_project_orthoplex(int dimension, const float* projection_operator, float* positions, size_t positions_length) {
+  if (positions_length < orthoplex_vertex_count(dimension) * 3) {
+    return;
+  }
+  ndvis::project_orthoplex(dimension, projection_operator, positions);
+}
+
 float ndvis_compute_orthogonality_drift(const float* matrix, size_t order) {
   return ndvis::compute_orthogonality_drift(matrix, order);
 }
@@ -219,4 +796,23 @@ void ndvis_reorthonormalize(float* matrix, size_t order) {
   ndvis::reorthonormalize(matrix, order);
 }
 
+static ndvis::OrthonormalizeMethod to_orthonormalize_method(int method) {
+  switch (method) {
+    case NDVIS_ORTHONORMALIZE_HOUSEHOLDER:
+      return ndvis::OrthonormalizeMethod::kHouseholder;
+    case NDVIS_ORTHONORMALIZE_NEWTON_SCHULZ:
+      return ndvis::OrthonormalizeMethod::kNewtonSchulz;
+    default:
+      return ndvis::OrthonormalizeMethod::kModifiedGramSchmidt;
+  }
+}
+
+size_t ndvis_reorthonormalize_workspace_size(size_t order, int method) {
+  return ndvis::reorthonormalize_workspace_size(order, to_orthonormalize_method(method));
+}
+
+int ndvis_reorthonormalize_with_workspace(float* matrix, size_t order, int method, double* workspace, size_t workspace_length) {
+  return ndvis::reorthonormalize(matrix, order, to_orthonormalize_method(method), workspace, workspace_length) ? 0 : 1;
+}
+
 }  // extern "C"
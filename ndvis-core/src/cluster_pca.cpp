@@ -0,0 +1,211 @@
+#include "ndvis/pca.hpp"
+
+#include <cstddef>
+#include <vector>
+
+#include "ndvis/detail/eigen.hpp"
+#include "ndvis/detail/jacobi.hpp"
+#include "ndvis/detail/thread_pool.hpp"
+
+namespace ndvis {
+
+namespace {
+
+// Vertices per partial below kMaxPartials partials (as in detail/covariance.cpp); bounds depend only on
+// vertex_count, which keeps the ordered merge deterministic.
+constexpr std::size_t kPartialVertices = 16384;
+constexpr std::size_t kMaxPartials = 8;
+// Moment doubles all partials may hold together (16 MiB). Many labels at a large n get fewer partials, down
+// to a single one whose label_count * stride doubles are the floor. The count still depends only on the
+// input sizes, never on the thread count.
+constexpr std::size_t kMaxMomentDoubles = std::size_t{1} << 21;
+// Labels solved per worker chunk; one Jacobi solve at small n is tens of microseconds.
+constexpr std::size_t kSolveChunk = 8;
+
+// Per-label moments of one partial, shifted by the first vertex of that label seen in the partial so
+// clusters far from the origin keep their precision: count, shift[n], sum[n], packed lower triangle of
+// sum (x - shift)(x - shift)^T.
+struct MomentLayout {
+  explicit MomentLayout(std::size_t dimension)
+      : dimension(dimension), stride(1 + 2 * dimension + dimension * (dimension + 1) / 2) {}
+  std::size_t dimension;
+  std::size_t stride;
+  double* count(double* label) const { return label; }
+  double* shift(double* label) const { return label + 1; }
+  double* sum(double* label) const { return label + 1 + dimension; }
+  double* lower(double* label) const { return label + 1 + 2 * dimension; }
+};
+
+void accumulate_partial(const float* vertices, std::size_t vertex_count, const index_type* labels,
+                        std::size_t label_count, std::size_t begin, std::size_t end, const MomentLayout& layout,
+                        double* moments, double* centered) {
+  const std::size_t n = layout.dimension;
+  for (std::size_t v = begin; v < end; ++v) {
+    const std::size_t label = labels[v];
+    if (label >= label_count) {
+      continue;
+    }
+    double* entry = moments + label * layout.stride;
+    double* shift = layout.shift(entry);
+    if (*layout.count(entry) == 0.0) {
+      for (std::size_t axis = 0; axis < n; ++axis) {
+        shift[axis] = static_cast<double>(vertices[axis * vertex_count + v]);
+      }
+    }
+    for (std::size_t axis = 0; axis < n; ++axis) {
+      centered[axis] = static_cast<double>(vertices[axis * vertex_count + v]) - shift[axis];
+    }
+    *layout.count(entry) += 1.0;
+    double* sum = layout.sum(entry);
+    double* lower = layout.lower(entry);
+    for (std::size_t i = 0; i < n; ++i) {
+      sum[i] += centered[i];
+      const double value = centered[i];
+      double* row = lower + i * (i + 1) / 2;
+      for (std::size_t j = 0; j <= i; ++j) {
+        row[j] += value * centered[j];
+      }
+    }
+  }
+}
+
+void write_identity(std::size_t dimension, float* out_basis) {
+  for (std::size_t component = 0; component < 3; ++component) {
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      out_basis[component * dimension + axis] = (component == axis) ? 1.0f : 0.0f;
+    }
+  }
+}
+
+}  // namespace
+
+bool compute_cluster_pca(const float* vertices, std::size_t vertex_count, std::size_t dimension,
+                         const index_type* labels, std::size_t label_count, const ClusterPcaOutputs& outputs) {
+  if (vertices == nullptr || (labels == nullptr && vertex_count != 0) || outputs.bases == nullptr ||
+      dimension == 0 || label_count == 0) {
+    return false;
+  }
+  const std::size_t n = dimension;
+  const MomentLayout layout(n);
+  std::size_t partial_count = (vertex_count + kPartialVertices - 1) / kPartialVertices;
+  partial_count = partial_count < kMaxPartials ? partial_count : kMaxPartials;
+  const std::size_t partial_size = label_count * layout.stride;
+  const std::size_t budget_partials = kMaxMomentDoubles / partial_size;
+  partial_count = partial_count < budget_partials ? partial_count : budget_partials;
+  partial_count = partial_count == 0 ? 1 : partial_count;
+  std::vector<double> moments(partial_count * partial_size, 0.0);
+  std::vector<double> centered(partial_count * n);
+
+  detail::parallel_for(partial_count, 1, [&](std::size_t first, std::size_t last) {
+    for (std::size_t partial = first; partial < last; ++partial) {
+      accumulate_partial(vertices, vertex_count, labels, label_count,
+                         detail::chunk_begin(vertex_count, partial_count, partial),
+                         detail::chunk_begin(vertex_count, partial_count, partial + 1), layout,
+                         moments.data() + partial * partial_size, centered.data() + partial * n);
+    }
+  });
+
+  detail::parallel_for(label_count, kSolveChunk, [&](std::size_t first, std::size_t last) {
+    std::vector<double> mean(n);
+    std::vector<double> scatter(n * n);
+    std::vector<double> eigenvectors(n * n);
+    std::vector<double> eigenvalues(n);
+    for (std::size_t label = first; label < last; ++label) {
+      // Chan merge of the partials in order: each contributes count c_b, mean m_b and scatter S_b, and
+      // S += S_b + delta delta^T * c_a * c_b / (c_a + c_b) with delta = m_b - m_a.
+      double count = 0.0;
+      for (std::size_t i = 0; i < n; ++i) {
+        mean[i] = 0.0;
+      }
+      for (std::size_t i = 0; i < n * n; ++i) {
+        scatter[i] = 0.0;
+      }
+      for (std::size_t partial = 0; partial < partial_count; ++partial) {
+        double* entry = moments.data() + partial * partial_size + label * layout.stride;
+        const double batch_count = *layout.count(entry);
+        if (batch_count == 0.0) {
+          continue;
+        }
+        const double* shift = layout.shift(entry);
+        double* sum = layout.sum(entry);
+        const double* lower = layout.lower(entry);
+        // Partial mean (kept in `sum`) and scatter about it.
+        for (std::size_t i = 0; i < n; ++i) {
+          sum[i] /= batch_count;
+        }
+        const double total = count + batch_count;
+        const double weight = count * batch_count / total;
+        for (std::size_t i = 0; i < n; ++i) {
+          const double delta_i = shift[i] + sum[i] - mean[i];
+          for (std::size_t j = 0; j <= i; ++j) {
+            const double delta_j = shift[j] + sum[j] - mean[j];
+            const double value = lower[i * (i + 1) / 2 + j] - batch_count * sum[i] * sum[j] +
+                                 delta_i * delta_j * weight;
+            scatter[i * n + j] += value;
+          }
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+          mean[i] += (shift[i] + sum[i] - mean[i]) * batch_count / total;
+        }
+        count = total;
+      }
+
+      const double normalizer = count > 1.0 ? 1.0 / (count - 1.0) : 1.0;
+      for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j <= i; ++j) {
+          const double value = scatter[i * n + j] * normalizer;
+          scatter[i * n + j] = value;
+          scatter[j * n + i] = value;
+        }
+      }
+      if (outputs.counts != nullptr) {
+        outputs.counts[label] = static_cast<std::size_t>(count);
+      }
+      if (outputs.means != nullptr) {
+        for (std::size_t i = 0; i < n; ++i) {
+          outputs.means[label * n + i] = static_cast<float>(mean[i]);
+        }
+      }
+      if (outputs.covariances != nullptr) {
+        for (std::size_t i = 0; i < n * n; ++i) {
+          outputs.covariances[label * n * n + i] = static_cast<float>(scatter[i]);
+        }
+      }
+
+      float* basis = outputs.bases + label * 3 * n;
+      if (count == 0.0) {
+        write_identity(n, basis);
+        if (outputs.eigenvalues != nullptr) {
+          for (std::size_t i = 0; i < n; ++i) {
+            outputs.eigenvalues[label * n + i] = 0.0f;
+          }
+        }
+        continue;
+      }
+      detail::EigenParams params{};
+      detail::symmetric_eigen(scatter.data(), eigenvectors.data(), n, params);
+      for (std::size_t i = 0; i < n; ++i) {
+        eigenvalues[i] = scatter[i * n + i];
+      }
+      detail::sort_eigenpairs(eigenvalues.data(), eigenvectors.data(), n);
+      for (std::size_t component = 0; component < 3; ++component) {
+        for (std::size_t axis = 0; axis < n; ++axis) {
+          if (component < n) {
+            basis[component * n + axis] = static_cast<float>(eigenvectors[axis * n + component]);
+          } else {
+            basis[component * n + axis] = (component == axis) ? 1.0f : 0.0f;
+          }
+        }
+      }
+      if (outputs.eigenvalues != nullptr) {
+        for (std::size_t i = 0; i < n; ++i) {
+          const double value = eigenvalues[i];
+          outputs.eigenvalues[label * n + i] = static_cast<float>(value < 0.0 ? 0.0 : value);
+        }
+      }
+    }
+  });
+  return true;
+}
+
+}  // namespace ndvis
@@ -0,0 +1,226 @@
+#include "ndvis/detail/covariance.hpp"
+
+#include <vector>
+
+#include "ndvis/detail/simd.hpp"
+#include "ndvis/detail/thread_pool.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define NDVIS_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace ndvis::detail {
+
+namespace {
+
+// Vertices per partial sum below kMaxPartials partials; partials are the unit of parallelism and of the
+// ordered reduction, and their bounds depend only on vertex_count.
+constexpr std::size_t kPartialVertices = 16384;
+// Partials (and so worker threads) per covariance; caps the workspace at a function of the dimension.
+constexpr std::size_t kMaxPartials = 8;
+// Vertices centered at a time; dimension * kCenterBlock doubles stay in L1.
+constexpr std::size_t kCenterBlock = 64;
+// Centered rows are zero-padded to a multiple of this many vertices (zeros add nothing to a dot).
+constexpr std::size_t kLanes = 4;
+
+// Adds the lower triangle of rows * rows^T to `lower` (packed row by row). rows: dimension rows of
+// `stride` doubles, the first `count` (a multiple of kLanes) in use.
+using ScatterKernel = void (*)(const double* rows, std::size_t stride, std::size_t dimension, std::size_t count,
+                               double* lower);
+
+void scatter_scalar(const double* rows, std::size_t stride, std::size_t dimension, std::size_t count,
+                    double* lower) {
+  std::size_t slot = 0;
+  for (std::size_t i = 0; i < dimension; ++i) {
+    const double* row_i = rows + i * stride;
+    for (std::size_t j = 0; j <= i; ++j, ++slot) {
+      const double* row_j = rows + j * stride;
+      // Independent lanes so the loop vectorizes without reassociating the sum.
+      double lanes[kLanes] = {0.0, 0.0, 0.0, 0.0};
+      for (std::size_t k = 0; k < count; k += kLanes) {
+        for (std::size_t lane = 0; lane < kLanes; ++lane) {
+          lanes[lane] += row_i[k + lane] * row_j[k + lane];
+        }
+      }
+      lower[slot] += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+  }
+}
+
+#if defined(NDVIS_SIMD_X86)
+
+__attribute__((target("avx2,fma"))) double horizontal_sum(__m256d value) {
+  alignas(32) double lanes[kLanes];
+  _mm256_store_pd(lanes, value);
+  return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+// Four j rows per pass share each load of row i.
+__attribute__((target("avx2,fma"))) void scatter_avx2(const double* rows, std::size_t stride, std::size_t dimension,
+                                                      std::size_t count, double* lower) {
+  std::size_t slot = 0;
+  for (std::size_t i = 0; i < dimension; ++i) {
+    const double* row_i = rows + i * stride;
+    std::size_t j = 0;
+    for (; j + 4 <= i + 1; j += 4, slot += 4) {
+      const double* row_j = rows + j * stride;
+      __m256d acc0 = _mm256_setzero_pd();
+      __m256d acc1 = _mm256_setzero_pd();
+      __m256d acc2 = _mm256_setzero_pd();
+      __m256d acc3 = _mm256_setzero_pd();
+      for (std::size_t k = 0; k < count; k += kLanes) {
+        const __m256d value = _mm256_loadu_pd(row_i + k);
+        acc0 = _mm256_fmadd_pd(value, _mm256_loadu_pd(row_j + k), acc0);
+        acc1 = _mm256_fmadd_pd(value, _mm256_loadu_pd(row_j + stride + k), acc1);
+        acc2 = _mm256_fmadd_pd(value, _mm256_loadu_pd(row_j + 2 * stride + k), acc2);
+        acc3 = _mm256_fmadd_pd(value, _mm256_loadu_pd(row_j + 3 * stride + k), acc3);
+      }
+      lower[slot + 0] += horizontal_sum(acc0);
+      lower[slot + 1] += horizontal_sum(acc1);
+      lower[slot + 2] += horizontal_sum(acc2);
+      lower[slot + 3] += horizontal_sum(acc3);
+    }
+    for (; j <= i; ++j, ++slot) {
+      const double* row_j = rows + j * stride;
+      __m256d acc = _mm256_setzero_pd();
+      for (std::size_t k = 0; k < count; k += kLanes) {
+        acc = _mm256_fmadd_pd(_mm256_loadu_pd(row_i + k), _mm256_loadu_pd(row_j + k), acc);
+      }
+      lower[slot] += horizontal_sum(acc);
+    }
+  }
+}
+
+#endif  // NDVIS_SIMD_X86
+
+ScatterKernel active_scatter_kernel() {
+#if defined(NDVIS_SIMD_X86)
+  const SimdLevel level = active_simd_level();
+  if (level == SimdLevel::kAvx2 || level == SimdLevel::kAvx512) {
+    return &scatter_avx2;
+  }
+#endif
+  return &scatter_scalar;
+}
+
+// Lower-triangle scatter sum_v (x_v - mean)(x_v - mean)^T over [begin, end), SYRK-style: each block of
+// vertices is centered into contiguous per-axis rows, then the kernel takes every (i, j <= i) pair.
+void accumulate_scatter(const float* vertices, std::size_t stride, std::size_t dimension, const double* mean,
+                        std::size_t begin, std::size_t end, ScatterKernel kernel, double* lower, double* centered) {
+  for (std::size_t block = begin; block < end; block += kCenterBlock) {
+    const std::size_t count = end - block < kCenterBlock ? end - block : kCenterBlock;
+    const std::size_t padded = (count + kLanes - 1) / kLanes * kLanes;
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      const float* column = vertices + axis * stride + block;
+      double* row = centered + axis * kCenterBlock;
+      const double axis_mean = mean[axis];
+      for (std::size_t k = 0; k < count; ++k) {
+        row[k] = static_cast<double>(column[k]) - axis_mean;
+      }
+      for (std::size_t k = count; k < padded; ++k) {
+        row[k] = 0.0;
+      }
+    }
+    kernel(centered, kCenterBlock, dimension, padded, lower);
+  }
+}
+
+// Per-partial workspace: axis sums, packed lower triangle, centered block rows.
+std::size_t partial_stride(std::size_t dimension) {
+  return dimension + dimension * (dimension + 1) / 2 + dimension * kCenterBlock;
+}
+
+}  // namespace
+
+std::size_t covariance_workspace_size(std::size_t dimension) {
+  return kMaxPartials * partial_stride(dimension);
+}
+
+void compute_covariance(const float* vertices, std::size_t vertex_count, std::size_t dimension, double* out_mean,
+                        double* out_covariance) {
+  if (vertices == nullptr || vertex_count == 0 || dimension == 0) {
+    return;
+  }
+  std::vector<double> workspace(covariance_workspace_size(dimension));
+  compute_covariance(vertices, vertex_count, dimension, out_mean, out_covariance, workspace.data());
+}
+
+void compute_covariance(const float* vertices, std::size_t vertex_count, std::size_t dimension, double* out_mean,
+                        double* out_covariance, double* workspace) {
+  compute_covariance_strided(vertices, vertex_count, vertex_count, dimension, out_mean, out_covariance, workspace);
+}
+
+void compute_covariance_strided(const float* vertices, std::size_t vertex_count, std::size_t stride,
+                                std::size_t dimension, double* out_mean, double* out_covariance, double* workspace) {
+  if (vertices == nullptr || out_mean == nullptr || out_covariance == nullptr || workspace == nullptr ||
+      vertex_count == 0 || dimension == 0 || stride < vertex_count) {
+    return;
+  }
+  std::size_t partial_count = (vertex_count + kPartialVertices - 1) / kPartialVertices;
+  partial_count = partial_count < kMaxPartials ? partial_count : kMaxPartials;
+  const std::size_t partial_size = partial_stride(dimension);
+  const std::size_t lower_count = dimension * (dimension + 1) / 2;
+  auto sums = [&](std::size_t partial) { return workspace + partial * partial_size; };
+  auto lower = [&](std::size_t partial) { return workspace + partial * partial_size + dimension; };
+  auto centered = [&](std::size_t partial) { return workspace + partial * partial_size + dimension + lower_count; };
+
+  // Pass 1: per-partial axis sums, reduced in partial order.
+  parallel_for(partial_count, 1, [&](std::size_t first, std::size_t last) {
+    for (std::size_t partial = first; partial < last; ++partial) {
+      const std::size_t begin = chunk_begin(vertex_count, partial_count, partial);
+      const std::size_t end = chunk_begin(vertex_count, partial_count, partial + 1);
+      for (std::size_t axis = 0; axis < dimension; ++axis) {
+        const float* column = vertices + axis * stride;
+        double lanes[kLanes] = {0.0, 0.0, 0.0, 0.0};
+        std::size_t v = begin;
+        for (; v + kLanes <= end; v += kLanes) {
+          for (std::size_t lane = 0; lane < kLanes; ++lane) {
+            lanes[lane] += static_cast<double>(column[v + lane]);
+          }
+        }
+        for (; v < end; ++v) {
+          lanes[0] += static_cast<double>(column[v]);
+        }
+        sums(partial)[axis] = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+      }
+    }
+  });
+  for (std::size_t axis = 0; axis < dimension; ++axis) {
+    double sum = 0.0;
+    for (std::size_t partial = 0; partial < partial_count; ++partial) {
+      sum += sums(partial)[axis];
+    }
+    out_mean[axis] = sum / static_cast<double>(vertex_count);
+  }
+
+  // Pass 2: centered lower-triangle scatter per partial, reduced in partial order.
+  const ScatterKernel kernel = active_scatter_kernel();
+  parallel_for(partial_count, 1, [&](std::size_t first, std::size_t last) {
+    for (std::size_t partial = first; partial < last; ++partial) {
+      double* partial_lower = lower(partial);
+      for (std::size_t slot = 0; slot < lower_count; ++slot) {
+        partial_lower[slot] = 0.0;
+      }
+      accumulate_scatter(vertices, stride, dimension, out_mean, chunk_begin(vertex_count, partial_count, partial),
+                         chunk_begin(vertex_count, partial_count, partial + 1), kernel, partial_lower,
+                         centered(partial));
+    }
+  });
+
+  const double normalizer = vertex_count > 1 ? 1.0 / static_cast<double>(vertex_count - 1) : 1.0;
+  std::size_t slot = 0;
+  for (std::size_t i = 0; i < dimension; ++i) {
+    for (std::size_t j = 0; j <= i; ++j, ++slot) {
+      double sum = 0.0;
+      for (std::size_t partial = 0; partial < partial_count; ++partial) {
+        sum += lower(partial)[slot];
+      }
+      const double value = sum * normalizer;
+      out_covariance[i * dimension + j] = value;
+      out_covariance[j * dimension + i] = value;
+    }
+  }
+}
+
+}  // namespace ndvis::detail
@@ -0,0 +1,110 @@
+#include "ndvis/drift.hpp"
+
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+
+#include "ndvis/qr.hpp"
+
+namespace ndvis {
+
+namespace {
+
+// Rounding one Givens plane adds to ||R^T R - I||_F: the two touched columns pick up about 2 ulps per
+// entry, i.e. ~2 * eps * sqrt(n) in their dot products with every other column. Successive planes
+// round independently, so contributions add in quadrature (a worst-case linear sum overestimates
+// real drift by orders of magnitude and would trigger a check every frame).
+constexpr float kPlaneRoundingFactor = 2.0f * FLT_EPSILON;
+
+// Map a linear index over the upper triangle (row-ordered, diagonal included) to (i, j).
+void pair_from_index(std::size_t index, std::size_t order, std::size_t* out_i, std::size_t* out_j) {
+  std::size_t i = 0;
+  std::size_t row_length = order;
+  while (index >= row_length) {
+    index -= row_length;
+    ++i;
+    --row_length;
+  }
+  *out_i = i;
+  *out_j = i + index;
+}
+
+}  // namespace
+
+float estimate_orthogonality_drift(const float* matrix, std::size_t order, std::size_t first_pair,
+                                   std::size_t pair_count) {
+  if (matrix == nullptr || order == 0 || pair_count == 0) {
+    return 0.0f;
+  }
+  const std::size_t total_pairs = order * (order + 1) / 2;
+  if (pair_count > total_pairs) {
+    pair_count = total_pairs;
+  }
+
+  std::size_t i = 0;
+  std::size_t j = 0;
+  pair_from_index(first_pair % total_pairs, order, &i, &j);
+
+  double sum_sq = 0.0;
+  double weight = 0.0;
+  for (std::size_t sample = 0; sample < pair_count; ++sample) {
+    double dot = 0.0;
+    for (std::size_t row = 0; row < order; ++row) {
+      dot += static_cast<double>(matrix[row * order + i]) * static_cast<double>(matrix[row * order + j]);
+    }
+    const double residual = i == j ? dot - 1.0 : dot;
+    // Off-diagonal pairs appear twice in R^T R.
+    const double pair_weight = i == j ? 1.0 : 2.0;
+    sum_sq += pair_weight * residual * residual;
+    weight += pair_weight;
+
+    if (++j == order) {
+      i = i + 1 == order ? 0 : i + 1;
+      j = i;
+    }
+  }
+  const double full_weight = static_cast<double>(order) * static_cast<double>(order);
+  return static_cast<float>(std::sqrt(sum_sq * full_weight / weight));
+}
+
+void drift_scheduler_record(DriftScheduler& scheduler, std::size_t order, std::size_t plane_count) {
+  ++scheduler.steps;
+  const float plane_variance = kPlaneRoundingFactor * kPlaneRoundingFactor * static_cast<float>(order);
+  scheduler.rounding_bound = std::sqrt(scheduler.rounding_bound * scheduler.rounding_bound +
+                                       static_cast<float>(plane_count) * plane_variance);
+}
+
+bool drift_scheduler_maintain(DriftScheduler& scheduler, float* matrix, std::size_t order) {
+  if (matrix == nullptr || order == 0 || scheduler.rounding_bound < scheduler.threshold) {
+    return false;
+  }
+
+  const std::size_t total_pairs = order * (order + 1) / 2;
+  const std::size_t pairs = scheduler.sample_pairs == 0 ? 2 * order : scheduler.sample_pairs;
+  scheduler.last_estimate = estimate_orthogonality_drift(matrix, order, scheduler.sample_cursor, pairs);
+  scheduler.sample_cursor = (scheduler.sample_cursor + pairs) % total_pairs;
+  ++scheduler.checks;
+
+  if (scheduler.last_estimate < scheduler.threshold) {
+    // The a-priori bound is pessimistic; restart it from what was actually measured.
+    scheduler.rounding_bound = scheduler.last_estimate;
+    return false;
+  }
+
+  reorthonormalize(matrix, order);
+  ++scheduler.reorthonormalizations;
+  scheduler.rounding_bound = 0.0f;
+  return true;
+}
+
+bool apply_rotations_scheduled(DriftScheduler& scheduler, float* matrix, std::size_t order,
+                               const RotationPlane* planes, std::size_t plane_count) {
+  if (matrix == nullptr || planes == nullptr || order == 0) {
+    return false;
+  }
+  apply_rotations(matrix, order, planes, plane_count);
+  drift_scheduler_record(scheduler, order, plane_count);
+  return drift_scheduler_maintain(scheduler, matrix, order);
+}
+
+}  // namespace ndvis
@@ -0,0 +1,284 @@
+#include "ndvis/detail/eigen.hpp"
+
+#include <vector>
+
+namespace ndvis::detail {
+
+namespace {
+
+double absolute(double value) {
+  return value < 0.0 ? -value : value;
+}
+
+double hypotenuse(double a, double b) {
+  return __builtin_hypot(a, b);
+}
+
+void transpose_in_place(double* matrix, std::size_t order) {
+  for (std::size_t i = 0; i < order; ++i) {
+    for (std::size_t j = i + 1; j < order; ++j) {
+      const double tmp = matrix[i * order + j];
+      matrix[i * order + j] = matrix[j * order + i];
+      matrix[j * order + i] = tmp;
+    }
+  }
+}
+
+// Householder tridiagonalization of the symmetric matrix held in v (EISPACK tred2). On return d holds
+// the diagonal, e[1..n) the subdiagonal (e[0] = 0) and v the accumulated orthogonal transform.
+// scratch: n doubles.
+void tridiagonalize(double* v, std::size_t n, double* d, double* e, double* scratch) {
+  for (std::size_t j = 0; j < n; ++j) {
+    d[j] = v[(n - 1) * n + j];
+  }
+
+  for (std::size_t i = n - 1; i > 0; --i) {
+    double scale = 0.0;
+    double h = 0.0;
+    for (std::size_t k = 0; k < i; ++k) {
+      scale += absolute(d[k]);
+    }
+    if (scale == 0.0) {
+      e[i] = d[i - 1];
+      for (std::size_t j = 0; j < i; ++j) {
+        d[j] = v[(i - 1) * n + j];
+        v[i * n + j] = 0.0;
+        v[j * n + i] = 0.0;
+      }
+    } else {
+      // Householder vector u = d[0..i) scaled; the update is A - u p^T - p u^T with p from e.
+      for (std::size_t k = 0; k < i; ++k) {
+        d[k] /= scale;
+        h += d[k] * d[k];
+      }
+      double f = d[i - 1];
+      double g = __builtin_sqrt(h);
+      if (f > 0.0) {
+        g = -g;
+      }
+      e[i] = scale * g;
+      h -= f * g;
+      d[i - 1] = f - g;
+      // p = A u over the active i x i block. The block is kept fully symmetric (both triangles), so the
+      // product and the rank-2 update below run along contiguous rows.
+      for (std::size_t j = 0; j < i; ++j) {
+        v[j * n + i] = d[j];
+        const double* row = v + j * n;
+        double sum = 0.0;
+        for (std::size_t k = 0; k < i; ++k) {
+          sum += row[k] * d[k];
+        }
+        e[j] = sum;
+      }
+      f = 0.0;
+      for (std::size_t j = 0; j < i; ++j) {
+        e[j] /= h;
+        f += e[j] * d[j];
+      }
+      const double hh = f / (h + h);
+      for (std::size_t j = 0; j < i; ++j) {
+        e[j] -= hh * d[j];
+      }
+      for (std::size_t j = 0; j < i; ++j) {
+        f = d[j];
+        g = e[j];
+        double* row = v + j * n;
+        for (std::size_t k = 0; k < i; ++k) {
+          row[k] -= (f * e[k] + g * d[k]);
+        }
+      }
+      for (std::size_t j = 0; j < i; ++j) {
+        d[j] = v[(i - 1) * n + j];
+        v[i * n + j] = 0.0;
+      }
+    }
+    d[i] = h;
+  }
+
+  // Accumulate the transformations: the leading block becomes (I - u u^T / h) times itself, with the
+  // products g = u^T V formed row by row into `scratch`.
+  for (std::size_t i = 0; i + 1 < n; ++i) {
+    v[(n - 1) * n + i] = v[i * n + i];
+    v[i * n + i] = 1.0;
+    const double h = d[i + 1];
+    if (h != 0.0) {
+      for (std::size_t k = 0; k <= i; ++k) {
+        d[k] = v[k * n + i + 1] / h;
+      }
+      for (std::size_t j = 0; j <= i; ++j) {
+        scratch[j] = 0.0;
+      }
+      for (std::size_t k = 0; k <= i; ++k) {
+        const double u = v[k * n + i + 1];
+        const double* row = v + k * n;
+        for (std::size_t j = 0; j <= i; ++j) {
+          scratch[j] += u * row[j];
+        }
+      }
+      for (std::size_t k = 0; k <= i; ++k) {
+        const double scale = d[k];
+        double* row = v + k * n;
+        for (std::size_t j = 0; j <= i; ++j) {
+          row[j] -= scale * scratch[j];
+        }
+      }
+    }
+    for (std::size_t k = 0; k <= i; ++k) {
+      v[k * n + i + 1] = 0.0;
+    }
+  }
+  for (std::size_t j = 0; j < n; ++j) {
+    d[j] = v[(n - 1) * n + j];
+    v[(n - 1) * n + j] = 0.0;
+  }
+  v[(n - 1) * n + n - 1] = 1.0;
+  e[0] = 0.0;
+}
+
+// Implicit-shift QL on the tridiagonal (d, e) (EISPACK tql2). `rows` holds the transform from
+// tridiagonalize transposed, so each plane rotation touches two contiguous rows; on return its rows are
+// the eigenvectors and d the eigenvalues (unsorted). Returns false if an eigenvalue ran out of iterations.
+bool ql_implicit(double* d, double* e, double* rows, std::size_t n, std::size_t max_iterations,
+                 JacobiReport& report) {
+  for (std::size_t i = 1; i < n; ++i) {
+    e[i - 1] = e[i];
+  }
+  e[n - 1] = 0.0;
+
+  bool converged = true;
+  double f = 0.0;
+  double norm = 0.0;
+  const double eps = 0x1.0p-52;
+  for (std::size_t l = 0; l < n; ++l) {
+    const double magnitude = absolute(d[l]) + absolute(e[l]);
+    norm = magnitude > norm ? magnitude : norm;
+    std::size_t m = l;
+    while (m < n - 1 && absolute(e[m]) > eps * norm) {
+      ++m;
+    }
+
+    if (m > l) {
+      std::size_t iterations = 0;
+      do {
+        if (iterations++ == max_iterations) {
+          converged = false;
+          break;
+        }
+        ++report.sweeps;
+        // Wilkinson-style shift from the leading 2x2 block.
+        double g = d[l];
+        double p = (d[l + 1] - g) / (2.0 * e[l]);
+        double r = hypotenuse(p, 1.0);
+        if (p < 0.0) {
+          r = -r;
+        }
+        d[l] = e[l] / (p + r);
+        d[l + 1] = e[l] * (p + r);
+        const double dl1 = d[l + 1];
+        double h = g - d[l];
+        for (std::size_t i = l + 2; i < n; ++i) {
+          d[i] -= h;
+        }
+        f += h;
+
+        // Chase the bulge from m back up to l.
+        p = d[m];
+        double c = 1.0;
+        double c2 = c;
+        double c3 = c;
+        const double el1 = e[l + 1];
+        double s = 0.0;
+        double s2 = 0.0;
+        for (std::size_t i = m; i-- > l;) {
+          c3 = c2;
+          c2 = c;
+          s2 = s;
+          g = c * e[i];
+          h = c * p;
+          r = hypotenuse(p, e[i]);
+          e[i + 1] = s * r;
+          s = e[i] / r;
+          c = p / r;
+          p = c * d[i] - s * g;
+          d[i + 1] = h + s * (c * g + s * d[i]);
+
+          double* row_i = rows + i * n;
+          double* row_next = rows + (i + 1) * n;
+          for (std::size_t k = 0; k < n; ++k) {
+            const double next = row_next[k];
+            row_next[k] = s * row_i[k] + c * next;
+            row_i[k] = c * row_i[k] - s * next;
+          }
+          ++report.rotations;
+        }
+        p = -s * s2 * c3 * el1 * e[l] / dl1;
+        e[l] = s * p;
+        d[l] = c * p;
+      } while (absolute(e[l]) > eps * norm);
+    }
+    d[l] += f;
+    e[l] = 0.0;
+  }
+  return converged;
+}
+
+}  // namespace
+
+void tridiagonal_ql_symmetric(double* matrix, double* eigenvectors, std::size_t order, std::size_t max_iterations,
+                              JacobiReport* report) {
+  if (matrix == nullptr || eigenvectors == nullptr || order == 0) {
+    return;
+  }
+  const std::size_t n = order;
+  JacobiReport local{};
+  if (n < 3) {
+    // A 2 x 2 is a single rotation; this also keeps the 3n doubles of scratch below within `matrix`.
+    jacobi_symmetric(matrix, eigenvectors, n, JacobiParams{}, report);
+    return;
+  }
+
+  std::vector<double> input;
+  if (report != nullptr) {
+    input.assign(matrix, matrix + n * n);
+  }
+
+  // The transform is built in `eigenvectors`; once the input is copied there, `matrix` (n^2 >= 3n
+  // doubles) holds the diagonal, the subdiagonal and the accumulation scratch.
+  for (std::size_t i = 0; i < n * n; ++i) {
+    eigenvectors[i] = matrix[i];
+  }
+  double* d = matrix;
+  double* e = matrix + n;
+  tridiagonalize(eigenvectors, n, d, e, matrix + 2 * n);
+  transpose_in_place(eigenvectors, n);
+  local.converged = ql_implicit(d, e, eigenvectors, n, max_iterations, local);
+  transpose_in_place(eigenvectors, n);
+
+  // Diagonal layout of jacobi_symmetric; walk backwards so no eigenvalue is overwritten before it is read.
+  for (std::size_t i = n; i-- > 0;) {
+    const double lambda = d[i];
+    for (std::size_t j = 0; j < n; ++j) {
+      matrix[i * n + j] = 0.0;
+    }
+    matrix[i * n + i] = lambda;
+  }
+
+  if (report != nullptr) {
+    local.off_norm = 0.0;
+    local.max_residual = max_eigen_residual(input.data(), matrix, eigenvectors, n);
+    *report = local;
+  }
+}
+
+void symmetric_eigen(double* matrix, double* eigenvectors, std::size_t order, const EigenParams& params,
+                     JacobiReport* report) {
+  const bool tridiagonal = params.solver == EigenSolver::kTridiagonalQl ||
+                           (params.solver == EigenSolver::kAuto && order >= kTridiagonalMinOrder);
+  if (tridiagonal) {
+    tridiagonal_ql_symmetric(matrix, eigenvectors, order, params.max_ql_iterations, report);
+  } else {
+    jacobi_symmetric(matrix, eigenvectors, order, params.jacobi, report);
+  }
+}
+
+}  // namespace ndvis::detail
@@ -0,0 +1,234 @@
+#include "ndvis/expmap.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace ndvis {
+
+namespace {
+
+constexpr int kPadeDegree = 6;
+// Scale A until its 1-norm is below this before the [6/6] approximant (Higham's theta_6 rounded down).
+constexpr double kPadeMaxNorm = 0.5;
+
+void multiply(const double* a, const double* b, double* out, std::size_t order) {
+  for (std::size_t row = 0; row < order; ++row) {
+    double* out_row = out + row * order;
+    for (std::size_t col = 0; col < order; ++col) {
+      out_row[col] = 0.0;
+    }
+    for (std::size_t k = 0; k < order; ++k) {
+      const double weight = a[row * order + k];
+      const double* b_row = b + k * order;
+      for (std::size_t col = 0; col < order; ++col) {
+        out_row[col] += weight * b_row[col];
+      }
+    }
+  }
+}
+
+// Solve lhs * X = rhs in place (rhs becomes X) with partially pivoted Gaussian elimination.
+bool solve_in_place(double* lhs, double* rhs, std::size_t order) {
+  for (std::size_t col = 0; col < order; ++col) {
+    std::size_t pivot = col;
+    for (std::size_t row = col + 1; row < order; ++row) {
+      if (std::fabs(lhs[row * order + col]) > std::fabs(lhs[pivot * order + col])) {
+        pivot = row;
+      }
+    }
+    if (lhs[pivot * order + col] == 0.0) {
+      return false;
+    }
+    if (pivot != col) {
+      for (std::size_t k = 0; k < order; ++k) {
+        std::swap(lhs[pivot * order + k], lhs[col * order + k]);
+        std::swap(rhs[pivot * order + k], rhs[col * order + k]);
+      }
+    }
+    const double inv_pivot = 1.0 / lhs[col * order + col];
+    for (std::size_t row = col + 1; row < order; ++row) {
+      const double factor = lhs[row * order + col] * inv_pivot;
+      if (factor == 0.0) {
+        continue;
+      }
+      for (std::size_t k = col; k < order; ++k) {
+        lhs[row * order + k] -= factor * lhs[col * order + k];
+      }
+      for (std::size_t k = 0; k < order; ++k) {
+        rhs[row * order + k] -= factor * rhs[col * order + k];
+      }
+    }
+  }
+  for (std::size_t step = order; step-- > 0;) {
+    const double inv_pivot = 1.0 / lhs[step * order + step];
+    for (std::size_t k = 0; k < order; ++k) {
+      double value = rhs[step * order + k];
+      for (std::size_t col = step + 1; col < order; ++col) {
+        value -= lhs[step * order + col] * rhs[col * order + k];
+      }
+      rhs[step * order + k] = value * inv_pivot;
+    }
+  }
+  return true;
+}
+
+// out = (I - A/2)^-1 (I + A/2). scratch: order * order doubles.
+bool cayley(const double* a, double* out, std::size_t order, double* scratch) {
+  double* denominator = scratch;
+  for (std::size_t idx = 0; idx < order * order; ++idx) {
+    denominator[idx] = -0.5 * a[idx];
+    out[idx] = 0.5 * a[idx];
+  }
+  for (std::size_t d = 0; d < order; ++d) {
+    denominator[d * order + d] += 1.0;
+    out[d * order + d] += 1.0;
+  }
+  return solve_in_place(denominator, out, order);
+}
+
+// out = exp(a) by scaling and squaring around a diagonal [6/6] Pade approximant. `a` is scaled in place.
+// scratch: 3 * order * order doubles.
+bool pade(double* a, double* out, std::size_t order, double* scratch) {
+  const std::size_t size = order * order;
+  double norm = 0.0;
+  for (std::size_t col = 0; col < order; ++col) {
+    double column_sum = 0.0;
+    for (std::size_t row = 0; row < order; ++row) {
+      column_sum += std::fabs(a[row * order + col]);
+    }
+    norm = std::max(norm, column_sum);
+  }
+  int squarings = 0;
+  if (norm > kPadeMaxNorm) {
+    squarings = static_cast<int>(std::ceil(std::log2(norm / kPadeMaxNorm)));
+  }
+  const double scale = std::ldexp(1.0, -squarings);
+
+  for (std::size_t idx = 0; idx < size; ++idx) {
+    a[idx] *= scale;
+  }
+
+  // N(A) = sum c_k A^k and D(A) = N(-A), with c_k = c_{k-1} (q - k + 1) / (k (2q - k + 1)).
+  double* power = scratch;
+  double* next = power + size;
+  double* denominator = next + size;
+  for (std::size_t idx = 0; idx < size; ++idx) {
+    power[idx] = 0.0;
+    denominator[idx] = 0.0;
+    out[idx] = 0.0;
+  }
+  for (std::size_t d = 0; d < order; ++d) {
+    power[d * order + d] = 1.0;
+    out[d * order + d] = 1.0;
+    denominator[d * order + d] = 1.0;
+  }
+  double coefficient = 1.0;
+  for (int k = 1; k <= kPadeDegree; ++k) {
+    coefficient *= static_cast<double>(kPadeDegree - k + 1) / static_cast<double>(k * (2 * kPadeDegree - k + 1));
+    multiply(power, a, next, order);
+    std::swap(power, next);
+    const double signed_coefficient = (k % 2 == 0) ? coefficient : -coefficient;
+    for (std::size_t idx = 0; idx < size; ++idx) {
+      out[idx] += coefficient * power[idx];
+      denominator[idx] += signed_coefficient * power[idx];
+    }
+  }
+  if (!solve_in_place(denominator, out, order)) {
+    return false;
+  }
+
+  for (int step = 0; step < squarings; ++step) {
+    multiply(out, out, next, order);
+    for (std::size_t idx = 0; idx < size; ++idx) {
+      out[idx] = next[idx];
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+void build_rotation_generator(const RotationPlane* velocities, std::size_t velocity_count, std::size_t order,
+                              float* out_generator) {
+  if (out_generator == nullptr || order == 0) {
+    return;
+  }
+  for (std::size_t idx = 0; idx < order * order; ++idx) {
+    out_generator[idx] = 0.0f;
+  }
+  if (velocities == nullptr) {
+    return;
+  }
+  for (std::size_t idx = 0; idx < velocity_count; ++idx) {
+    const RotationPlane plane = velocities[idx];
+    if (plane.i >= order || plane.j >= order || plane.i == plane.j) {
+      continue;
+    }
+    out_generator[plane.i * order + plane.j] += plane.theta;
+    out_generator[plane.j * order + plane.i] -= plane.theta;
+  }
+}
+
+std::size_t angular_velocity_workspace_size(std::size_t order, ExpMapMethod method) {
+  // Step A * dt, its exponential, one output row, and the solver scratch.
+  const std::size_t size = order * order;
+  return 2 * size + order + (method == ExpMapMethod::kCayley ? size : 3 * size);
+}
+
+bool apply_angular_velocity(float* matrix, std::size_t order, const float* generator, float dt,
+                            ExpMapMethod method, double* workspace, std::size_t workspace_length) {
+  if (matrix == nullptr || generator == nullptr || order == 0) {
+    return false;
+  }
+  if (workspace == nullptr || workspace_length < angular_velocity_workspace_size(order, method)) {
+    return false;
+  }
+
+  const std::size_t size = order * order;
+  double* step = workspace;
+  double* rotation = step + size;
+  double* row_out = rotation + size;
+  double* scratch = row_out + order;
+  for (std::size_t idx = 0; idx < size; ++idx) {
+    step[idx] = static_cast<double>(generator[idx]) * static_cast<double>(dt);
+  }
+
+  const bool solved = method == ExpMapMethod::kCayley ? cayley(step, rotation, order, scratch)
+                                                      : pade(step, rotation, order, scratch);
+  if (!solved) {
+    return false;
+  }
+
+  // R <- R * Q, one row at a time so the row can be overwritten in place.
+  for (std::size_t row = 0; row < order; ++row) {
+    float* row_ptr = matrix + row * order;
+    for (std::size_t col = 0; col < order; ++col) {
+      row_out[col] = 0.0;
+    }
+    for (std::size_t k = 0; k < order; ++k) {
+      const double weight = row_ptr[k];
+      const double* q_row = rotation + k * order;
+      for (std::size_t col = 0; col < order; ++col) {
+        row_out[col] += weight * q_row[col];
+      }
+    }
+    for (std::size_t col = 0; col < order; ++col) {
+      row_ptr[col] = static_cast<float>(row_out[col]);
+    }
+  }
+  return true;
+}
+
+bool apply_angular_velocity(float* matrix, std::size_t order, const float* generator, float dt,
+                            ExpMapMethod method) {
+  if (matrix == nullptr || generator == nullptr || order == 0) {
+    return false;
+  }
+  std::vector<double> workspace(angular_velocity_workspace_size(order, method));
+  return apply_angular_velocity(matrix, order, generator, dt, method, workspace.data(), workspace.size());
+}
+
+}  // namespace ndvis
@@ -20,6 +20,28 @@ constexpr std::size_t kMaxDimension = 31;  // 2^31 fits inside size_t on 64-bit
   return BufferView{view.data + axis * axis_length, axis_length};
 }
 
+// Checks the face buffers and writes the CSR offsets for faces of a fixed edge count.
+[[nodiscard]] bool prepare_faces(std::size_t face_count, std::size_t edges_per_face, IndexBufferView offsets,
+                                 IndexBufferView edges) {
+  if (offsets.data == nullptr || offsets.length < face_count + 1 || edges.data == nullptr ||
+      edges.length < face_count * edges_per_face) {
+    return false;
+  }
+  for (std::size_t face = 0; face <= face_count; ++face) {
+    offsets.data[face] = static_cast<index_type>(face * edges_per_face);
+  }
+  return true;
+}
+
+[[nodiscard]] FaceBuffers face_buffers(std::size_t face_count, std::size_t edges_per_face, IndexBufferView offsets,
+                                       IndexBufferView edges) {
+  return FaceBuffers{
+      face_count,
+      IndexBufferView{offsets.data, face_count + 1},
+      IndexBufferView{edges.data, face_count * edges_per_face},
+  };
+}
+
 inline void clear_axis(BufferView axis_view) {
   if (axis_view.data == nullptr) {
     return;
@@ -93,6 +115,43 @@ PolytopeBuffers generate_hypercube(int dimension, BufferView vertices, IndexBuff
   };
 }
 
+std::size_t hypercube_face_count(int dimension) {
+  if (!validate_dimension(dimension) || dimension < 2) {
+    return 0;
+  }
+  const std::size_t n = static_cast<std::size_t>(dimension);
+  return n * (n - 1) / 2 * checked_pow2(dimension - 2);
+}
+
+FaceBuffers generate_hypercube_faces(int dimension, IndexBufferView offsets, IndexBufferView edges) {
+  const std::size_t face_count = hypercube_face_count(dimension);
+  if (face_count == 0 || !prepare_faces(face_count, 4, offsets, edges)) {
+    return {};
+  }
+
+  // Face (i, j, v): the square spanned by axes i < j at the vertex v with both bits clear, walked
+  // v -> v+i -> v+i+j -> v+j.
+  const std::size_t n = static_cast<std::size_t>(dimension);
+  const std::size_t vertex_count = hypercube_vertex_count(dimension);
+  std::size_t cursor = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t j = i + 1; j < n; ++j) {
+      const std::size_t bit_i = static_cast<std::size_t>(1) << i;
+      const std::size_t bit_j = static_cast<std::size_t>(1) << j;
+      for (std::size_t v = 0; v < vertex_count; ++v) {
+        if ((v & (bit_i | bit_j)) != 0) {
+          continue;
+        }
+        edges.data[cursor++] = static_cast<index_type>(hypercube_edge_index(dimension, v, i));
+        edges.data[cursor++] = static_cast<index_type>(hypercube_edge_index(dimension, v | bit_i, j));
+        edges.data[cursor++] = static_cast<index_type>(hypercube_edge_index(dimension, v | bit_j, i));
+        edges.data[cursor++] = static_cast<index_type>(hypercube_edge_index(dimension, v, j));
+      }
+    }
+  }
+  return face_buffers(face_count, 4, offsets, edges);
+}
+
 std::size_t simplex_vertex_count(int dimension) {
   if (!validate_dimension(dimension)) {
     return 0;
@@ -149,6 +208,38 @@ PolytopeBuffers generate_simplex(int dimension, BufferView vertices, IndexBuffer
   };
 }
 
+std::size_t simplex_face_count(int dimension) {
+  const std::size_t vertex_count = simplex_vertex_count(dimension);
+  if (vertex_count < 3U) {
+    return 0;
+  }
+  return vertex_count * (vertex_count - 1U) * (vertex_count - 2U) / 6U;
+}
+
+FaceBuffers generate_simplex_faces(int dimension, IndexBufferView offsets, IndexBufferView edges) {
+  const std::size_t face_count = simplex_face_count(dimension);
+  if (face_count == 0 || !prepare_faces(face_count, 3, offsets, edges)) {
+    return {};
+  }
+
+  // Edge (a, b), a < b, in generate_simplex order.
+  const std::size_t vertex_count = simplex_vertex_count(dimension);
+  auto edge_index = [vertex_count](std::size_t a, std::size_t b) {
+    return static_cast<index_type>(a * vertex_count - a * (a + 1U) / 2U + (b - a - 1U));
+  };
+  std::size_t cursor = 0;
+  for (std::size_t a = 0; a < vertex_count; ++a) {
+    for (std::size_t b = a + 1U; b < vertex_count; ++b) {
+      for (std::size_t c = b + 1U; c < vertex_count; ++c) {
+        edges.data[cursor++] = edge_index(a, b);
+        edges.data[cursor++] = edge_index(b, c);
+        edges.data[cursor++] = edge_index(a, c);
+      }
+    }
+  }
+  return face_buffers(face_count, 3, offsets, edges);
+}
+
 std::size_t orthoplex_vertex_count(int dimension) {
   if (!validate_dimension(dimension)) {
     return 0;
@@ -216,4 +307,55 @@ PolytopeBuffers generate_orthoplex(int dimension, BufferView vertices, IndexBuff
   };
 }
 
+std::size_t orthoplex_face_count(int dimension) {
+  if (!validate_dimension(dimension) || dimension < 2) {
+    return 0;
+  }
+  if (dimension == 2) {
+    return 1;  // the square itself
+  }
+  const std::size_t n = static_cast<std::size_t>(dimension);
+  return n * (n - 1U) * (n - 2U) / 6U * 8U;
+}
+
+FaceBuffers generate_orthoplex_faces(int dimension, IndexBufferView offsets, IndexBufferView edges) {
+  const std::size_t face_count = orthoplex_face_count(dimension);
+  const std::size_t edges_per_face = dimension == 2 ? 4U : 3U;
+  if (face_count == 0 || !prepare_faces(face_count, edges_per_face, offsets, edges)) {
+    return {};
+  }
+
+  // Edge between vertex (axis_a, sign_a) and (axis_b, sign_b), axis_a < axis_b, in generate_orthoplex order.
+  const std::size_t n = static_cast<std::size_t>(dimension);
+  auto edge_index = [n](std::size_t axis_a, std::size_t sign_a, std::size_t axis_b, std::size_t sign_b) {
+    const std::size_t before = 4U * (axis_a * (n - 1U) - axis_a * (axis_a - 1U) / 2U);  // 0 for axis_a = 0
+    return static_cast<index_type>(before + sign_a * 2U * (n - 1U - axis_a) + 2U * (axis_b - axis_a - 1U) + sign_b);
+  };
+  if (dimension == 2) {
+    // +x -> +y -> -x -> -y
+    edges.data[0] = edge_index(0, 0, 1, 0);
+    edges.data[1] = edge_index(0, 1, 1, 0);
+    edges.data[2] = edge_index(0, 1, 1, 1);
+    edges.data[3] = edge_index(0, 0, 1, 1);
+    return face_buffers(face_count, edges_per_face, offsets, edges);
+  }
+
+  std::size_t cursor = 0;
+  for (std::size_t a = 0; a < n; ++a) {
+    for (std::size_t b = a + 1U; b < n; ++b) {
+      for (std::size_t c = b + 1U; c < n; ++c) {
+        for (std::size_t signs = 0; signs < 8U; ++signs) {
+          const std::size_t sa = signs & 1U;
+          const std::size_t sb = (signs >> 1) & 1U;
+          const std::size_t sc = (signs >> 2) & 1U;
+          edges.data[cursor++] = edge_index(a, sa, b, sb);
+          edges.data[cursor++] = edge_index(b, sb, c, sc);
+          edges.data[cursor++] = edge_index(a, sa, c, sc);
+        }
+      }
+    }
+  }
+  return face_buffers(face_count, edges_per_face, offsets, edges);
+}
+
 }  // namespace ndvis
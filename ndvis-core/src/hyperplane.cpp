@@ -2,13 +2,29 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <vector>
 
+#include "ndvis/detail/hypercube_distances.hpp"
+#include "ndvis/detail/projection_kernels.hpp"
+#include "ndvis/detail/slice_rules.hpp"
+#include "ndvis/detail/thread_pool.hpp"
+
 namespace ndvis {
 
 namespace {
 
-constexpr float kEpsilon = 1e-5f;
+using detail::classify_distance;
+using detail::crossing_parameter;
+using detail::edge_crosses;
+
+// Below these sizes per chunk, classification and slicing stay on the calling thread.
+constexpr std::size_t kParallelMinVertices = 16384;
+constexpr std::size_t kParallelMinEdges = 8192;
+// Upper bound on slice_polytope's edge chunks, so the per-chunk offsets live on the stack.
+constexpr std::size_t kMaxSliceChunks = 64;
+// Vertices classified per tile: distances land in a stack buffer before they are classified.
+constexpr std::size_t kClassifyTile = 1024;
 
 // Compute dot product of two n-dimensional vectors
 float dot_product(const float* a, const float* b, std::size_t dimension) {
@@ -19,24 +35,6 @@ float dot_product(const float* a, const float* b, std::size_t dimension) {
   return result;
 }
 
-// Extract a vertex from SoA layout
-void extract_vertex(const float* soa_data, std::size_t vertex_index,
-                    std::size_t vertex_count, std::size_t dimension,
-                    float* out_vertex) {
-  for (std::size_t d = 0; d < dimension; ++d) {
-    out_vertex[d] = soa_data[d * vertex_count + vertex_index];
-  }
-}
-
-// Store a vertex in SoA layout
-void store_vertex(float* soa_data, std::size_t vertex_index,
-                  std::size_t vertex_count, std::size_t dimension,
-                  const float* vertex) {
-  for (std::size_t d = 0; d < dimension; ++d) {
-    soa_data[d * vertex_count + vertex_index] = vertex[d];
-  }
-}
-
 }  // namespace
 
 float point_to_hyperplane_distance(const float* point,
@@ -45,118 +43,318 @@ float point_to_hyperplane_distance(const float* point,
   return dot - hyperplane.offset;
 }
 
+void compute_signed_distances(ConstBufferView vertices, std::size_t vertex_count, std::size_t dimension,
+                              const Hyperplane& hyperplane, float* out_distances) {
+  if (vertices.data == nullptr || hyperplane.normal == nullptr || out_distances == nullptr) {
+    return;
+  }
+  const detail::DistanceKernel kernel = detail::active_distance_kernel();
+  detail::parallel_for(vertex_count, kParallelMinVertices, [&](std::size_t begin, std::size_t end) {
+    kernel(vertices.data, vertex_count, dimension, hyperplane.normal, hyperplane.offset, out_distances, begin, end);
+  });
+}
+
+void classify_distances(const float* distances, std::size_t count, int* out_classifications) {
+  for (std::size_t v = 0; v < count; ++v) {
+    out_classifications[v] = classify_distance(distances[v]);
+  }
+}
+
 void classify_vertices(ConstBufferView vertices, std::size_t vertex_count,
                        std::size_t dimension, const Hyperplane& hyperplane,
                        int* out_classifications) {
-  std::vector<float> vertex(dimension);
-
-  for (std::size_t v = 0; v < vertex_count; ++v) {
-    extract_vertex(vertices.data, v, vertex_count, dimension, vertex.data());
-
-    const float distance = point_to_hyperplane_distance(vertex.data(), hyperplane);
-
-    if (std::abs(distance) < kEpsilon) {
-      out_classifications[v] = 0;  // On hyperplane
-    } else if (distance > 0.0f) {
-      out_classifications[v] = 1;  // Front (positive side)
-    } else {
-      out_classifications[v] = -1;  // Back (negative side)
+  const detail::DistanceKernel kernel = detail::active_distance_kernel();
+  detail::parallel_for(vertex_count, kParallelMinVertices, [&](std::size_t begin, std::size_t end) {
+    float distances[kClassifyTile];
+    for (std::size_t base = begin; base < end; base += kClassifyTile) {
+      const std::size_t tile = std::min(kClassifyTile, end - base);
+      // Offsetting the base pointer keeps the column stride and lands the tile at distances[0].
+      kernel(vertices.data + base, vertex_count, dimension, hyperplane.normal, hyperplane.offset, distances, 0, tile);
+      classify_distances(distances, tile, out_classifications + base);
     }
-  }
+  });
+}
+
+std::size_t slice_workspace_size(std::size_t vertex_count) {
+  return vertex_count;
 }
 
 SliceResult slice_polytope(ConstBufferView vertices, std::size_t vertex_count,
                            std::size_t dimension, ConstIndexBufferView edges,
                            const Hyperplane& hyperplane, BufferView out_points,
                            IndexBufferView out_edge_indices) {
+  std::vector<float> workspace(slice_workspace_size(vertex_count));
+  return slice_polytope(vertices, vertex_count, dimension, edges, hyperplane, out_points, out_edge_indices,
+                        workspace.data(), workspace.size());
+}
+
+SliceResult slice_polytope(ConstBufferView vertices, std::size_t vertex_count, std::size_t dimension,
+                           ConstIndexBufferView edges, const Hyperplane& hyperplane, BufferView out_points,
+                           IndexBufferView out_edge_indices, float* workspace, std::size_t workspace_length) {
   SliceResult result{};
+  if (vertices.data == nullptr || edges.data == nullptr || out_points.data == nullptr || dimension == 0) {
+    return result;
+  }
+  if (workspace == nullptr || workspace_length < slice_workspace_size(vertex_count)) {
+    return result;
+  }
+
+  compute_signed_distances(vertices, vertex_count, dimension, hyperplane, workspace);
+  return slice_polytope_with_distances(vertices, vertex_count, dimension, edges, workspace, out_points,
+                                       out_edge_indices);
+}
 
-  // Classify all vertices
-  std::vector<int> classifications(vertex_count);
-  classify_vertices(vertices, vertex_count, dimension, hyperplane,
-                    classifications.data());
+SliceResult slice_polytope_with_distances(ConstBufferView vertices, std::size_t vertex_count,
+                                          std::size_t dimension, ConstIndexBufferView edges, const float* distances,
+                                          BufferView out_points, IndexBufferView out_edge_indices) {
+  SliceResult result{};
+  if (vertices.data == nullptr || edges.data == nullptr || distances == nullptr || out_points.data == nullptr ||
+      dimension == 0) {
+    return result;
+  }
 
   const std::size_t edge_count = edges.length / 2;
-  const std::size_t max_intersections = out_points.length / dimension;
+  std::size_t capacity = out_points.length / dimension;
+  if (out_edge_indices.data && out_edge_indices.length < capacity) {
+    capacity = out_edge_indices.length;  // Edge index buffer full
+  }
+  auto crosses = [&](std::size_t e) {
+    return edge_crosses(classify_distance(distances[edges.data[2 * e]]),
+                        classify_distance(distances[edges.data[2 * e + 1]]));
+  };
+
+  // Pass 1 counts crossings per contiguous edge chunk; the prefix sum gives each chunk its first output
+  // slot, so the output matches a serial scan for any thread count.
+  std::size_t chunk_count = detail::parallel_chunk_count(edge_count, kParallelMinEdges);
+  chunk_count = chunk_count < kMaxSliceChunks ? chunk_count : kMaxSliceChunks;
+  std::size_t chunk_offsets[kMaxSliceChunks + 1] = {};
+  detail::parallel_for_chunks(edge_count, chunk_count, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+    std::size_t hits = 0;
+    for (std::size_t e = begin; e < end; ++e) {
+      hits += crosses(e) ? 1 : 0;
+    }
+    chunk_offsets[chunk + 1] = hits;
+  });
+  for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+    chunk_offsets[chunk + 1] += chunk_offsets[chunk];
+  }
+  const std::size_t intersection_count = std::min(chunk_offsets[chunk_count], capacity);
 
-  // Temporary storage for intersections before repacking
-  std::vector<std::vector<float>> temp_intersections;
-  temp_intersections.reserve(max_intersections);
+  // Pass 2: interpolate straight into the SoA output
+  // SoA: [x0, x1, x2, ..., x_n-1, y0, y1, y2, ..., y_n-1, z0, z1, z2, ..., z_n-1]
+  detail::parallel_for_chunks(edge_count, chunk_count, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+    std::size_t slot = chunk_offsets[chunk];
+    for (std::size_t e = begin; e < end && slot < intersection_count; ++e) {
+      if (!crosses(e)) {
+        continue;
+      }
+      const index_type v0_idx = edges.data[2 * e];
+      const index_type v1_idx = edges.data[2 * e + 1];
+      const float t = crossing_parameter(distances[v0_idx], distances[v1_idx]);
+      for (std::size_t d = 0; d < dimension; ++d) {
+        const float a = vertices.data[d * vertex_count + v0_idx];
+        const float b = vertices.data[d * vertex_count + v1_idx];
+        out_points.data[d * intersection_count + slot] = a + t * (b - a);
+      }
+      if (out_edge_indices.data) {
+        out_edge_indices.data[slot] = static_cast<index_type>(e);
+      }
+      ++slot;
+    }
+  });
+
+  result.intersection_count = intersection_count;
+  result.intersection_points = BufferView{
+      out_points.data, dimension * intersection_count};
+  result.intersection_edges = IndexBufferView{
+      out_edge_indices.data, intersection_count};
 
-  std::vector<float> v0(dimension);
-  std::vector<float> v1(dimension);
+  return result;
+}
 
-  for (std::size_t e = 0; e < edge_count; ++e) {
-    const index_type v0_idx = edges.data[2 * e];
-    const index_type v1_idx = edges.data[2 * e + 1];
+std::size_t slice_polytope_batch(ConstBufferView vertices, std::size_t vertex_count, std::size_t dimension,
+                                 ConstIndexBufferView edges, const float* normal, const float* offsets,
+                                 std::size_t offset_count, BufferView out_points, IndexBufferView out_edge_indices,
+                                 std::size_t* out_slice_starts) {
+  if (out_slice_starts == nullptr) {
+    return 0;
+  }
+  std::fill(out_slice_starts, out_slice_starts + offset_count + 1, std::size_t{0});
+  if (vertices.data == nullptr || edges.data == nullptr || normal == nullptr || offsets == nullptr ||
+      out_points.data == nullptr || dimension == 0 || offset_count == 0) {
+    return 0;
+  }
+  for (std::size_t k = 0; k < offset_count; ++k) {
+    if (!std::isfinite(offsets[k])) {
+      return 0;
+    }
+  }
 
-    const int class0 = classifications[v0_idx];
-    const int class1 = classifications[v1_idx];
+  // normal . v once; every slice subtracts its own offset from the same bits slice_polytope would use.
+  std::vector<float> dots(vertex_count);
+  compute_signed_distances(vertices, vertex_count, dimension, Hyperplane{normal, dimension, 0.0f}, dots.data());
 
-    // Edge intersects hyperplane if endpoints are on opposite sides
-    // (or one is exactly on the hyperplane)
-    if (class0 * class1 < 0 || (class0 == 0 && class1 != 0) ||
-        (class0 != 0 && class1 == 0)) {
+  // Offsets sorted once, so each edge jumps straight to the range its endpoints span.
+  std::vector<std::size_t> order(offset_count);
+  for (std::size_t k = 0; k < offset_count; ++k) {
+    order[k] = k;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [offsets](std::size_t a, std::size_t b) { return offsets[a] < offsets[b]; });
+  std::vector<float> sorted(offset_count);
+  for (std::size_t j = 0; j < offset_count; ++j) {
+    sorted[j] = offsets[order[j]];
+  }
 
-      // Check capacity before computing
-      if (temp_intersections.size() >= max_intersections) {
-        break;  // Output buffer full
+  const std::size_t edge_count = edges.length / 2;
+  // Calls fn(k, d0, d1) for every slice k edge e crosses, in ascending offset.
+  auto for_each_crossing = [&](std::size_t e, auto&& fn) {
+    const float dot0 = dots[edges.data[2 * e]];
+    const float dot1 = dots[edges.data[2 * e + 1]];
+    const float lo = dot0 < dot1 ? dot0 : dot1;
+    const float hi = dot0 < dot1 ? dot1 : dot0;
+    auto j = static_cast<std::size_t>(
+        std::lower_bound(sorted.begin(), sorted.end(), lo - detail::crossing_slack(lo)) - sorted.begin());
+    const float last = hi + detail::crossing_slack(hi);
+    for (; j < offset_count && sorted[j] <= last; ++j) {
+      const float d0 = dot0 - sorted[j];
+      const float d1 = dot1 - sorted[j];
+      if (edge_crosses(classify_distance(d0), classify_distance(d1))) {
+        fn(order[j], d0, d1);
       }
+    }
+  };
+
+  // Pass 1 counts hits per (chunk, slice); pass 2 fills. Each pass reads every edge once for all slices.
+  std::size_t chunk_count = detail::parallel_chunk_count(edge_count, kParallelMinEdges);
+  chunk_count = chunk_count < kMaxSliceChunks ? chunk_count : kMaxSliceChunks;
+  std::vector<std::size_t> cursors(chunk_count * offset_count, 0);
+  detail::parallel_for_chunks(edge_count, chunk_count, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+    std::size_t* counts = cursors.data() + chunk * offset_count;
+    for (std::size_t e = begin; e < end; ++e) {
+      for_each_crossing(e, [counts](std::size_t k, float, float) { ++counts[k]; });
+    }
+  });
 
-      if (out_edge_indices.data && temp_intersections.size() >= out_edge_indices.length) {
-        break;  // Edge index buffer full
-      }
+  // Slice k starts where slice k - 1 ends, clamped to capacity; within a slice chunks follow in edge
+  // order, so each slice matches slice_polytope at its offset.
+  std::size_t capacity = out_points.length / dimension;
+  if (out_edge_indices.data && out_edge_indices.length < capacity) {
+    capacity = out_edge_indices.length;
+  }
+  std::vector<std::size_t> slice_counts(offset_count);
+  std::size_t total = 0;
+  for (std::size_t k = 0; k < offset_count; ++k) {
+    std::size_t hits = 0;
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+      std::size_t& cursor = cursors[chunk * offset_count + k];
+      const std::size_t chunk_hits = cursor;
+      cursor = hits;
+      hits += chunk_hits;
+    }
+    const std::size_t room = capacity - total;
+    slice_counts[k] = hits < room ? hits : room;
+    out_slice_starts[k] = total;
+    total += slice_counts[k];
+  }
+  out_slice_starts[offset_count] = total;
+
+  detail::parallel_for_chunks(edge_count, chunk_count, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+    std::size_t* slots = cursors.data() + chunk * offset_count;
+    for (std::size_t e = begin; e < end; ++e) {
+      for_each_crossing(e, [&](std::size_t k, float d0, float d1) {
+        const std::size_t slot = slots[k]++;
+        const std::size_t count = slice_counts[k];
+        if (slot >= count) {
+          return;
+        }
+        const index_type v0_idx = edges.data[2 * e];
+        const index_type v1_idx = edges.data[2 * e + 1];
+        const float t = crossing_parameter(d0, d1);
+        // Slice k: SoA with stride count, starting at dimension * out_slice_starts[k]
+        float* block = out_points.data + dimension * out_slice_starts[k];
+        for (std::size_t d = 0; d < dimension; ++d) {
+          const float a = vertices.data[d * vertex_count + v0_idx];
+          const float b = vertices.data[d * vertex_count + v1_idx];
+          block[d * count + slot] = a + t * (b - a);
+        }
+        if (out_edge_indices.data) {
+          out_edge_indices.data[out_slice_starts[k] + slot] = static_cast<index_type>(e);
+        }
+      });
+    }
+  });
 
-      extract_vertex(vertices.data, v0_idx, vertex_count, dimension, v0.data());
-      extract_vertex(vertices.data, v1_idx, vertex_count, dimension, v1.data());
-
-      const float d0 = point_to_hyperplane_distance(v0.data(), hyperplane);
-      const float d1 = point_to_hyperplane_distance(v1.data(), hyperplane);
-
-      // Compute interpolation parameter t
-      // intersection = v0 + t * (v1 - v0)
-      // We want: dot(normal, intersection) = offset
-      float t = 0.0f;
-      if (std::abs(d0 - d1) > kEpsilon) {
-        t = d0 / (d0 - d1);
-      } else if (std::abs(d0) < kEpsilon) {
-        t = 0.0f;
-      } else {
-        t = 1.0f;
-      }
+  return total;
+}
 
-      // Clamp t to [0, 1]
-      t = std::max(0.0f, std::min(1.0f, t));
+SliceResult slice_hypercube(const ImplicitHypercube& cube, const Hyperplane& hyperplane, BufferView out_points,
+                            IndexBufferView out_edge_indices) {
+  SliceResult result{};
+  const std::size_t edge_count = hypercube_edge_count(cube.dimension);
+  const std::size_t dimension = static_cast<std::size_t>(cube.dimension);
+  if (edge_count == 0 || hyperplane.normal == nullptr || hyperplane.dimension != dimension ||
+      out_points.data == nullptr) {
+    return result;
+  }
+  if (edge_count > std::numeric_limits<index_type>::max()) {
+    return result;
+  }
 
-      // Compute and store intersection point
-      std::vector<float> intersection(dimension);
-      for (std::size_t d = 0; d < dimension; ++d) {
-        intersection[d] = v0[d] + t * (v1[d] - v0[d]);
-      }
-      temp_intersections.push_back(std::move(intersection));
+  const detail::HypercubeDistances distance(cube.dimension, hyperplane);
+  std::size_t capacity = out_points.length / dimension;
+  if (out_edge_indices.data && out_edge_indices.length < capacity) {
+    capacity = out_edge_indices.length;
+  }
 
-      // Store edge index
-      if (out_edge_indices.data) {
-        out_edge_indices.data[temp_intersections.size() - 1] = static_cast<index_type>(e);
+  // Pass 1 only counts crossings per chunk; with no edge list to keep, pass 2 re-derives the
+  // distances rather than storing per-edge hits for billions of edges.
+  const std::size_t chunk_count = detail::parallel_chunk_count(edge_count, kParallelMinEdges);
+  std::vector<std::size_t> chunk_offsets(chunk_count + 1, 0);
+  detail::parallel_for_chunks(edge_count, chunk_count, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+    std::size_t hits = 0;
+    for (std::size_t e = begin; e < end; ++e) {
+      std::size_t v0 = 0;
+      std::size_t v1 = 0;
+      hypercube_edge_vertices(cube.dimension, e, &v0, &v1);
+      if (edge_crosses(classify_distance(distance(v0)), classify_distance(distance(v1)))) {
+        ++hits;
       }
     }
+    chunk_offsets[chunk + 1] = hits;
+  });
+  for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+    chunk_offsets[chunk + 1] += chunk_offsets[chunk];
   }
-
-  // Repack intersections into contiguous SoA layout
-  // SoA: [x0, x1, x2, ..., x_n-1, y0, y1, y2, ..., y_n-1, z0, z1, z2, ..., z_n-1]
-  const std::size_t intersection_count = temp_intersections.size();
-  for (std::size_t d = 0; d < dimension; ++d) {
-    for (std::size_t i = 0; i < intersection_count; ++i) {
-      out_points.data[d * intersection_count + i] = temp_intersections[i][d];
+  const std::size_t intersection_count = std::min(chunk_offsets[chunk_count], capacity);
+
+  detail::parallel_for_chunks(edge_count, chunk_count, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+    std::size_t slot = chunk_offsets[chunk];
+    for (std::size_t e = begin; e < end && slot < intersection_count; ++e) {
+      std::size_t v0 = 0;
+      std::size_t v1 = 0;
+      hypercube_edge_vertices(cube.dimension, e, &v0, &v1);
+      const float d0 = distance(v0);
+      const float d1 = distance(v1);
+      if (!edge_crosses(classify_distance(d0), classify_distance(d1))) {
+        continue;
+      }
+      const float t = crossing_parameter(d0, d1);
+      for (std::size_t d = 0; d < dimension; ++d) {
+        const float a = hypercube_vertex_coordinate(v0, d);
+        const float b = hypercube_vertex_coordinate(v1, d);
+        out_points.data[d * intersection_count + slot] = a + t * (b - a);
+      }
+      if (out_edge_indices.data) {
+        out_edge_indices.data[slot] = static_cast<index_type>(e);
+      }
+      ++slot;
     }
-  }
+  });
 
   result.intersection_count = intersection_count;
-  result.intersection_points = BufferView{
-      out_points.data, dimension * intersection_count};
-  result.intersection_edges = IndexBufferView{
-      out_edge_indices.data, intersection_count};
-
+  result.intersection_points = BufferView{out_points.data, dimension * intersection_count};
+  result.intersection_edges = IndexBufferView{out_edge_indices.data, intersection_count};
   return result;
 }
 
@@ -1,5 +1,7 @@
 #include "ndvis/detail/jacobi.hpp"
 
+#include <vector>
+
 namespace ndvis::detail {
 
 namespace {
@@ -16,70 +18,137 @@ void set_identity(double* matrix, std::size_t order) {
   }
 }
 
+// Frobenius norm of the strictly off-diagonal part of a symmetric matrix
+double off_diagonal_norm(const double* matrix, std::size_t order) {
+  double sum = 0.0;
+  for (std::size_t i = 0; i < order; ++i) {
+    for (std::size_t j = i + 1; j < order; ++j) {
+      const double value = matrix[i * order + j];
+      sum += value * value;
+    }
+  }
+  return __builtin_sqrt(2.0 * sum);
+}
+
+double frobenius_norm(const double* matrix, std::size_t order) {
+  double sum = 0.0;
+  for (std::size_t i = 0; i < order * order; ++i) {
+    sum += matrix[i] * matrix[i];
+  }
+  return __builtin_sqrt(sum);
+}
+
+// Zero matrix[p][q] with the rotation in the (p, q) plane and accumulate it into the eigenvectors.
+void rotate_pivot(double* matrix, double* eigenvectors, std::size_t order, std::size_t p, std::size_t q) {
+  const double app = matrix[p * order + p];
+  const double aqq = matrix[q * order + q];
+  const double apq = matrix[p * order + q];
+
+  const double tau = (aqq - app) / (2.0 * apq);
+  const double t = (tau >= 0.0 ? 1.0 : -1.0) / (absolute(tau) + __builtin_sqrt(1.0 + tau * tau));
+  const double c = 1.0 / __builtin_sqrt(1.0 + t * t);
+  const double s = t * c;
+
+  matrix[p * order + p] = app - t * apq;
+  matrix[q * order + q] = aqq + t * apq;
+  matrix[p * order + q] = 0.0;
+  matrix[q * order + p] = 0.0;
+
+  for (std::size_t k = 0; k < order; ++k) {
+    if (k == p || k == q) {
+      continue;
+    }
+    const double aip = matrix[p * order + k];
+    const double aiq = matrix[q * order + k];
+    matrix[p * order + k] = c * aip - s * aiq;
+    matrix[k * order + p] = matrix[p * order + k];
+    matrix[q * order + k] = s * aip + c * aiq;
+    matrix[k * order + q] = matrix[q * order + k];
+  }
+
+  for (std::size_t k = 0; k < order; ++k) {
+    const double vip = eigenvectors[k * order + p];
+    const double viq = eigenvectors[k * order + q];
+    eigenvectors[k * order + p] = c * vip - s * viq;
+    eigenvectors[k * order + q] = s * vip + c * viq;
+  }
+}
+
 }  // namespace
 
-void jacobi_symmetric(double* matrix, double* eigenvectors, std::size_t order, const JacobiParams& params) {
+void jacobi_symmetric(double* matrix, double* eigenvectors, std::size_t order, const JacobiParams& params,
+                      JacobiReport* report) {
   if (matrix == nullptr || eigenvectors == nullptr || order == 0) {
     return;
   }
 
   set_identity(eigenvectors, order);
+  JacobiReport local{};
   if (order <= 1) {
+    local.converged = true;
+    if (report != nullptr) {
+      *report = local;
+    }
     return;
   }
 
-  for (std::size_t sweep = 0; sweep < params.max_sweeps; ++sweep) {
-    double max_off = 0.0;
-    std::size_t p = 0;
-    std::size_t q = 1;
-    for (std::size_t i = 0; i < order; ++i) {
-      for (std::size_t j = i + 1; j < order; ++j) {
-        double value = absolute(matrix[i * order + j]);
-        if (value > max_off) {
-          max_off = value;
-          p = i;
-          q = j;
+  std::vector<double> input;
+  if (report != nullptr) {
+    input.assign(matrix, matrix + order * order);
+  }
+
+  const double target = params.tolerance * frobenius_norm(matrix, order);
+  double off = off_diagonal_norm(matrix, order);
+  while (off > target && local.sweeps < params.max_sweeps) {
+    // The first sweeps only rotate pivots well above the average off-diagonal magnitude; later sweeps
+    // take every nonzero pivot and flush those already negligible against both diagonal entries.
+    const double threshold = local.sweeps < 3 ? 0.2 * off / static_cast<double>(order * order) : 0.0;
+    for (std::size_t p = 0; p + 1 < order; ++p) {
+      for (std::size_t q = p + 1; q < order; ++q) {
+        const double apq = absolute(matrix[p * order + q]);
+        if (local.sweeps > 3 && absolute(matrix[p * order + p]) + 100.0 * apq == absolute(matrix[p * order + p]) &&
+            absolute(matrix[q * order + q]) + 100.0 * apq == absolute(matrix[q * order + q])) {
+          matrix[p * order + q] = 0.0;
+          matrix[q * order + p] = 0.0;
+          continue;
         }
+        if (apq <= threshold || apq == 0.0) {
+          continue;
+        }
+        rotate_pivot(matrix, eigenvectors, order, p, q);
+        ++local.rotations;
       }
     }
+    ++local.sweeps;
+    off = off_diagonal_norm(matrix, order);
+  }
 
-    if (max_off < params.tolerance) {
-      break;
-    }
-
-    const double app = matrix[p * order + p];
-    const double aqq = matrix[q * order + q];
-    const double apq = matrix[p * order + q];
-
-    const double tau = (aqq - app) / (2.0 * apq);
-    const double t = (tau >= 0.0 ? 1.0 : -1.0) / (absolute(tau) + __builtin_sqrt(1.0 + tau * tau));
-    const double c = 1.0 / __builtin_sqrt(1.0 + t * t);
-    const double s = t * c;
-
-    matrix[p * order + p] = app - t * apq;
-    matrix[q * order + q] = aqq + t * apq;
-    matrix[p * order + q] = 0.0;
-    matrix[q * order + p] = 0.0;
+  if (report != nullptr) {
+    local.off_norm = off;
+    local.converged = off <= target;
+    local.max_residual = max_eigen_residual(input.data(), matrix, eigenvectors, order);
+    *report = local;
+  }
+}
 
-    for (std::size_t k = 0; k < order; ++k) {
-      if (k == p || k == q) {
-        continue;
+double max_eigen_residual(const double* input, const double* diagonalized, const double* eigenvectors,
+                          std::size_t order) {
+  double worst = 0.0;
+  for (std::size_t k = 0; k < order; ++k) {
+    const double lambda = diagonalized[k * order + k];
+    double sum = 0.0;
+    for (std::size_t row = 0; row < order; ++row) {
+      double av = 0.0;
+      for (std::size_t col = 0; col < order; ++col) {
+        av += input[row * order + col] * eigenvectors[col * order + k];
       }
-      const double aip = matrix[p * order + k];
-      const double aiq = matrix[q * order + k];
-      matrix[p * order + k] = c * aip - s * aiq;
-      matrix[k * order + p] = matrix[p * order + k];
-      matrix[q * order + k] = s * aip + c * aiq;
-      matrix[k * order + q] = matrix[q * order + k];
-    }
-
-    for (std::size_t k = 0; k < order; ++k) {
-      const double vip = eigenvectors[k * order + p];
-      const double viq = eigenvectors[k * order + q];
-      eigenvectors[k * order + p] = c * vip - s * viq;
-      eigenvectors[k * order + q] = s * vip + c * viq;
+      const double diff = av - lambda * eigenvectors[row * order + k];
+      sum += diff * diff;
     }
+    const double residual = __builtin_sqrt(sum);
+    worst = residual > worst ? residual : worst;
   }
+  return worst;
 }
 
 void sort_eigenpairs(double* eigenvalues, double* eigenvectors, std::size_t order) {
@@ -8,12 +8,18 @@
 #include <vector>
 
 #include "ndcalc/api.h"
+#include "ndvis/detail/hypercube_distances.hpp"
+#include "ndvis/detail/slice_rules.hpp"
+#include "ndvis/detail/thread_pool.hpp"
 #include "ndvis/hyperplane.hpp"
+#include "ndvis/projection.hpp"
 
 namespace ndvis {
 namespace {
 
 constexpr float kIntersectionEpsilon = 1e-6f;
+// Below this many edges per chunk, the slice overlay stays on the calling thread.
+constexpr std::size_t kParallelMinEdges = 8192;
 constexpr float kGradientEpsilon = 1e-6f;
 constexpr float kTangentExtent = 0.5f;
 
@@ -35,43 +41,135 @@ struct ProgramGuard {
   }
 };
 
-void project_point(const GeometryInputs& geometry, const float* point, float* out3) {
-  const std::size_t dimension = geometry.dimension;
-  std::vector<float> rotated(dimension, 0.0f);
+// Fused 3 x n operator (basis3^T * R) built once per compute_overlays call.
+struct OverlayProjection {
+  std::vector<float> matrix;
+  std::size_t dimension{0};
+};
 
-  for (std::size_t row = 0; row < dimension; ++row) {
-    float sum = 0.0f;
-    const float* row_ptr = geometry.rotation_matrix + row * dimension;
-    for (std::size_t col = 0; col < dimension; ++col) {
-      sum += row_ptr[col] * point[col];
-    }
-    rotated[row] = sum;
+OverlayProjection make_projection(const GeometryInputs& geometry) {
+  OverlayProjection projection;
+  projection.dimension = geometry.dimension;
+  projection.matrix.assign(kProjectionRows * geometry.dimension, 0.0f);
+  build_projection_operator(
+      geometry.rotation_matrix,
+      geometry.dimension,
+      ConstBasis3{geometry.basis3, geometry.dimension, geometry.dimension},
+      projection.matrix.data());
+  return projection;
+}
+
+// Vertex and edge access that decodes implicit hypercubes instead of reading the geometry buffers.
+class GeometryAccess {
+ public:
+  explicit GeometryAccess(const GeometryInputs& geometry)
+      : geometry_(geometry), implicit_(geometry.implicit_hypercube.dimension > 0) {}
+
+  bool implicit() const { return implicit_; }
+
+  std::size_t vertex_count() const {
+    return implicit_ ? hypercube_vertex_count(geometry_.implicit_hypercube.dimension) : geometry_.vertex_count;
+  }
+
+  std::size_t edge_count() const {
+    return implicit_ ? hypercube_edge_count(geometry_.implicit_hypercube.dimension) : geometry_.edge_count;
+  }
+
+  float coordinate(std::size_t vertex, std::size_t axis) const {
+    return implicit_ ? hypercube_vertex_coordinate(vertex, axis)
+                     : geometry_.vertices[axis * geometry_.vertex_count + vertex];
   }
 
-  for (std::size_t component = 0; component < 3; ++component) {
-    float sum = 0.0f;
-    const float* basis_col = geometry.basis3 + component * dimension;
-    for (std::size_t axis = 0; axis < dimension; ++axis) {
-      sum += rotated[axis] * basis_col[axis];
+  void edge(std::size_t edge, std::size_t* out_v0, std::size_t* out_v1) const {
+    if (implicit_) {
+      hypercube_edge_vertices(geometry_.implicit_hypercube.dimension, edge, out_v0, out_v1);
+      return;
     }
-    out3[component] = sum;
+    *out_v0 = geometry_.edges[edge * 2];
+    *out_v1 = geometry_.edges[edge * 2 + 1];
   }
+
+ private:
+  const GeometryInputs& geometry_;
+  bool implicit_;
+};
+
+void project_point(const OverlayProjection& projection, const float* point, float* out3) {
+  project_point_with_operator(point, projection.dimension, projection.matrix.data(), out3);
 }
 
-void project_vertices(const GeometryInputs& geometry, float* out_positions) {
-  const std::size_t dimension = geometry.dimension;
-  std::vector<float> scratch(dimension, 0.0f);
+void project_vertices(const GeometryInputs& geometry, const OverlayProjection& projection, float* out_positions) {
+  if (geometry.implicit_hypercube.dimension > 0) {
+    project_hypercube(geometry.implicit_hypercube, projection.matrix.data(), out_positions);
+    return;
+  }
+  project_with_operator(
+      ConstBufferView{geometry.vertices, geometry.dimension * geometry.vertex_count},
+      geometry.dimension,
+      geometry.vertex_count,
+      projection.matrix.data(),
+      out_positions);
+}
 
-  for (std::size_t vertex = 0; vertex < geometry.vertex_count; ++vertex) {
-    for (std::size_t axis = 0; axis < dimension; ++axis) {
-      scratch[axis] = geometry.vertices[axis * geometry.vertex_count + vertex];
+// Streams every crossing edge through the shared slice rules (detail/slice_rules.hpp) and projects the hits
+// straight into out_positions, in edge order and up to `capacity`: a count pass sizes each edge chunk, then a
+// fill pass writes from the chunk's offset. `distance(v)` is vertex v's signed distance.
+template <typename Distance>
+std::size_t slice_projected(const GeometryAccess& access, const OverlayProjection& projection,
+                            const Distance& distance, float* out_positions, std::size_t capacity) {
+  const std::size_t edge_count = access.edge_count();
+  const std::size_t chunk_count = detail::parallel_chunk_count(edge_count, kParallelMinEdges);
+  std::vector<std::size_t> chunk_offsets(chunk_count + 1, 0);
+  detail::parallel_for_chunks(edge_count, chunk_count, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+    std::size_t hits = 0;
+    for (std::size_t edge = begin; edge < end; ++edge) {
+      std::size_t v0 = 0;
+      std::size_t v1 = 0;
+      access.edge(edge, &v0, &v1);
+      if (detail::edge_crosses_distances(distance(v0), distance(v1))) {
+        ++hits;
+      }
     }
-    project_point(geometry, scratch.data(), out_positions + vertex * 3);
-  }
+    chunk_offsets[chunk + 1] = hits;
+  });
+  for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+    chunk_offsets[chunk + 1] += chunk_offsets[chunk];
+  }
+  const std::size_t count = std::min(chunk_offsets[chunk_count], capacity);
+
+  const std::size_t dimension = projection.dimension;
+  detail::parallel_for_chunks(edge_count, chunk_count, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+    std::size_t slot = chunk_offsets[chunk];
+    if (slot >= count) {
+      return;
+    }
+    std::vector<float> intersection(dimension);
+    for (std::size_t edge = begin; edge < end && slot < count; ++edge) {
+      std::size_t v0 = 0;
+      std::size_t v1 = 0;
+      access.edge(edge, &v0, &v1);
+      const float d0 = distance(v0);
+      const float d1 = distance(v1);
+      if (!detail::edge_crosses_distances(d0, d1)) {
+        continue;
+      }
+      const float t = detail::crossing_parameter(d0, d1);
+      for (std::size_t axis = 0; axis < dimension; ++axis) {
+        const float a = access.coordinate(v0, axis);
+        const float b = access.coordinate(v1, axis);
+        intersection[axis] = a + t * (b - a);
+      }
+      project_point(projection, intersection.data(), out_positions + slot * 3);
+      ++slot;
+    }
+  });
+  return count;
 }
 
 OverlayResult compute_slice(
     const GeometryInputs& geometry,
+    const GeometryAccess& access,
+    const OverlayProjection& projection,
     const HyperplaneInputs& hyperplane,
     float* out_positions,
     std::size_t capacity,
@@ -82,52 +180,21 @@ OverlayResult compute_slice(
   }
 
   const std::size_t dimension = geometry.dimension;
-  std::vector<float> vertex_a(dimension);
-  std::vector<float> vertex_b(dimension);
-  std::vector<float> intersection(dimension);
-
-  std::size_t count = 0;
-  for (std::size_t edge = 0; edge < geometry.edge_count; ++edge) {
-    const unsigned int v0 = geometry.edges[edge * 2];
-    const unsigned int v1 = geometry.edges[edge * 2 + 1];
-
-    for (std::size_t axis = 0; axis < dimension; ++axis) {
-      vertex_a[axis] = geometry.vertices[axis * geometry.vertex_count + v0];
-      vertex_b[axis] = geometry.vertices[axis * geometry.vertex_count + v1];
-    }
-
-    float dot_a = 0.0f;
-    float dot_b = 0.0f;
-    for (std::size_t axis = 0; axis < dimension; ++axis) {
-      dot_a += hyperplane.coefficients[axis] * vertex_a[axis];
-      dot_b += hyperplane.coefficients[axis] * vertex_b[axis];
-    }
-    dot_a -= hyperplane.offset;
-    dot_b -= hyperplane.offset;
-
-    if (dot_a == 0.0f && dot_b == 0.0f) {
-      continue;
-    }
-    if (!(dot_a == 0.0f || dot_b == 0.0f || dot_a * dot_b < 0.0f)) {
-      continue;
-    }
-
-    if (count >= capacity) {
-      break;
-    }
-
-    const float denom = dot_a - dot_b;
-    const float t = std::fabs(denom) > kIntersectionEpsilon ? dot_a / denom : 0.0f;
-
-    for (std::size_t axis = 0; axis < dimension; ++axis) {
-      intersection[axis] = vertex_a[axis] + t * (vertex_b[axis] - vertex_a[axis]);
-    }
-
-    project_point(geometry, intersection.data(), out_positions + count * 3);
-    ++count;
+  const Hyperplane plane{hyperplane.coefficients, dimension, hyperplane.offset};
+  if (access.implicit()) {
+    // Distances come from the cube's bit-group tables, so nothing proportional to 2^n is allocated.
+    const detail::HypercubeDistances distance(geometry.implicit_hypercube.dimension, plane);
+    *out_count = slice_projected(access, projection, distance, out_positions, capacity);
+    return OverlayResult::kSuccess;
   }
 
-  *out_count = count;
+  // One signed distance per vertex instead of two dot products per edge.
+  std::vector<float> distances(geometry.vertex_count);
+  compute_signed_distances(ConstBufferView{geometry.vertices, dimension * geometry.vertex_count},
+                           geometry.vertex_count, dimension, plane, distances.data());
+  const float* stored = distances.data();
+  *out_count = slice_projected(access, projection, [stored](std::size_t vertex) { return stored[vertex]; },
+                               out_positions, capacity);
   return OverlayResult::kSuccess;
 }
 
@@ -148,6 +215,7 @@ bool normalize(std::vector<float>& values) {
 
 void project_probe_and_gradient(
     const GeometryInputs& geometry,
+    const OverlayProjection& projection,
     const std::vector<float>& probe,
     const std::vector<float>& gradient,
     float gradient_scale,
@@ -157,8 +225,8 @@ void project_probe_and_gradient(
     end_point[axis] += gradient[axis] * gradient_scale;
   }
 
-  project_point(geometry, probe.data(), out_positions);
-  project_point(geometry, end_point.data(), out_positions + 3);
+  project_point(projection, probe.data(), out_positions);
+  project_point(projection, end_point.data(), out_positions + 3);
 }
 
 bool build_tangent_basis(
@@ -206,7 +274,7 @@ bool build_tangent_basis(
 }
 
 void write_tangent_patch(
-    const GeometryInputs& geometry,
+    const OverlayProjection& projection,
     const std::vector<float>& probe,
     const std::vector<float>& tangent_u,
     const std::vector<float>& tangent_v,
@@ -224,7 +292,7 @@ void write_tangent_patch(
     for (std::size_t axis = 0; axis < probe.size(); ++axis) {
       nd_point[axis] = probe[axis] + u * tangent_u[axis] + v * tangent_v[axis];
     }
-    project_point(geometry, nd_point.data(), cursor);
+    project_point(projection, nd_point.data(), cursor);
     cursor += 3;
   }
 }
@@ -236,12 +304,19 @@ OverlayResult compute_overlays(
     const HyperplaneInputs& hyperplane,
     const CalculusInputs& calculus,
     OverlayBuffers& buffers) {
+  if (geometry.implicit_hypercube.dimension > 0 &&
+      static_cast<std::size_t>(geometry.implicit_hypercube.dimension) != geometry.dimension) {
+    return OverlayResult::kInvalidInputs;
+  }
+  const GeometryAccess access(geometry);
+  const OverlayProjection projection = make_projection(geometry);
+
   if (buffers.projected_vertices) {
-    project_vertices(geometry, buffers.projected_vertices);
+    project_vertices(geometry, projection, buffers.projected_vertices);
   }
 
   if (buffers.slice_positions && buffers.slice_count) {
-    auto slice_status = compute_slice(geometry, hyperplane, buffers.slice_positions, buffers.slice_capacity, buffers.slice_count);
+    auto slice_status = compute_slice(geometry, access, projection, hyperplane, buffers.slice_positions, buffers.slice_capacity, buffers.slice_count);
     if (slice_status != OverlayResult::kSuccess) {
       return slice_status;
     }
@@ -334,7 +409,7 @@ OverlayResult compute_overlays(
   }
 
   if (wants_gradient) {
-    project_probe_and_gradient(geometry, probe, unit_gradient, calculus.gradient_scale, buffers.gradient_positions);
+    project_probe_and_gradient(geometry, projection, probe, unit_gradient, calculus.gradient_scale, buffers.gradient_positions);
   }
 
   if (wants_tangent) {
@@ -343,85 +418,121 @@ OverlayResult compute_overlays(
     if (!build_tangent_basis(unit_gradient, tangent_u, tangent_v)) {
       return OverlayResult::kGradientError;
     }
-    write_tangent_patch(geometry, probe, tangent_u, tangent_v, buffers.tangent_patch_positions);
+    write_tangent_patch(projection, probe, tangent_u, tangent_v, buffers.tangent_patch_positions);
   }
 
   if (wants_level_sets) {
     const std::size_t max_levels = calculus.level_set_count;
-    std::vector<double> inputs(geometry.dimension, 0.0);
-    std::vector<double> vertex_values(geometry.vertex_count, 0.0);
+    for (std::size_t level_index = 0; level_index < max_levels; ++level_index) {
+      if (buffers.level_set_curves[level_index] == nullptr) {
+        return OverlayResult::kNullBuffer;
+      }
+    }
 
-    for (std::size_t vertex = 0; vertex < geometry.vertex_count; ++vertex) {
+    std::vector<double> inputs(geometry.dimension, 0.0);
+    const auto evaluate = [&](std::size_t vertex, double* out_value) {
       for (std::size_t axis = 0; axis < geometry.dimension; ++axis) {
-        inputs[axis] = static_cast<double>(geometry.vertices[axis * geometry.vertex_count + vertex]);
+        inputs[axis] = static_cast<double>(access.coordinate(vertex, axis));
       }
-      ndcalc_error_t eval_error = ndcalc_eval(
-          program.handle,
-          inputs.data(),
-          geometry.dimension,
-          &vertex_values[vertex]);
-      if (eval_error != NDCALC_OK) {
-        return OverlayResult::kEvalError;
+      return ndcalc_eval(program.handle, inputs.data(), geometry.dimension, out_value) == NDCALC_OK;
+    };
+
+    // Explicit geometry evaluates every vertex once up front. Implicit cubes evaluate both endpoints of each
+    // edge as it streams by instead, in the count and the fill pass: 2n times the evaluations, but nothing
+    // proportional to 2^n is allocated.
+    std::vector<double> vertex_values;
+    if (!access.implicit()) {
+      vertex_values.resize(access.vertex_count());
+      for (std::size_t vertex = 0; vertex < access.vertex_count(); ++vertex) {
+        if (!evaluate(vertex, &vertex_values[vertex])) {
+          return OverlayResult::kEvalError;
+        }
       }
     }
 
-    std::vector<float> intersection(geometry.dimension, 0.0f);
-
-    for (std::size_t level_index = 0; level_index < max_levels; ++level_index) {
-      float* curve_ptr = buffers.level_set_curves[level_index];
-      if (curve_ptr == nullptr) {
-        return OverlayResult::kNullBuffer;
-      }
-
-      std::vector<float> segments;
-      segments.reserve(geometry.edge_count * 3);
-
-      const double target = static_cast<double>(calculus.level_set_values[level_index]);
-      for (std::size_t edge = 0; edge < geometry.edge_count; ++edge) {
-        const unsigned int v0 = geometry.edges[edge * 2];
-        const unsigned int v1 = geometry.edges[edge * 2 + 1];
-
-        const double f0 = vertex_values[v0] - target;
-        const double f1 = vertex_values[v1] - target;
-
-        if (f0 == 0.0 && f1 == 0.0) {
-          continue;
+    // Calls visit(level, v0, v1, f0, f1) for every edge that crosses a level, edges outer and levels inner.
+    const auto for_each_crossing = [&](auto&& visit) {
+      for (std::size_t edge = 0; edge < access.edge_count(); ++edge) {
+        std::size_t v0 = 0;
+        std::size_t v1 = 0;
+        access.edge(edge, &v0, &v1);
+
+        double value0 = 0.0;
+        double value1 = 0.0;
+        if (access.implicit()) {
+          if (!evaluate(v0, &value0) || !evaluate(v1, &value1)) {
+            return false;
+          }
+        } else {
+          value0 = vertex_values[v0];
+          value1 = vertex_values[v1];
         }
-        if (!(f0 == 0.0 || f1 == 0.0 || f0 * f1 < 0.0)) {
-          continue;
-        }
-
-        const double denom = f0 - f1;
-        const double t = std::fabs(denom) > static_cast<double>(kIntersectionEpsilon)
-                             ? f0 / denom
-                             : 0.0;
 
-        for (std::size_t axis = 0; axis < geometry.dimension; ++axis) {
-          const float value_a = geometry.vertices[axis * geometry.vertex_count + v0];
-          const float value_b = geometry.vertices[axis * geometry.vertex_count + v1];
-          intersection[axis] = value_a + static_cast<float>(t) * (value_b - value_a);
+        for (std::size_t level_index = 0; level_index < max_levels; ++level_index) {
+          const double target = static_cast<double>(calculus.level_set_values[level_index]);
+          const double f0 = value0 - target;
+          const double f1 = value1 - target;
+
+          if (f0 == 0.0 && f1 == 0.0) {
+            continue;
+          }
+          if (!(f0 == 0.0 || f1 == 0.0 || f0 * f1 < 0.0)) {
+            continue;
+          }
+          visit(level_index, v0, v1, f0, f1);
         }
-
-        float projected[3];
-        project_point(geometry, intersection.data(), projected);
-        segments.push_back(projected[0]);
-        segments.push_back(projected[1]);
-        segments.push_back(projected[2]);
       }
+      return true;
+    };
+
+    // Count pass: each curve is sized before anything is written. As with one buffer per level filled in
+    // order, the levels before the first short one are written in full and the short one and every later
+    // one are left untouched, sizes included.
+    std::vector<std::size_t> sizes(max_levels, 0);
+    if (!for_each_crossing([&](std::size_t level_index, std::size_t, std::size_t, double, double) {
+          sizes[level_index] += 3;
+        })) {
+      return OverlayResult::kEvalError;
+    }
+    std::size_t filled_levels = 0;
+    while (filled_levels < max_levels &&
+           (sizes[filled_levels] == 0 || sizes[filled_levels] <= buffers.level_set_sizes[filled_levels])) {
+      ++filled_levels;
+    }
 
-      if (segments.empty()) {
-        buffers.level_set_sizes[level_index] = 0;
-        continue;
-      }
+    std::vector<std::size_t> written(max_levels, 0);
+    std::vector<float> intersection(geometry.dimension, 0.0f);
+    if (filled_levels > 0 &&
+        !for_each_crossing([&](std::size_t level_index, std::size_t v0, std::size_t v1, double f0, double f1) {
+          if (level_index >= filled_levels) {
+            return;
+          }
+          const double denom = f0 - f1;
+          const double t = std::fabs(denom) > static_cast<double>(kIntersectionEpsilon)
+                               ? f0 / denom
+                               : 0.0;
+
+          for (std::size_t axis = 0; axis < geometry.dimension; ++axis) {
+            const float value_a = access.coordinate(v0, axis);
+            const float value_b = access.coordinate(v1, axis);
+            intersection[axis] = value_a + static_cast<float>(t) * (value_b - value_a);
+          }
+
+          project_point(projection, intersection.data(),
+                        buffers.level_set_curves[level_index] + written[level_index]);
+          written[level_index] += 3;
+        })) {
+      return OverlayResult::kEvalError;
+    }
 
-      const std::size_t buffer_capacity = buffers.level_set_sizes[level_index];
-      if (buffer_capacity < segments.size()) {
-        return OverlayResult::kNullBuffer;
+    for (std::size_t level_index = 0; level_index < filled_levels; ++level_index) {
+      buffers.level_set_sizes[level_index] = written[level_index];
+      if (written[level_index] > 0) {
+        (*buffers.level_set_count)++;
       }
-
-      std::copy(segments.begin(), segments.end(), curve_ptr);
-      buffers.level_set_sizes[level_index] = segments.size();
-      (*buffers.level_set_count)++;
+    }
+    if (filled_levels < max_levels) {
+      return OverlayResult::kNullBuffer;
     }
   }
 
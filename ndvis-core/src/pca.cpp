@@ -1,13 +1,23 @@
 #include "ndvis/pca.hpp"
 
 #include <cstddef>
+#include <vector>
 
+#include "ndvis/detail/covariance.hpp"
+#include "ndvis/detail/eigen.hpp"
 #include "ndvis/detail/jacobi.hpp"
+#include "ndvis/detail/subspace.hpp"
 
 namespace ndvis {
 
 namespace {
 
+// Components written by compute_pca_basis (x/y/z).
+constexpr std::size_t kBasisComponents = 3;
+// From this dimension on, callers that only need the leading components get subspace iteration
+// instead of a full solve; below it Householder + QL on the whole spectrum is as cheap.
+constexpr std::size_t kTopKMinDimension = 512;
+
 inline void fill_identity_basis(std::size_t dimension, float* out_basis) {
   for (std::size_t component = 0; component < 3; ++component) {
     for (std::size_t axis = 0; axis < dimension; ++axis) {
@@ -16,76 +26,61 @@ inline void fill_identity_basis(std::size_t dimension, float* out_basis) {
   }
 }
 
-}  // namespace
-
-void compute_pca_basis_with_values(const float* vertices, std::size_t vertex_count, std::size_t dimension,
-                                   float* out_basis, float* out_eigenvalues) {
-  if (vertices == nullptr || out_basis == nullptr || dimension == 0) {
-    return;
+// Full spectrum: eigenvalues descending, eigenvectors as columns (dimension x dimension).
+// The covariance is overwritten.
+void solve_full(double* covariance, std::size_t dimension, double* eigenvalues, double* eigenvectors,
+                const EigenParams& params, JacobiReport* report) {
+  detail::symmetric_eigen(covariance, eigenvectors, dimension, params, report);
+  for (std::size_t i = 0; i < dimension; ++i) {
+    eigenvalues[i] = covariance[i * dimension + i];
   }
+  detail::sort_eigenpairs(eigenvalues, eigenvectors, dimension);
+}
 
-  if (vertex_count == 0) {
-    fill_identity_basis(dimension, out_basis);
-    if (out_eigenvalues != nullptr) {
-      for (std::size_t i = 0; i < dimension; ++i) {
-        out_eigenvalues[i] = 0.0f;
-      }
+// Leading `count` eigenpairs (eigenvectors as the columns of a dimension x count matrix). Uses subspace
+// iteration when count is small against the dimension and falls back to a full solve otherwise.
+void solve_leading(double* covariance, std::size_t dimension, std::size_t count, double* eigenvalues,
+                   double* eigenvectors) {
+  if (dimension >= kTopKMinDimension && count * 2 <= dimension) {
+    detail::SubspaceParams params{};
+    if (detail::subspace_iteration(covariance, dimension, count, params, eigenvalues, eigenvectors)) {
+      return;
     }
-    return;
   }
-
-  double* mean = new double[dimension];
-  for (std::size_t axis = 0; axis < dimension; ++axis) {
-    mean[axis] = 0.0;
+  std::vector<double> all_values(dimension);
+  std::vector<double> all_vectors(dimension * dimension);
+  solve_full(covariance, dimension, all_values.data(), all_vectors.data(), EigenParams{}, nullptr);
+  for (std::size_t col = 0; col < count; ++col) {
+    eigenvalues[col] = all_values[col];
   }
-
-  for (std::size_t axis = 0; axis < dimension; ++axis) {
-    double sum = 0.0;
-    for (std::size_t v = 0; v < vertex_count; ++v) {
-      sum += static_cast<double>(vertices[axis * vertex_count + v]);
+  for (std::size_t row = 0; row < dimension; ++row) {
+    for (std::size_t col = 0; col < count; ++col) {
+      eigenvectors[row * count + col] = all_vectors[row * dimension + col];
     }
-    mean[axis] = sum / static_cast<double>(vertex_count);
   }
+}
 
-  double* covariance = new double[dimension * dimension];
-  for (std::size_t i = 0; i < dimension * dimension; ++i) {
-    covariance[i] = 0.0;
+// Outputs for an empty point set: identity basis and zero eigenvalues.
+void write_empty(std::size_t dimension, float* out_basis, float* out_eigenvalues, JacobiReport* out_report) {
+  if (out_report != nullptr) {
+    *out_report = JacobiReport{};
+    out_report->converged = true;
   }
-
-  const double normalizer = vertex_count > 1 ? 1.0 / static_cast<double>(vertex_count - 1) : 1.0;
-
-  for (std::size_t v = 0; v < vertex_count; ++v) {
+  fill_identity_basis(dimension, out_basis);
+  if (out_eigenvalues != nullptr) {
     for (std::size_t i = 0; i < dimension; ++i) {
-      const double xi = static_cast<double>(vertices[i * vertex_count + v]) - mean[i];
-      for (std::size_t j = 0; j <= i; ++j) {
-        const double xj = static_cast<double>(vertices[j * vertex_count + v]) - mean[j];
-        covariance[i * dimension + j] += xi * xj;
-      }
+      out_eigenvalues[i] = 0.0f;
     }
   }
+}
 
-  for (std::size_t i = 0; i < dimension; ++i) {
-    for (std::size_t j = 0; j <= i; ++j) {
-      const double value = covariance[i * dimension + j] * normalizer;
-      covariance[i * dimension + j] = value;
-      covariance[j * dimension + i] = value;
-    }
-  }
-
-  double* eigenvectors = new double[dimension * dimension];
-  detail::JacobiParams params{};
-  detail::jacobi_symmetric(covariance, eigenvectors, dimension, params);
-
-  double* eigenvalues = new double[dimension];
-  for (std::size_t i = 0; i < dimension; ++i) {
-    eigenvalues[i] = covariance[i * dimension + i];
-  }
-  detail::sort_eigenpairs(eigenvalues, eigenvectors, dimension);
-
+// eigenvectors: dimension x columns, one eigenvector per column; eigenvalues: `columns` values, descending.
+void write_outputs(const double* eigenvectors, const double* eigenvalues, std::size_t dimension, std::size_t columns,
+                   float* out_basis, float* out_eigenvalues) {
   for (std::size_t component = 0; component < 3; ++component) {
     for (std::size_t axis = 0; axis < dimension; ++axis) {
       if (component < dimension) {
-        out_basis[component * dimension + axis] = static_cast<float>(eigenvectors[axis * dimension + component]);
+        out_basis[component * dimension + axis] = static_cast<float>(eigenvectors[axis * columns + component]);
       } else {
         out_basis[component * dimension + axis] = (component == axis) ? 1.0f : 0.0f;
       }
@@ -93,16 +88,124 @@ void compute_pca_basis_with_values(const float* vertices, std::size_t vertex_cou
   }
 
   if (out_eigenvalues != nullptr) {
-    for (std::size_t i = 0; i < dimension; ++i) {
+    for (std::size_t i = 0; i < columns; ++i) {
       const double value = eigenvalues[i];
       out_eigenvalues[i] = static_cast<float>(value < 0.0 ? 0.0 : value);
     }
   }
+}
+
+// Full-spectrum PCA inside pca_workspace_size(dimension) doubles; allocates only for a solver report.
+void pca_full(const float* vertices, std::size_t vertex_count, std::size_t dimension, float* out_basis,
+              float* out_eigenvalues, const EigenParams& params, JacobiReport* out_report, double* workspace) {
+  double* mean = workspace;
+  double* covariance = mean + dimension;
+  double* eigenvectors = covariance + dimension * dimension;
+  double* eigenvalues = eigenvectors + dimension * dimension;
+  double* scratch = eigenvalues + dimension;
+  detail::compute_covariance(vertices, vertex_count, dimension, mean, covariance, scratch);
+  solve_full(covariance, dimension, eigenvalues, eigenvectors, params, out_report);
+  write_outputs(eigenvectors, eigenvalues, dimension, dimension, out_basis, out_eigenvalues);
+}
+
+}  // namespace
 
-  delete[] eigenvalues;
-  delete[] eigenvectors;
-  delete[] covariance;
-  delete[] mean;
+std::size_t pca_workspace_size(std::size_t dimension) {
+  return 2 * dimension + 2 * dimension * dimension + detail::covariance_workspace_size(dimension);
+}
+
+bool compute_pca_basis_with_workspace(const float* vertices, std::size_t vertex_count, std::size_t dimension,
+                                      float* out_basis, float* out_eigenvalues, double* workspace,
+                                      std::size_t workspace_length) {
+  if (vertices == nullptr || out_basis == nullptr || dimension == 0) {
+    return false;
+  }
+  if (workspace == nullptr || workspace_length < pca_workspace_size(dimension)) {
+    return false;
+  }
+  if (vertex_count == 0) {
+    write_empty(dimension, out_basis, out_eigenvalues, nullptr);
+    return true;
+  }
+  pca_full(vertices, vertex_count, dimension, out_basis, out_eigenvalues, EigenParams{}, nullptr, workspace);
+  return true;
+}
+
+void compute_pca_basis_with_values(const float* vertices, std::size_t vertex_count, std::size_t dimension,
+                                   float* out_basis, float* out_eigenvalues, const EigenParams& params,
+                                   JacobiReport* out_report) {
+  if (vertices == nullptr || out_basis == nullptr || dimension == 0) {
+    return;
+  }
+  if (vertex_count == 0) {
+    write_empty(dimension, out_basis, out_eigenvalues, out_report);
+    return;
+  }
+  std::vector<double> workspace(pca_workspace_size(dimension));
+  pca_full(vertices, vertex_count, dimension, out_basis, out_eigenvalues, params, out_report, workspace.data());
+}
+
+void compute_pca_basis_with_values(const float* vertices, std::size_t vertex_count, std::size_t dimension,
+                                   float* out_basis, float* out_eigenvalues, JacobiReport* out_report) {
+  if (vertices == nullptr || out_basis == nullptr || dimension == 0) {
+    return;
+  }
+
+  if (vertex_count == 0) {
+    write_empty(dimension, out_basis, out_eigenvalues, out_report);
+    return;
+  }
+
+  // Without a request for the spectrum or the solver report only the leading components are solved for.
+  if (out_eigenvalues != nullptr || out_report != nullptr) {
+    compute_pca_basis_with_values(vertices, vertex_count, dimension, out_basis, out_eigenvalues, EigenParams{},
+                                  out_report);
+    return;
+  }
+
+  std::vector<double> mean(dimension);
+  std::vector<double> covariance(dimension * dimension);
+  detail::compute_covariance(vertices, vertex_count, dimension, mean.data(), covariance.data());
+  const std::size_t columns = dimension < kBasisComponents ? dimension : kBasisComponents;
+  std::vector<double> eigenvalues(columns);
+  std::vector<double> eigenvectors(dimension * columns);
+  solve_leading(covariance.data(), dimension, columns, eigenvalues.data(), eigenvectors.data());
+  write_outputs(eigenvectors.data(), eigenvalues.data(), dimension, columns, out_basis, nullptr);
+}
+
+void compute_pca_basis_with_values(const float* vertices, std::size_t vertex_count, std::size_t dimension,
+                                   float* out_basis, float* out_eigenvalues) {
+  compute_pca_basis_with_values(vertices, vertex_count, dimension, out_basis, out_eigenvalues, nullptr);
+}
+
+void compute_pca_components(const float* vertices, std::size_t vertex_count, std::size_t dimension,
+                            std::size_t count, float* out_components, float* out_eigenvalues) {
+  if (vertices == nullptr || out_components == nullptr || dimension == 0 || count == 0 || count > dimension) {
+    return;
+  }
+
+  std::vector<double> eigenvalues(count, 0.0);
+  std::vector<double> eigenvectors(dimension * count, 0.0);
+  if (vertex_count == 0) {
+    for (std::size_t axis = 0; axis < count; ++axis) {
+      eigenvectors[axis * count + axis] = 1.0;
+    }
+  } else {
+    std::vector<double> mean(dimension);
+    std::vector<double> covariance(dimension * dimension);
+    detail::compute_covariance(vertices, vertex_count, dimension, mean.data(), covariance.data());
+    solve_leading(covariance.data(), dimension, count, eigenvalues.data(), eigenvectors.data());
+  }
+
+  for (std::size_t component = 0; component < count; ++component) {
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      out_components[component * dimension + axis] = static_cast<float>(eigenvectors[axis * count + component]);
+    }
+    if (out_eigenvalues != nullptr) {
+      const double value = eigenvalues[component];
+      out_eigenvalues[component] = static_cast<float>(value < 0.0 ? 0.0 : value);
+    }
+  }
 }
 
 void compute_pca_basis(const float* vertices, std::size_t vertex_count, std::size_t dimension, float* out_basis) {
@@ -0,0 +1,246 @@
+#include "ndvis/progressive_pca.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ndvis/detail/covariance.hpp"
+#include "ndvis/detail/eigen.hpp"
+#include "ndvis/detail/jacobi.hpp"
+
+namespace ndvis {
+
+namespace {
+
+// Components written to out_basis (x/y/z).
+constexpr std::size_t kBasisComponents = 3;
+
+std::uint64_t next_random(std::uint64_t& state) {
+  // splitmix64
+  state += 0x9e3779b97f4a7c15ULL;
+  std::uint64_t z = state;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+// Uniform in (0, 1]; never 0, so its logarithm is finite.
+double next_unit(std::uint64_t& state) {
+  return (static_cast<double>(next_random(state) >> 11) + 1.0) * 0x1.0p-53;
+}
+
+double bounded_error(double perturbation, double gap) {
+  if (perturbation <= 0.0) {
+    return 0.0;
+  }
+  if (gap <= 0.0) {
+    return 1.0;
+  }
+  const double ratio = perturbation / gap;
+  return ratio < 1.0 ? ratio : 1.0;
+}
+
+void write_basis(const double* eigenvectors, const double* eigenvalues, std::size_t dimension, float* out_basis,
+                 float* out_eigenvalues) {
+  for (std::size_t component = 0; component < kBasisComponents; ++component) {
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      if (component < dimension) {
+        out_basis[component * dimension + axis] = static_cast<float>(eigenvectors[axis * dimension + component]);
+      } else {
+        out_basis[component * dimension + axis] = (component == axis) ? 1.0f : 0.0f;
+      }
+    }
+  }
+  for (std::size_t i = 0; i < dimension; ++i) {
+    const double value = eigenvalues[i];
+    out_eigenvalues[i] = static_cast<float>(value < 0.0 ? 0.0 : value);
+  }
+}
+
+}  // namespace
+
+ProgressivePca::ProgressivePca(std::size_t dimension, const ProgressivePcaParams& params)
+    : dimension_(dimension),
+      params_(params),
+      mean_(dimension, 0.0),
+      covariance_(dimension * dimension, 0.0),
+      eigenvectors_(dimension * dimension, 0.0),
+      eigenvalues_(dimension, 0.0),
+      covariance_scratch_(detail::covariance_workspace_size(dimension), 0.0),
+      approximate_basis_(kBasisComponents * dimension, 0.0f),
+      approximate_eigenvalues_(dimension, 0.0f),
+      exact_(dimension),
+      refined_basis_(kBasisComponents * dimension, 0.0f),
+      refined_eigenvalues_(dimension, 0.0f) {}
+
+// Li's Algorithm L: after the first k indices, the gap to the next replacement is geometric, so drawing
+// k of V costs O(k * (1 + log(V / k))) random numbers instead of one per vertex.
+void ProgressivePca::sample_indices(std::size_t vertex_count) {
+  const std::size_t k = params_.sample_size;
+  indices_.resize(k);
+  for (std::size_t i = 0; i < k; ++i) {
+    indices_[i] = i;
+  }
+  std::uint64_t state = params_.seed;
+  const double inverse_k = 1.0 / static_cast<double>(k);
+  double w = std::exp(std::log(next_unit(state)) * inverse_k);
+  std::size_t index = k - 1;
+  while (w < 1.0) {
+    const double skip = std::floor(std::log(next_unit(state)) / std::log1p(-w));
+    if (skip >= static_cast<double>(vertex_count - index - 1)) {
+      break;
+    }
+    index += static_cast<std::size_t>(skip) + 1;
+    indices_[next_random(state) % k] = index;
+    w *= std::exp(std::log(next_unit(state)) * inverse_k);
+  }
+  // Gather in memory order.
+  std::sort(indices_.begin(), indices_.end());
+}
+
+void ProgressivePca::begin(const float* vertices, std::size_t vertex_count) {
+  const std::size_t n = dimension_;
+  vertices_ = vertices;
+  vertex_count_ = vertex_count;
+  refined_count_ = 0;
+  refined_ = false;
+  confidence_ = PcaConfidence{};
+  confidence_.vertex_count = vertex_count;
+  exact_.reset();
+  if (vertices == nullptr || vertex_count == 0 || n == 0) {
+    // Nothing to sample: the identity basis with zero eigenvalues is the exact answer.
+    vertex_count_ = 0;
+    for (std::size_t i = 0; i < n * n; ++i) {
+      eigenvectors_[i] = (i % (n + 1) == 0) ? 1.0 : 0.0;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      eigenvalues_[i] = 0.0;
+    }
+    write_basis(eigenvectors_.data(), eigenvalues_.data(), n, approximate_basis_.data(),
+                approximate_eigenvalues_.data());
+    confidence_.exact = true;
+    refined_ = true;
+    refined_basis_ = approximate_basis_;
+    refined_eigenvalues_ = approximate_eigenvalues_;
+    return;
+  }
+
+  const bool full = params_.sample_size == 0 || params_.sample_size >= vertex_count;
+  const float* sample = vertices;
+  std::size_t sample_count = vertex_count;
+  if (!full) {
+    sample_indices(vertex_count);
+    sample_count = indices_.size();
+    sample_.resize(n * sample_count);
+    for (std::size_t axis = 0; axis < n; ++axis) {
+      const float* column = vertices + axis * vertex_count;
+      float* row = sample_.data() + axis * sample_count;
+      for (std::size_t i = 0; i < sample_count; ++i) {
+        row[i] = column[indices_[i]];
+      }
+    }
+    sample = sample_.data();
+  }
+  confidence_.sample_count = sample_count;
+
+  detail::compute_covariance(sample, sample_count, n, mean_.data(), covariance_.data(), covariance_scratch_.data());
+
+  // ||C_sample - C||_F^2 ~ sum_ij Var(y_i y_j) / m = (E||y||^4 - ||C||_F^2) / m for centered y, times the
+  // finite-population correction 1 - m / V.
+  double perturbation = 0.0;
+  if (!full) {
+    double frobenius = 0.0;
+    for (std::size_t i = 0; i < n * n; ++i) {
+      frobenius += covariance_[i] * covariance_[i];
+    }
+    double fourth = 0.0;
+    for (std::size_t i = 0; i < sample_count; ++i) {
+      double norm = 0.0;
+      for (std::size_t axis = 0; axis < n; ++axis) {
+        const double value = static_cast<double>(sample[axis * sample_count + i]) - mean_[axis];
+        norm += value * value;
+      }
+      fourth += norm * norm;
+    }
+    const double m = static_cast<double>(sample_count);
+    const double variance = (fourth / m - frobenius) / m;
+    const double correction = 1.0 - m / static_cast<double>(vertex_count);
+    perturbation = variance > 0.0 ? std::sqrt(variance * correction) : 0.0;
+  }
+
+  detail::EigenParams params{};
+  detail::symmetric_eigen(covariance_.data(), eigenvectors_.data(), n, params);
+  for (std::size_t i = 0; i < n; ++i) {
+    eigenvalues_[i] = covariance_[i * n + i];
+  }
+  detail::sort_eigenpairs(eigenvalues_.data(), eigenvectors_.data(), n);
+  write_basis(eigenvectors_.data(), eigenvalues_.data(), n, approximate_basis_.data(),
+              approximate_eigenvalues_.data());
+
+  const std::size_t k = n < kBasisComponents ? n : kBasisComponents;
+  double min_gap = 0.0;
+  for (std::size_t i = 0; i < k && i + 1 < n; ++i) {
+    const double gap = eigenvalues_[i] - eigenvalues_[i + 1];
+    min_gap = (i == 0 || gap < min_gap) ? gap : min_gap;
+  }
+  confidence_.eigengap = k < n ? eigenvalues_[k - 1] - eigenvalues_[k] : 0.0;
+  confidence_.min_gap = min_gap;
+  confidence_.perturbation = perturbation;
+  confidence_.subspace_error = k < n ? bounded_error(perturbation, confidence_.eigengap) : 0.0;
+  confidence_.component_error = n > 1 ? bounded_error(perturbation, min_gap) : 0.0;
+
+  if (full) {
+    confidence_.exact = true;
+    refined_count_ = vertex_count;
+    refined_ = true;
+    refined_basis_ = approximate_basis_;
+    refined_eigenvalues_ = approximate_eigenvalues_;
+  }
+}
+
+bool ProgressivePca::refine_step(std::size_t max_vertices) {
+  if (refined_ || vertex_count_ == 0 || max_vertices == 0) {
+    return refined_;
+  }
+  const std::size_t remaining = vertex_count_ - refined_count_;
+  const std::size_t count = max_vertices < remaining ? max_vertices : remaining;
+  exact_.add_batch(vertices_ + refined_count_, count, vertex_count_);
+  refined_count_ += count;
+  if (refined_count_ == vertex_count_) {
+    exact_.compute_basis(refined_basis_.data(), refined_eigenvalues_.data());
+    refined_ = true;
+  }
+  return refined_;
+}
+
+double ProgressivePca::progress() const {
+  if (vertex_count_ == 0) {
+    return refined_ ? 1.0 : 0.0;
+  }
+  return static_cast<double>(refined_count_) / static_cast<double>(vertex_count_);
+}
+
+void ProgressivePca::approximate_basis(float* out_basis, float* out_eigenvalues,
+                                       PcaConfidence* out_confidence) const {
+  if (out_basis != nullptr) {
+    std::copy(approximate_basis_.begin(), approximate_basis_.end(), out_basis);
+  }
+  if (out_eigenvalues != nullptr) {
+    std::copy(approximate_eigenvalues_.begin(), approximate_eigenvalues_.end(), out_eigenvalues);
+  }
+  if (out_confidence != nullptr) {
+    *out_confidence = confidence_;
+  }
+}
+
+bool ProgressivePca::refined_basis(float* out_basis, float* out_eigenvalues) const {
+  if (!refined_ || out_basis == nullptr) {
+    return false;
+  }
+  std::copy(refined_basis_.begin(), refined_basis_.end(), out_basis);
+  if (out_eigenvalues != nullptr) {
+    std::copy(refined_eigenvalues_.begin(), refined_eigenvalues_.end(), out_eigenvalues);
+  }
+  return true;
+}
+
+}  // namespace ndvis
@@ -1,6 +1,12 @@
 #include "ndvis/projection.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <vector>
+
+#include "ndvis/detail/projection_kernels.hpp"
+#include "ndvis/detail/thread_pool.hpp"
+#include "ndvis/geometry.hpp"
 
 namespace ndvis {
 
@@ -11,52 +17,262 @@ struct AutoBuffer {
   float* data;
   std::size_t length;
 };
+
+// Below this many vertices per chunk, projection stays on the calling thread.
+constexpr std::size_t kParallelMinVertices = 16384;
+// Chunk granularity; a multiple of every kernel's vector width.
+constexpr std::size_t kVertexBlock = 64;
+// Hypercube low-bit table size: 2^10 entries * 3 floats stays resident in L1.
+constexpr int kHypercubeTableBits = 10;
+// Up to this dimension update_projection_incremental keeps its scratch (previous operator, touched axes
+// and their deltas: 6n floats and n indices, about 2 KiB) on the stack.
+constexpr std::size_t kIncrementalStackDimension = 64;
 }  // namespace
 
-void project_to_3d(ConstBufferView vertices, std::size_t dimension, std::size_t vertex_count, const float* rotation_matrix,
-                   std::size_t rotation_stride, ConstBasis3 basis, float* out_positions) {
-  if (vertices.data == nullptr || rotation_matrix == nullptr || basis.data == nullptr || out_positions == nullptr) {
+void build_projection_operator(const float* rotation_matrix, std::size_t rotation_stride, ConstBasis3 basis,
+                               float* out_operator) {
+  const std::size_t dimension = basis.dimension;
+  if (rotation_matrix == nullptr || basis.data == nullptr || out_operator == nullptr || dimension == 0) {
     return;
   }
-  if (dimension == 0 || vertex_count == 0) {
+  if (rotation_stride == 0) {
+    rotation_stride = dimension;
+  }
+
+  for (std::size_t component = 0; component < kProjectionRows; ++component) {
+    float* row_out = out_operator + component * dimension;
+    for (std::size_t col = 0; col < dimension; ++col) {
+      row_out[col] = 0.0f;
+    }
+    const float* basis_column = basis.data + component * basis.stride;
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      const float weight = basis_column[axis];
+      const float* row_ptr = rotation_matrix + axis * rotation_stride;
+      for (std::size_t col = 0; col < dimension; ++col) {
+        row_out[col] += weight * row_ptr[col];
+      }
+    }
+  }
+}
+
+void project_with_operator(ConstBufferView vertices, std::size_t dimension, std::size_t vertex_count,
+                           const float* projection_operator, float* out_positions) {
+  if (vertices.data == nullptr || projection_operator == nullptr || out_positions == nullptr) {
     return;
   }
-  if (vertices.length < dimension * vertex_count) {
+  if (dimension == 0 || vertex_count == 0 || vertices.length < dimension * vertex_count) {
     return;
   }
-  if (basis.dimension != dimension || basis.stride < dimension) {
+
+  // Vectorized over contiguous axis columns; the kernel is picked from runtime CPU feature detection.
+  // Chunks are whole blocks, so every vertex lands in the same SIMD lane group (and the same scalar
+  // tail) as in a serial run: the output is bitwise identical for any thread count.
+  const detail::ProjectKernel kernel = detail::active_project_kernel();
+  const std::size_t block_count = (vertex_count + kVertexBlock - 1) / kVertexBlock;
+  detail::parallel_for(block_count, kParallelMinVertices / kVertexBlock, [&](std::size_t begin, std::size_t end) {
+    const std::size_t last = end * kVertexBlock < vertex_count ? end * kVertexBlock : vertex_count;
+    kernel(vertices.data, vertex_count, dimension, projection_operator, out_positions, begin * kVertexBlock, last);
+  });
+}
+
+void project_point_with_operator(const float* point, std::size_t dimension, const float* projection_operator,
+                                 float* out3) {
+  for (std::size_t component = 0; component < kProjectionRows; ++component) {
+    const float* row = projection_operator + component * dimension;
+    float sum = 0.0f;
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      sum += row[axis] * point[axis];
+    }
+    out3[component] = sum;
+  }
+}
+
+void apply_givens_to_operator(float* projection_operator, std::size_t dimension, const RotationPlane* planes,
+                              std::size_t plane_count) {
+  if (projection_operator == nullptr || planes == nullptr || dimension == 0) {
     return;
   }
-  if (rotation_stride == 0) {
-    rotation_stride = dimension;
+  for (std::size_t idx = 0; idx < plane_count; ++idx) {
+    const RotationPlane plane = planes[idx];
+    if (plane.i >= dimension || plane.j >= dimension) {
+      continue;
+    }
+    const float c = __builtin_cosf(plane.theta);
+    const float s = __builtin_sinf(plane.theta);
+    for (std::size_t row = 0; row < kProjectionRows; ++row) {
+      float* row_ptr = projection_operator + row * dimension;
+      const float a = row_ptr[plane.i];
+      const float b = row_ptr[plane.j];
+      row_ptr[plane.i] = c * a - s * b;
+      row_ptr[plane.j] = s * a + c * b;
+    }
+  }
+}
+
+void update_projection_incremental(ConstBufferView vertices, std::size_t dimension, std::size_t vertex_count,
+                                   float* projection_operator, const RotationPlane* planes, std::size_t plane_count,
+                                   float* inout_positions) {
+  if (vertices.data == nullptr || projection_operator == nullptr || planes == nullptr || inout_positions == nullptr) {
+    return;
+  }
+  if (dimension == 0 || vertices.length < dimension * vertex_count) {
+    return;
   }
 
-  AutoBuffer scratch(dimension);
-  AutoBuffer rotated(dimension);
+  // Per-frame drag path: no allocation up to kIncrementalStackDimension.
+  float stack_floats[2 * kProjectionRows * kIncrementalStackDimension];
+  std::size_t stack_axes[kIncrementalStackDimension];
+  std::vector<float> heap_floats;
+  std::vector<std::size_t> heap_axes;
+  float* previous = stack_floats;
+  std::size_t* axes = stack_axes;
+  if (dimension > kIncrementalStackDimension) {
+    heap_floats.resize(2 * kProjectionRows * dimension);
+    heap_axes.resize(dimension);
+    previous = heap_floats.data();
+    axes = heap_axes.data();
+  }
+  float* deltas = previous + kProjectionRows * dimension;
 
-  for (std::size_t vertex = 0; vertex < vertex_count; ++vertex) {
-    for (std::size_t axis = 0; axis < dimension; ++axis) {
-      scratch.data[axis] = vertices.data[axis * vertex_count + vertex];
+  for (std::size_t i = 0; i < kProjectionRows * dimension; ++i) {
+    previous[i] = projection_operator[i];
+  }
+  apply_givens_to_operator(projection_operator, dimension, planes, plane_count);
+
+  // Only columns named by a plane can change; gather their deltas (dx, dy, dz) per axis.
+  std::size_t axis_count = 0;
+  for (std::size_t idx = 0; idx < plane_count; ++idx) {
+    for (const unsigned int axis : {planes[idx].i, planes[idx].j}) {
+      if (axis >= dimension || std::find(axes, axes + axis_count, axis) != axes + axis_count) {
+        continue;
+      }
+      for (std::size_t row = 0; row < kProjectionRows; ++row) {
+        deltas[axis_count * 3 + row] = projection_operator[row * dimension + axis] - previous[row * dimension + axis];
+      }
+      axes[axis_count++] = axis;
     }
+  }
+  if (axis_count == 0) {
+    return;
+  }
 
-    for (std::size_t row = 0; row < dimension; ++row) {
-      float sum = 0.0f;
-      const float* row_ptr = rotation_matrix + row * rotation_stride;
-      for (std::size_t col = 0; col < dimension; ++col) {
-        sum += row_ptr[col] * scratch.data[col];
+  detail::parallel_for(vertex_count, kParallelMinVertices, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t k = 0; k < axis_count; ++k) {
+      const float* column = vertices.data + axes[k] * vertex_count;
+      const float dx = deltas[k * 3 + 0];
+      const float dy = deltas[k * 3 + 1];
+      const float dz = deltas[k * 3 + 2];
+      for (std::size_t v = begin; v < end; ++v) {
+        const float value = column[v];
+        inout_positions[v * 3 + 0] += dx * value;
+        inout_positions[v * 3 + 1] += dy * value;
+        inout_positions[v * 3 + 2] += dz * value;
       }
-      rotated.data[row] = sum;
     }
+  });
+}
+
+void project_hypercube(int dimension, const float* projection_operator, float* out_positions) {
+  const std::size_t vertex_count = hypercube_vertex_count(dimension);
+  if (vertex_count == 0 || projection_operator == nullptr || out_positions == nullptr) {
+    return;
+  }
+  const std::size_t n = static_cast<std::size_t>(dimension);
+  const int low_bits = dimension < kHypercubeTableBits ? dimension : kHypercubeTableBits;
+  const std::size_t low_count = static_cast<std::size_t>(1) << low_bits;
+  const std::size_t high_count = vertex_count >> low_bits;
+
+  // Low table by subset walk: entry lo differs from lo minus its top bit b by +2 * M[:,b].
+  // Accumulated in double so the deepest entries stay within float rounding of a direct sum.
+  std::vector<double> low_sums(low_count * 3);
+  for (std::size_t row = 0; row < kProjectionRows; ++row) {
+    double sum = 0.0;
+    for (int axis = 0; axis < low_bits; ++axis) {
+      sum -= projection_operator[row * n + static_cast<std::size_t>(axis)];
+    }
+    low_sums[row] = sum;
+  }
+  for (std::size_t lo = 1; lo < low_count; ++lo) {
+    const int top = 31 - __builtin_clz(static_cast<unsigned int>(lo));
+    const std::size_t base = lo ^ (static_cast<std::size_t>(1) << top);
+    for (std::size_t row = 0; row < kProjectionRows; ++row) {
+      low_sums[lo * 3 + row] =
+          low_sums[base * 3 + row] + 2.0 * projection_operator[row * n + static_cast<std::size_t>(top)];
+    }
+  }
 
-    for (std::size_t component = 0; component < 3; ++component) {
-      float sum = 0.0f;
-      const float* basis_column = basis.data + component * basis.stride;
-      for (std::size_t axis = 0; axis < dimension; ++axis) {
-        sum += rotated.data[axis] * basis_column[axis];
+  const std::size_t min_blocks = kParallelMinVertices / low_count;
+  detail::parallel_for(high_count, min_blocks == 0 ? 1 : min_blocks, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t hi = begin; hi < end; ++hi) {
+      double high_sum[3] = {0.0, 0.0, 0.0};
+      for (std::size_t axis = static_cast<std::size_t>(low_bits); axis < n; ++axis) {
+        const double sign = ((hi >> (axis - static_cast<std::size_t>(low_bits))) & 1U) ? 1.0 : -1.0;
+        for (std::size_t row = 0; row < kProjectionRows; ++row) {
+          high_sum[row] += sign * projection_operator[row * n + axis];
+        }
+      }
+      float* out = out_positions + hi * low_count * 3;
+      for (std::size_t lo = 0; lo < low_count; ++lo) {
+        out[lo * 3 + 0] = static_cast<float>(low_sums[lo * 3 + 0] + high_sum[0]);
+        out[lo * 3 + 1] = static_cast<float>(low_sums[lo * 3 + 1] + high_sum[1]);
+        out[lo * 3 + 2] = static_cast<float>(low_sums[lo * 3 + 2] + high_sum[2]);
       }
-      out_positions[vertex * 3 + component] = sum;
     }
+  });
+}
+
+void project_simplex(int dimension, const float* projection_operator, float* out_positions) {
+  if (simplex_vertex_count(dimension) == 0 || projection_operator == nullptr || out_positions == nullptr) {
+    return;
+  }
+  const std::size_t n = static_cast<std::size_t>(dimension);
+  out_positions[0] = 0.0f;
+  out_positions[1] = 0.0f;
+  out_positions[2] = 0.0f;
+  for (std::size_t axis = 0; axis < n; ++axis) {
+    for (std::size_t row = 0; row < kProjectionRows; ++row) {
+      out_positions[(axis + 1) * 3 + row] = projection_operator[row * n + axis];
+    }
+  }
+}
+
+void project_orthoplex(int dimension, const float* projection_operator, float* out_positions) {
+  if (orthoplex_vertex_count(dimension) == 0 || projection_operator == nullptr || out_positions == nullptr) {
+    return;
+  }
+  const std::size_t n = static_cast<std::size_t>(dimension);
+  for (std::size_t axis = 0; axis < n; ++axis) {
+    for (std::size_t row = 0; row < kProjectionRows; ++row) {
+      const float value = projection_operator[row * n + axis];
+      out_positions[(axis * 2) * 3 + row] = value;
+      out_positions[(axis * 2 + 1) * 3 + row] = -value;
+    }
+  }
+}
+
+void project_to_3d(ConstBufferView vertices, std::size_t dimension, std::size_t vertex_count, const float* rotation_matrix,
+                   std::size_t rotation_stride, ConstBasis3 basis, float* out_positions) {
+  if (vertices.data == nullptr || rotation_matrix == nullptr || basis.data == nullptr || out_positions == nullptr) {
+    return;
+  }
+  if (dimension == 0 || vertex_count == 0) {
+    return;
+  }
+  if (vertices.length < dimension * vertex_count) {
+    return;
   }
+  if (basis.dimension != dimension || basis.stride < dimension) {
+    return;
+  }
+  if (rotation_stride == 0) {
+    rotation_stride = dimension;
+  }
+
+  // Build M = basis3^T * R once, then stream the SoA columns through a 3n kernel
+  // instead of paying n^2 + 3n per vertex.
+  AutoBuffer projection_operator(kProjectionRows * dimension);
+  build_projection_operator(rotation_matrix, rotation_stride, basis, projection_operator.data);
+  project_with_operator(vertices, dimension, vertex_count, projection_operator.data, out_positions);
 }
 
 }  // namespace ndvis
@@ -0,0 +1,395 @@
+#include "ndvis/detail/projection_kernels.hpp"
+
+#include <cstddef>
+
+#include "ndvis/detail/dimension_dispatch.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define NDVIS_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define NDVIS_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__wasm_simd128__)
+#define NDVIS_SIMD_WASM 1
+#include <wasm_simd128.h>
+#endif
+
+// Built with -ffp-contract=off (see CMakeLists.txt): no compiler may fuse the distance kernels' multiply
+// and add, so every level rounds like the scalar kernel.
+
+namespace ndvis::detail {
+
+namespace {
+
+// Vertices per tile; x/y/z accumulators for one tile stay resident in L1.
+constexpr std::size_t kProjectionTile = 64;
+
+void project_scalar(const float* vertices, std::size_t vertex_count, std::size_t dimension,
+                    const float* projection_operator, float* out_positions, std::size_t begin, std::size_t end) {
+  const float* row_x = projection_operator;
+  const float* row_y = projection_operator + dimension;
+  const float* row_z = projection_operator + 2 * dimension;
+
+  float acc_x[kProjectionTile];
+  float acc_y[kProjectionTile];
+  float acc_z[kProjectionTile];
+
+  for (std::size_t base = begin; base < end; base += kProjectionTile) {
+    const std::size_t tile = (end - base) < kProjectionTile ? (end - base) : kProjectionTile;
+    for (std::size_t v = 0; v < tile; ++v) {
+      acc_x[v] = 0.0f;
+      acc_y[v] = 0.0f;
+      acc_z[v] = 0.0f;
+    }
+
+    // Stream each contiguous axis column once per tile.
+    NDVIS_UNROLL_DIMENSION
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      const float* column = vertices + axis * vertex_count + base;
+      const float mx = row_x[axis];
+      const float my = row_y[axis];
+      const float mz = row_z[axis];
+      for (std::size_t v = 0; v < tile; ++v) {
+        const float value = column[v];
+        acc_x[v] += mx * value;
+        acc_y[v] += my * value;
+        acc_z[v] += mz * value;
+      }
+    }
+
+    float* out = out_positions + base * 3;
+    for (std::size_t v = 0; v < tile; ++v) {
+      out[v * 3 + 0] = acc_x[v];
+      out[v * 3 + 1] = acc_y[v];
+      out[v * 3 + 2] = acc_z[v];
+    }
+  }
+}
+
+void distance_scalar(const float* vertices, std::size_t vertex_count, std::size_t dimension, const float* normal,
+                     float offset, float* out_distances, std::size_t begin, std::size_t end) {
+  float acc[kProjectionTile];
+  for (std::size_t base = begin; base < end; base += kProjectionTile) {
+    const std::size_t tile = (end - base) < kProjectionTile ? (end - base) : kProjectionTile;
+    for (std::size_t v = 0; v < tile; ++v) {
+      acc[v] = 0.0f;
+    }
+    NDVIS_UNROLL_DIMENSION
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      const float* column = vertices + axis * vertex_count + base;
+      const float weight = normal[axis];
+      for (std::size_t v = 0; v < tile; ++v) {
+        acc[v] += column[v] * weight;
+      }
+    }
+    for (std::size_t v = 0; v < tile; ++v) {
+      out_distances[base + v] = acc[v] - offset;
+    }
+  }
+}
+
+#if defined(NDVIS_SIMD_X86)
+
+// Interleave four x, y and z lanes into x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3 (SSE2 baseline).
+inline void store_xyz4(float* out, __m128 x, __m128 y, __m128 z) {
+  const __m128 xy_lo = _mm_unpacklo_ps(x, y);
+  const __m128 xy_hi = _mm_unpackhi_ps(x, y);
+  const __m128 yz_lo = _mm_unpacklo_ps(y, z);
+  const __m128 yz_hi = _mm_unpackhi_ps(y, z);
+  const __m128 zx_lo = _mm_unpacklo_ps(z, x);
+  const __m128 zx_hi = _mm_unpackhi_ps(z, x);
+  _mm_storeu_ps(out + 0, _mm_shuffle_ps(xy_lo, zx_lo, _MM_SHUFFLE(3, 0, 1, 0)));
+  _mm_storeu_ps(out + 4, _mm_shuffle_ps(yz_lo, xy_hi, _MM_SHUFFLE(1, 0, 3, 2)));
+  _mm_storeu_ps(out + 8, _mm_shuffle_ps(zx_hi, yz_hi, _MM_SHUFFLE(3, 2, 3, 0)));
+}
+
+__attribute__((target("sse4.1"))) void project_sse41(const float* vertices, std::size_t vertex_count,
+                                                     std::size_t dimension, const float* projection_operator,
+                                                     float* out_positions, std::size_t begin, std::size_t end) {
+  const float* row_x = projection_operator;
+  const float* row_y = projection_operator + dimension;
+  const float* row_z = projection_operator + 2 * dimension;
+
+  std::size_t v = begin;
+  for (; v + 4 <= end; v += 4) {
+    __m128 x = _mm_setzero_ps();
+    __m128 y = _mm_setzero_ps();
+    __m128 z = _mm_setzero_ps();
+    NDVIS_UNROLL_DIMENSION
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      const __m128 column = _mm_loadu_ps(vertices + axis * vertex_count + v);
+      x = _mm_add_ps(x, _mm_mul_ps(_mm_set1_ps(row_x[axis]), column));
+      y = _mm_add_ps(y, _mm_mul_ps(_mm_set1_ps(row_y[axis]), column));
+      z = _mm_add_ps(z, _mm_mul_ps(_mm_set1_ps(row_z[axis]), column));
+    }
+    store_xyz4(out_positions + v * 3, x, y, z);
+  }
+  project_scalar(vertices, vertex_count, dimension, projection_operator, out_positions, v, end);
+}
+
+__attribute__((target("avx2,fma"))) void project_avx2(const float* vertices, std::size_t vertex_count,
+                                                      std::size_t dimension, const float* projection_operator,
+                                                      float* out_positions, std::size_t begin, std::size_t end) {
+  const float* row_x = projection_operator;
+  const float* row_y = projection_operator + dimension;
+  const float* row_z = projection_operator + 2 * dimension;
+
+  std::size_t v = begin;
+  for (; v + 8 <= end; v += 8) {
+    __m256 x = _mm256_setzero_ps();
+    __m256 y = _mm256_setzero_ps();
+    __m256 z = _mm256_setzero_ps();
+    NDVIS_UNROLL_DIMENSION
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      const __m256 column = _mm256_loadu_ps(vertices + axis * vertex_count + v);
+      x = _mm256_fmadd_ps(_mm256_set1_ps(row_x[axis]), column, x);
+      y = _mm256_fmadd_ps(_mm256_set1_ps(row_y[axis]), column, y);
+      z = _mm256_fmadd_ps(_mm256_set1_ps(row_z[axis]), column, z);
+    }
+    float* out = out_positions + v * 3;
+    store_xyz4(out, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z));
+    store_xyz4(out + 12, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1));
+  }
+  project_scalar(vertices, vertex_count, dimension, projection_operator, out_positions, v, end);
+}
+
+__attribute__((target("avx512f"))) void project_avx512(const float* vertices, std::size_t vertex_count,
+                                                       std::size_t dimension, const float* projection_operator,
+                                                       float* out_positions, std::size_t begin, std::size_t end) {
+  const float* row_x = projection_operator;
+  const float* row_y = projection_operator + dimension;
+  const float* row_z = projection_operator + 2 * dimension;
+
+  std::size_t v = begin;
+  for (; v + 16 <= end; v += 16) {
+    __m512 x = _mm512_setzero_ps();
+    __m512 y = _mm512_setzero_ps();
+    __m512 z = _mm512_setzero_ps();
+    NDVIS_UNROLL_DIMENSION
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      const __m512 column = _mm512_loadu_ps(vertices + axis * vertex_count + v);
+      x = _mm512_fmadd_ps(_mm512_set1_ps(row_x[axis]), column, x);
+      y = _mm512_fmadd_ps(_mm512_set1_ps(row_y[axis]), column, y);
+      z = _mm512_fmadd_ps(_mm512_set1_ps(row_z[axis]), column, z);
+    }
+    // Spill through L1 rather than extracting 128-bit quarters (GCC 12 warns spuriously on the extract intrinsics).
+    alignas(64) float lanes[3][16];
+    _mm512_store_ps(lanes[0], x);
+    _mm512_store_ps(lanes[1], y);
+    _mm512_store_ps(lanes[2], z);
+    float* out = out_positions + v * 3;
+    for (std::size_t quarter = 0; quarter < 4; ++quarter) {
+      store_xyz4(out + quarter * 12, _mm_load_ps(lanes[0] + quarter * 4), _mm_load_ps(lanes[1] + quarter * 4),
+                 _mm_load_ps(lanes[2] + quarter * 4));
+    }
+  }
+  project_scalar(vertices, vertex_count, dimension, projection_operator, out_positions, v, end);
+}
+
+__attribute__((target("sse4.1"))) void distance_sse41(const float* vertices, std::size_t vertex_count,
+                                                      std::size_t dimension, const float* normal, float offset,
+                                                      float* out_distances, std::size_t begin, std::size_t end) {
+  std::size_t v = begin;
+  for (; v + 4 <= end; v += 4) {
+    __m128 sum = _mm_setzero_ps();
+    NDVIS_UNROLL_DIMENSION
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(vertices + axis * vertex_count + v), _mm_set1_ps(normal[axis])));
+    }
+    _mm_storeu_ps(out_distances + v, _mm_sub_ps(sum, _mm_set1_ps(offset)));
+  }
+  distance_scalar(vertices, vertex_count, dimension, normal, offset, out_distances, v, end);
+}
+
+// Plain AVX2 without the fma target, so nothing can be contracted.
+__attribute__((target("avx2"))) void distance_avx2(const float* vertices, std::size_t vertex_count,
+                                                   std::size_t dimension, const float* normal, float offset,
+                                                   float* out_distances, std::size_t begin, std::size_t end) {
+  std::size_t v = begin;
+  for (; v + 8 <= end; v += 8) {
+    __m256 sum = _mm256_setzero_ps();
+    NDVIS_UNROLL_DIMENSION
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(vertices + axis * vertex_count + v),
+                                             _mm256_set1_ps(normal[axis])));
+    }
+    _mm256_storeu_ps(out_distances + v, _mm256_sub_ps(sum, _mm256_set1_ps(offset)));
+  }
+  distance_scalar(vertices, vertex_count, dimension, normal, offset, out_distances, v, end);
+}
+
+__attribute__((target("avx512f"))) void distance_avx512(
+    const float* vertices, std::size_t vertex_count, std::size_t dimension, const float* normal, float offset,
+    float* out_distances, std::size_t begin, std::size_t end) {
+  std::size_t v = begin;
+  for (; v + 16 <= end; v += 16) {
+    __m512 sum = _mm512_setzero_ps();
+    NDVIS_UNROLL_DIMENSION
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      sum = _mm512_add_ps(sum, _mm512_mul_ps(_mm512_loadu_ps(vertices + axis * vertex_count + v),
+                                             _mm512_set1_ps(normal[axis])));
+    }
+    _mm512_storeu_ps(out_distances + v, _mm512_sub_ps(sum, _mm512_set1_ps(offset)));
+  }
+  distance_scalar(vertices, vertex_count, dimension, normal, offset, out_distances, v, end);
+}
+
+#endif  // NDVIS_SIMD_X86
+
+#if defined(NDVIS_SIMD_NEON)
+
+void project_neon(const float* vertices, std::size_t vertex_count, std::size_t dimension,
+                  const float* projection_operator, float* out_positions, std::size_t begin, std::size_t end) {
+  const float* row_x = projection_operator;
+  const float* row_y = projection_operator + dimension;
+  const float* row_z = projection_operator + 2 * dimension;
+
+  std::size_t v = begin;
+  for (; v + 4 <= end; v += 4) {
+    float32x4x3_t xyz;
+    xyz.val[0] = vdupq_n_f32(0.0f);
+    xyz.val[1] = vdupq_n_f32(0.0f);
+    xyz.val[2] = vdupq_n_f32(0.0f);
+    NDVIS_UNROLL_DIMENSION
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      const float32x4_t column = vld1q_f32(vertices + axis * vertex_count + v);
+      xyz.val[0] = vmlaq_n_f32(xyz.val[0], column, row_x[axis]);
+      xyz.val[1] = vmlaq_n_f32(xyz.val[1], column, row_y[axis]);
+      xyz.val[2] = vmlaq_n_f32(xyz.val[2], column, row_z[axis]);
+    }
+    vst3q_f32(out_positions + v * 3, xyz);  // st3 interleaves x/y/z natively
+  }
+  project_scalar(vertices, vertex_count, dimension, projection_operator, out_positions, v, end);
+}
+
+void distance_neon(const float* vertices, std::size_t vertex_count, std::size_t dimension, const float* normal,
+                   float offset, float* out_distances, std::size_t begin, std::size_t end) {
+  std::size_t v = begin;
+  for (; v + 4 <= end; v += 4) {
+    float32x4_t sum = vdupq_n_f32(0.0f);
+    NDVIS_UNROLL_DIMENSION
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      sum = vaddq_f32(sum, vmulq_n_f32(vld1q_f32(vertices + axis * vertex_count + v), normal[axis]));
+    }
+    vst1q_f32(out_distances + v, vsubq_f32(sum, vdupq_n_f32(offset)));
+  }
+  distance_scalar(vertices, vertex_count, dimension, normal, offset, out_distances, v, end);
+}
+
+#endif  // NDVIS_SIMD_NEON
+
+#if defined(NDVIS_SIMD_WASM)
+
+void project_wasm_simd128(const float* vertices, std::size_t vertex_count, std::size_t dimension,
+                          const float* projection_operator, float* out_positions, std::size_t begin,
+                          std::size_t end) {
+  const float* row_x = projection_operator;
+  const float* row_y = projection_operator + dimension;
+  const float* row_z = projection_operator + 2 * dimension;
+
+  std::size_t v = begin;
+  for (; v + 4 <= end; v += 4) {
+    v128_t x = wasm_f32x4_splat(0.0f);
+    v128_t y = wasm_f32x4_splat(0.0f);
+    v128_t z = wasm_f32x4_splat(0.0f);
+    NDVIS_UNROLL_DIMENSION
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      const v128_t column = wasm_v128_load(vertices + axis * vertex_count + v);
+      x = wasm_f32x4_add(x, wasm_f32x4_mul(wasm_f32x4_splat(row_x[axis]), column));
+      y = wasm_f32x4_add(y, wasm_f32x4_mul(wasm_f32x4_splat(row_y[axis]), column));
+      z = wasm_f32x4_add(z, wasm_f32x4_mul(wasm_f32x4_splat(row_z[axis]), column));
+    }
+    const v128_t xy_lo = wasm_i32x4_shuffle(x, y, 0, 4, 1, 5);
+    const v128_t xy_hi = wasm_i32x4_shuffle(x, y, 2, 6, 3, 7);
+    const v128_t yz_lo = wasm_i32x4_shuffle(y, z, 0, 4, 1, 5);
+    const v128_t yz_hi = wasm_i32x4_shuffle(y, z, 2, 6, 3, 7);
+    const v128_t zx_lo = wasm_i32x4_shuffle(z, x, 0, 4, 1, 5);
+    const v128_t zx_hi = wasm_i32x4_shuffle(z, x, 2, 6, 3, 7);
+    float* out = out_positions + v * 3;
+    wasm_v128_store(out + 0, wasm_i32x4_shuffle(xy_lo, zx_lo, 0, 1, 4, 7));
+    wasm_v128_store(out + 4, wasm_i32x4_shuffle(yz_lo, xy_hi, 2, 3, 4, 5));
+    wasm_v128_store(out + 8, wasm_i32x4_shuffle(zx_hi, yz_hi, 0, 3, 6, 7));
+  }
+  project_scalar(vertices, vertex_count, dimension, projection_operator, out_positions, v, end);
+}
+
+void distance_wasm_simd128(const float* vertices, std::size_t vertex_count, std::size_t dimension,
+                           const float* normal, float offset, float* out_distances, std::size_t begin,
+                           std::size_t end) {
+  std::size_t v = begin;
+  for (; v + 4 <= end; v += 4) {
+    v128_t sum = wasm_f32x4_splat(0.0f);
+    NDVIS_UNROLL_DIMENSION
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      sum = wasm_f32x4_add(sum, wasm_f32x4_mul(wasm_v128_load(vertices + axis * vertex_count + v),
+                                               wasm_f32x4_splat(normal[axis])));
+    }
+    wasm_v128_store(out_distances + v, wasm_f32x4_sub(sum, wasm_f32x4_splat(offset)));
+  }
+  distance_scalar(vertices, vertex_count, dimension, normal, offset, out_distances, v, end);
+}
+
+#endif  // NDVIS_SIMD_WASM
+
+}  // namespace
+
+ProjectKernel select_project_kernel(SimdLevel level) {
+  switch (level) {
+#if defined(NDVIS_SIMD_X86)
+    case SimdLevel::kAvx512:
+      return project_avx512;
+    case SimdLevel::kAvx2:
+      return project_avx2;
+    case SimdLevel::kSse41:
+      return project_sse41;
+#endif
+#if defined(NDVIS_SIMD_NEON)
+    case SimdLevel::kNeon:
+      return project_neon;
+#endif
+#if defined(NDVIS_SIMD_WASM)
+    case SimdLevel::kWasmSimd128:
+      return project_wasm_simd128;
+#endif
+    default:
+      return project_scalar;
+  }
+}
+
+ProjectKernel active_project_kernel() {
+  return select_project_kernel(active_simd_level());
+}
+
+DistanceKernel select_distance_kernel(SimdLevel level) {
+  switch (level) {
+#if defined(NDVIS_SIMD_X86)
+    case SimdLevel::kAvx512:
+      return distance_avx512;
+    case SimdLevel::kAvx2:
+      return distance_avx2;
+    case SimdLevel::kSse41:
+      return distance_sse41;
+#endif
+#if defined(NDVIS_SIMD_NEON)
+    case SimdLevel::kNeon:
+      return distance_neon;
+#endif
+#if defined(NDVIS_SIMD_WASM)
+    case SimdLevel::kWasmSimd128:
+      return distance_wasm_simd128;
+#endif
+    default:
+      return distance_scalar;
+  }
+}
+
+DistanceKernel active_distance_kernel() {
+  return select_distance_kernel(active_simd_level());
+}
+
+}  // namespace ndvis::detail
@@ -1,58 +1,280 @@
 #include "ndvis/qr.hpp"
 
+#include <cmath>
 #include <cstddef>
 
+#include "ndvis/detail/dimension_dispatch.hpp"
+
 namespace ndvis {
 
 namespace {
-struct AutoBuffer {
-  AutoBuffer(std::size_t size) : data(size ? new float[size] : nullptr), length(size) {}
-  ~AutoBuffer() { delete[] data; }
-  float* data;
-  std::size_t length;
-};
-}  // namespace
+constexpr int kNewtonSchulzMaxIterations = 12;
+// The result is stored as float, so stop once the residual is below float resolution.
+constexpr double kNewtonSchulzTolerance = 1e-8;
+// ||X^T X - I||_F above which the cubic iteration is not trusted to converge.
+constexpr double kNewtonSchulzMaxDrift = 0.5;
 
-void reorthonormalize(float* matrix, std::size_t order) {
-  if (matrix == nullptr || order == 0) {
-    return;
+std::size_t householder_workspace_size(std::size_t order) {
+  return 2 * order * order + 3 * order;
+}
+
+std::size_t newton_schulz_workspace_size(std::size_t order) {
+  return 3 * order * order;
+}
+
+// target <- (I - beta v v^T) target on rows first..order-1 and columns column_begin..order-1, with v
+// stored in column `first` of `reflectors` (rows first..). Both passes walk contiguous rows.
+// sums: order doubles of scratch.
+void apply_reflector(const double* reflectors, std::size_t first, double beta, double* target,
+                     std::size_t column_begin, std::size_t order, double* sums) {
+  for (std::size_t col = column_begin; col < order; ++col) {
+    sums[col] = 0.0;
   }
+  for (std::size_t row = first; row < order; ++row) {
+    const double v = reflectors[row * order + first];
+    const double* target_row = target + row * order;
+    for (std::size_t col = column_begin; col < order; ++col) {
+      sums[col] += v * target_row[col];
+    }
+  }
+  for (std::size_t row = first; row < order; ++row) {
+    const double scaled = beta * reflectors[row * order + first];
+    double* target_row = target + row * order;
+    for (std::size_t col = column_begin; col < order; ++col) {
+      target_row[col] -= scaled * sums[col];
+    }
+  }
+}
 
-  AutoBuffer column(order);
+// Q of A = QR with R's diagonal made positive, i.e. the same basis Gram-Schmidt produces.
+void householder(float* matrix, std::size_t order, double* workspace) {
+  double* a = workspace;                // reflectors below/on the diagonal, R above
+  double* q = a + order * order;
+  double* betas = q + order * order;
+  double* signs = betas + order;        // sign of R[k][k]
+  double* sums = signs + order;
 
-  for (std::size_t col = 0; col < order; ++col) {
+  for (std::size_t idx = 0; idx < order * order; ++idx) {
+    a[idx] = matrix[idx];
+  }
+
+  for (std::size_t k = 0; k < order; ++k) {
+    double norm_sq = 0.0;
+    for (std::size_t row = k; row < order; ++row) {
+      norm_sq += a[row * order + k] * a[row * order + k];
+    }
+    if (norm_sq == 0.0) {
+      betas[k] = 0.0;  // rank-deficient column: identity reflector
+      signs[k] = 1.0;
+      continue;
+    }
+    const double x0 = a[k * order + k];
+    const double alpha = x0 >= 0.0 ? -std::sqrt(norm_sq) : std::sqrt(norm_sq);  // R[k][k]
+    const double v0 = x0 - alpha;
+    a[k * order + k] = v0;
+    betas[k] = 2.0 / (norm_sq - x0 * x0 + v0 * v0);
+    signs[k] = alpha < 0.0 ? -1.0 : 1.0;
+    apply_reflector(a, k, betas[k], a, k + 1, order, sums);
+  }
+
+  // Q = H_0 H_1 ... H_{n-1}: apply the reflectors to I from the last one back. H_k only touches
+  // rows and columns >= k of the partial product.
+  for (std::size_t idx = 0; idx < order * order; ++idx) {
+    q[idx] = 0.0;
+  }
+  for (std::size_t d = 0; d < order; ++d) {
+    q[d * order + d] = 1.0;
+  }
+  for (std::size_t k = order; k-- > 0;) {
+    if (betas[k] != 0.0) {
+      apply_reflector(a, k, betas[k], q, k, order, sums);
+    }
+  }
+
+  for (std::size_t row = 0; row < order; ++row) {
+    for (std::size_t col = 0; col < order; ++col) {
+      matrix[row * order + col] = static_cast<float>(q[row * order + col] * signs[col]);
+    }
+  }
+}
+
+// gram = X^T X - I, accumulated as a sum of row outer products (upper triangle, then mirrored);
+// returns ||gram||_F.
+double gram_residual(const double* x, std::size_t order, double* gram) {
+  for (std::size_t idx = 0; idx < order * order; ++idx) {
+    gram[idx] = 0.0;
+  }
+  for (std::size_t k = 0; k < order; ++k) {
+    const double* x_row = x + k * order;
+    for (std::size_t i = 0; i < order; ++i) {
+      const double weight = x_row[i];
+      double* gram_row = gram + i * order;
+      for (std::size_t j = i; j < order; ++j) {
+        gram_row[j] += weight * x_row[j];
+      }
+    }
+  }
+  double residual = 0.0;
+  for (std::size_t i = 0; i < order; ++i) {
+    gram[i * order + i] -= 1.0;
+    residual += gram[i * order + i] * gram[i * order + i];
+    for (std::size_t j = i + 1; j < order; ++j) {
+      gram[j * order + i] = gram[i * order + j];
+      residual += 2.0 * gram[i * order + j] * gram[i * order + j];
+    }
+  }
+  return std::sqrt(residual);
+}
+
+// Polar factor of `matrix`. Returns false when the input is too far from orthogonal.
+bool newton_schulz(float* matrix, std::size_t order, double* workspace) {
+  double* x = workspace;
+  double* gram = x + order * order;
+  double* next = gram + order * order;
+
+  for (std::size_t idx = 0; idx < order * order; ++idx) {
+    x[idx] = matrix[idx];
+  }
+
+  double residual = gram_residual(x, order, gram);
+  if (residual > kNewtonSchulzMaxDrift) {
+    return false;
+  }
+  for (int iteration = 0; iteration < kNewtonSchulzMaxIterations && residual > kNewtonSchulzTolerance;
+       ++iteration) {
+    // X (3I - X^T X) / 2 = X - X (X^T X - I) / 2
     for (std::size_t row = 0; row < order; ++row) {
-      column.data[row] = matrix[row * order + col];
+      const double* x_row = x + row * order;
+      double* next_row = next + row * order;
+      for (std::size_t col = 0; col < order; ++col) {
+        next_row[col] = x_row[col];
+      }
+      for (std::size_t k = 0; k < order; ++k) {
+        const double weight = 0.5 * x_row[k];
+        const double* gram_row = gram + k * order;
+        for (std::size_t col = 0; col < order; ++col) {
+          next_row[col] -= weight * gram_row[col];
+        }
+      }
+    }
+    double* swap = x;
+    x = next;
+    next = swap;
+    residual = gram_residual(x, order, gram);
+  }
+  if (residual > kNewtonSchulzTolerance) {
+    return false;
+  }
+
+  for (std::size_t idx = 0; idx < order * order; ++idx) {
+    matrix[idx] = static_cast<float>(x[idx]);
+  }
+  return true;
+}
+
+// Modified Gram-Schmidt in float. Order != 0 fixes the order at compile time: the column is copied to a
+// stack scratch and the row loops unroll (see dimension_dispatch.hpp). The generic instance works on the
+// strided column in place, so no order allocates; the arithmetic is the same either way.
+template <std::size_t Order>
+void gram_schmidt(float* matrix, std::size_t order) {
+  order = detail::fixed_or<Order>(order);
+  constexpr bool kInPlace = Order == 0;
+  float stack_column[Order == 0 ? 1 : Order];
+  const std::size_t stride = kInPlace ? order : 1;
+
+  for (std::size_t col = 0; col < order; ++col) {
+    float* column = kInPlace ? matrix + col : stack_column;
+    if (!kInPlace) {
+      NDVIS_UNROLL_DIMENSION
+      for (std::size_t row = 0; row < order; ++row) {
+        column[row] = matrix[row * order + col];
+      }
     }
 
     for (std::size_t prev = 0; prev < col; ++prev) {
       float dot = 0.0f;
+      NDVIS_UNROLL_DIMENSION
       for (std::size_t row = 0; row < order; ++row) {
-        dot += matrix[row * order + prev] * column.data[row];
+        dot += matrix[row * order + prev] * column[row * stride];
       }
+      NDVIS_UNROLL_DIMENSION
       for (std::size_t row = 0; row < order; ++row) {
-        column.data[row] -= dot * matrix[row * order + prev];
+        column[row * stride] -= dot * matrix[row * order + prev];
       }
     }
 
     float norm = 0.0f;
+    NDVIS_UNROLL_DIMENSION
     for (std::size_t row = 0; row < order; ++row) {
-      const float value = column.data[row];
+      const float value = column[row * stride];
       norm += value * value;
     }
 
     if (norm <= 0.0f) {
       for (std::size_t row = 0; row < order; ++row) {
-        column.data[row] = (row == col) ? 1.0f : 0.0f;
+        column[row * stride] = (row == col) ? 1.0f : 0.0f;
       }
       norm = 1.0f;
     }
 
     const float inv_norm = 1.0f / static_cast<float>(__builtin_sqrtf(norm));
+    NDVIS_UNROLL_DIMENSION
     for (std::size_t row = 0; row < order; ++row) {
-      matrix[row * order + col] = column.data[row] * inv_norm;
+      matrix[row * order + col] = column[row * stride] * inv_norm;
     }
   }
 }
 
+using GramSchmidtFn = void (*)(float*, std::size_t);
+
+struct GramSchmidtMaker {
+  template <std::size_t Order>
+  static constexpr GramSchmidtFn get() {
+    return &gram_schmidt<Order>;
+  }
+};
+
+}  // namespace
+
+void reorthonormalize(float* matrix, std::size_t order) {
+  if (matrix == nullptr || order == 0) {
+    return;
+  }
+  detail::select_for_dimension<GramSchmidtMaker>(order)(matrix, order);
+}
+
+std::size_t reorthonormalize_workspace_size(std::size_t order, OrthonormalizeMethod method) {
+  switch (method) {
+    case OrthonormalizeMethod::kModifiedGramSchmidt:
+      return 0;
+    case OrthonormalizeMethod::kHouseholder:
+      return householder_workspace_size(order);
+    case OrthonormalizeMethod::kNewtonSchulz: {
+      const std::size_t polar = newton_schulz_workspace_size(order);
+      const std::size_t fallback = householder_workspace_size(order);
+      return polar > fallback ? polar : fallback;
+    }
+  }
+  return 0;
+}
+
+bool reorthonormalize(float* matrix, std::size_t order, OrthonormalizeMethod method, double* workspace,
+                      std::size_t workspace_length) {
+  if (matrix == nullptr || order == 0) {
+    return false;
+  }
+  if (method == OrthonormalizeMethod::kModifiedGramSchmidt) {
+    reorthonormalize(matrix, order);
+    return true;
+  }
+  if (workspace == nullptr || workspace_length < reorthonormalize_workspace_size(order, method)) {
+    return false;
+  }
+  if (method == OrthonormalizeMethod::kNewtonSchulz && newton_schulz(matrix, order, workspace)) {
+    return true;
+  }
+  householder(matrix, order, workspace);
+  return true;
+}
+
 }  // namespace ndvis
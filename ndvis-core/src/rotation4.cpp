@@ -0,0 +1,101 @@
+#include "ndvis/rotation4.hpp"
+
+#include <cmath>
+
+namespace ndvis {
+
+namespace {
+
+constexpr unsigned int kOrder = 4;
+
+Quaternion multiply(const Quaternion& a, const Quaternion& b) {
+  return Quaternion{
+      a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+      a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+      a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+      a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+  };
+}
+
+Quaternion conjugate(const Quaternion& q) {
+  return Quaternion{q.w, -q.x, -q.y, -q.z};
+}
+
+// Unit quaternion for coordinate axis 0..3, ordered (w, x, y, z).
+Quaternion basis_quaternion(unsigned int axis) {
+  switch (axis) {
+    case 0:
+      return Quaternion{1.0f, 0.0f, 0.0f, 0.0f};
+    case 1:
+      return Quaternion{0.0f, 1.0f, 0.0f, 0.0f};
+    case 2:
+      return Quaternion{0.0f, 0.0f, 1.0f, 0.0f};
+    default:
+      return Quaternion{0.0f, 0.0f, 0.0f, 1.0f};
+  }
+}
+
+// exp(angle * u) for a pure unit quaternion u
+Quaternion exp_pure(const Quaternion& u, float angle) {
+  const float s = std::sin(angle);
+  return Quaternion{std::cos(angle), u.x * s, u.y * s, u.z * s};
+}
+
+// Products of unit quaternions drift off the unit sphere only by rounding; pull them back.
+void normalize(Quaternion& q) {
+  const float norm_sq = q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z;
+  const float inv = 1.0f / std::sqrt(norm_sq);
+  q.w *= inv;
+  q.x *= inv;
+  q.y *= inv;
+  q.z *= inv;
+}
+
+}  // namespace
+
+void apply_givens4(Rotation4& rotation, RotationPlane plane) {
+  if (plane.i >= kOrder || plane.j >= kOrder) {
+    return;
+  }
+  if (plane.i == plane.j) {
+    // apply_givens degenerates to scaling column i by c + s; not a rotation, so not representable.
+    return;
+  }
+  // G turns e_i away from e_j, i.e. a rotation by -theta from p = e_i towards q = e_j. A simple
+  // rotation by phi in that plane is v -> exp(phi/2 q p*) v exp(phi/2 p* q).
+  const Quaternion p = basis_quaternion(plane.i);
+  const Quaternion q = basis_quaternion(plane.j);
+  const float half_angle = -0.5f * plane.theta;
+  const Quaternion left_step = exp_pure(multiply(q, conjugate(p)), half_angle);
+  const Quaternion right_step = exp_pure(multiply(conjugate(p), q), half_angle);
+
+  // (R G) v = left (l v r) right
+  rotation.left = multiply(rotation.left, left_step);
+  rotation.right = multiply(right_step, rotation.right);
+  normalize(rotation.left);
+  normalize(rotation.right);
+}
+
+void apply_rotations4(Rotation4& rotation, const RotationPlane* planes, std::size_t plane_count) {
+  if (planes == nullptr) {
+    return;
+  }
+  for (std::size_t idx = 0; idx < plane_count; ++idx) {
+    apply_givens4(rotation, planes[idx]);
+  }
+}
+
+void rotation4_to_matrix(const Rotation4& rotation, float* out_matrix) {
+  if (out_matrix == nullptr) {
+    return;
+  }
+  for (unsigned int col = 0; col < kOrder; ++col) {
+    const Quaternion image = multiply(multiply(rotation.left, basis_quaternion(col)), rotation.right);
+    const float components[kOrder] = {image.w, image.x, image.y, image.z};
+    for (unsigned int row = 0; row < kOrder; ++row) {
+      out_matrix[row * kOrder + col] = components[row];
+    }
+  }
+}
+
+}  // namespace ndvis
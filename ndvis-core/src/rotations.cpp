@@ -1,7 +1,120 @@
 #include "ndvis/rotations.hpp"
 
+#include <vector>
+
+#include "ndvis/detail/dimension_dispatch.hpp"
+
 namespace ndvis {
 
+namespace {
+
+// Plane batches up to this size (all 66 planes of n = 12, 120 of n = 16) stay on the stack.
+constexpr std::size_t kStackRotations = 128;
+// Rows per transposed tile in the blocked sweep; one AVX vector or two SSE/NEON vectors per column.
+constexpr std::size_t kRowBlock = 8;
+// Below this order the matrix is a few cache lines and per-plane application is already cheapest.
+constexpr std::size_t kFusedMinOrder = 8;
+// Tiles up to this order stay on the stack.
+constexpr std::size_t kStackTileOrder = 64;
+
+void sweep_row(float* row, const GivensRotation* rotations, std::size_t rotation_count) {
+  for (std::size_t k = 0; k < rotation_count; ++k) {
+    const GivensRotation g = rotations[k];
+    const float a = row[g.i];
+    const float b = row[g.j];
+    row[g.i] = g.c * a - g.s * b;
+    row[g.j] = g.s * a + g.c * b;
+  }
+}
+
+// tile: order * kRowBlock floats, column-major, so column `col` of the block is tile[col * kRowBlock ...].
+// A short final block (row_count < kRowBlock) runs with zero-padded lanes that are never written back.
+// Order != 0 fixes the matrix order at compile time so the tile transposes unroll (see dimension_dispatch.hpp).
+template <std::size_t Order>
+void sweep_row_block(float* block, std::size_t order, std::size_t row_count, const GivensRotation* rotations,
+                     std::size_t rotation_count, float* tile) {
+  order = detail::fixed_or<Order>(order);
+  for (std::size_t lane = 0; lane < kRowBlock; ++lane) {
+    NDVIS_UNROLL_DIMENSION
+    for (std::size_t col = 0; col < order; ++col) {
+      tile[col * kRowBlock + lane] = lane < row_count ? block[lane * order + col] : 0.0f;
+    }
+  }
+
+  for (std::size_t k = 0; k < rotation_count; ++k) {
+    const GivensRotation g = rotations[k];
+    float* column_i = tile + g.i * kRowBlock;
+    float* column_j = tile + g.j * kRowBlock;
+    // Load both columns before storing so i == j behaves exactly like apply_givens.
+    float a[kRowBlock];
+    float b[kRowBlock];
+    for (std::size_t lane = 0; lane < kRowBlock; ++lane) {
+      a[lane] = column_i[lane];
+      b[lane] = column_j[lane];
+    }
+    for (std::size_t lane = 0; lane < kRowBlock; ++lane) {
+      column_i[lane] = g.c * a[lane] - g.s * b[lane];
+    }
+    for (std::size_t lane = 0; lane < kRowBlock; ++lane) {
+      column_j[lane] = g.s * a[lane] + g.c * b[lane];
+    }
+  }
+
+  for (std::size_t lane = 0; lane < row_count; ++lane) {
+    NDVIS_UNROLL_DIMENSION
+    for (std::size_t col = 0; col < order; ++col) {
+      block[lane * order + col] = tile[col * kRowBlock + lane];
+    }
+  }
+}
+
+using SweepRowBlockFn = void (*)(float*, std::size_t, std::size_t, const GivensRotation*, std::size_t, float*);
+
+struct SweepRowBlockMaker {
+  template <std::size_t Order>
+  static constexpr SweepRowBlockFn get() {
+    return &sweep_row_block<Order>;
+  }
+};
+
+// Frobenius norm of R^T R - I; every Order instantiation performs the same operations in the same order.
+template <std::size_t Order>
+float orthogonality_drift(const float* matrix, std::size_t order) {
+  order = detail::fixed_or<Order>(order);
+  float drift = 0.0f;
+
+  for (std::size_t i = 0; i < order; ++i) {
+    for (std::size_t j = 0; j < order; ++j) {
+      // Compute (R^T R)_ij = sum_k R[k,i] * R[k,j]
+      float rtR_ij = 0.0f;
+      NDVIS_UNROLL_DIMENSION
+      for (std::size_t k = 0; k < order; ++k) {
+        rtR_ij += matrix[k * order + i] * matrix[k * order + j];
+      }
+
+      // Subtract I_ij (1 if i==j, else 0)
+      if (i == j) {
+        rtR_ij -= 1.0f;
+      }
+
+      drift += rtR_ij * rtR_ij;
+    }
+  }
+
+  return __builtin_sqrtf(drift);
+}
+
+using DriftFn = float (*)(const float*, std::size_t);
+
+struct DriftMaker {
+  template <std::size_t Order>
+  static constexpr DriftFn get() {
+    return &orthogonality_drift<Order>;
+  }
+};
+
+}  // namespace
+
 void apply_givens(float* matrix, std::size_t order, RotationPlane plane) {
   if (matrix == nullptr || order == 0 || plane.i >= order || plane.j >= order) {
     return;
@@ -22,13 +135,69 @@ void apply_givens(float* matrix, std::size_t order, RotationPlane plane) {
   }
 }
 
+std::size_t prepare_givens(const RotationPlane* planes, std::size_t plane_count, std::size_t order,
+                           GivensRotation* out_rotations) {
+  if (planes == nullptr || out_rotations == nullptr) {
+    return 0;
+  }
+  std::size_t count = 0;
+  for (std::size_t idx = 0; idx < plane_count; ++idx) {
+    const RotationPlane plane = planes[idx];
+    if (plane.i >= order || plane.j >= order) {
+      continue;
+    }
+    out_rotations[count++] = GivensRotation{plane.i, plane.j, __builtin_cosf(plane.theta), __builtin_sinf(plane.theta)};
+  }
+  return count;
+}
+
+void apply_givens_batch(float* matrix, std::size_t order, const GivensRotation* rotations,
+                        std::size_t rotation_count) {
+  if (matrix == nullptr || rotations == nullptr || order == 0 || rotation_count == 0) {
+    return;
+  }
+
+  // Rows are independent under R * G, so each one can take the whole plane sequence at once.
+  if (order < kRowBlock) {
+    for (std::size_t row = 0; row < order; ++row) {
+      sweep_row(matrix + row * order, rotations, rotation_count);
+    }
+    return;
+  }
+
+  float stack_tile[kStackTileOrder * kRowBlock];
+  std::vector<float> heap_tile;
+  float* tile = stack_tile;
+  if (order > kStackTileOrder) {
+    heap_tile.resize(order * kRowBlock);
+    tile = heap_tile.data();
+  }
+  const SweepRowBlockFn sweep = detail::select_for_dimension<SweepRowBlockMaker>(order);
+  for (std::size_t row = 0; row < order; row += kRowBlock) {
+    const std::size_t row_count = order - row < kRowBlock ? order - row : kRowBlock;
+    sweep(matrix + row * order, order, row_count, rotations, rotation_count, tile);
+  }
+}
+
 void apply_rotations(float* matrix, std::size_t order, const RotationPlane* planes, std::size_t plane_count) {
-  if (matrix == nullptr || planes == nullptr) {
+  if (matrix == nullptr || planes == nullptr || order == 0) {
     return;
   }
-  for (std::size_t idx = 0; idx < plane_count; ++idx) {
-    apply_givens(matrix, order, planes[idx]);
+  if (order < kFusedMinOrder) {
+    for (std::size_t idx = 0; idx < plane_count; ++idx) {
+      apply_givens(matrix, order, planes[idx]);
+    }
+    return;
+  }
+  GivensRotation stack_rotations[kStackRotations];
+  std::vector<GivensRotation> heap_rotations;
+  GivensRotation* rotations = stack_rotations;
+  if (plane_count > kStackRotations) {
+    heap_rotations.resize(plane_count);
+    rotations = heap_rotations.data();
   }
+  const std::size_t count = prepare_givens(planes, plane_count, order, rotations);
+  apply_givens_batch(matrix, order, rotations, count);
 }
 
 void apply_rotations_incremental(float* matrix, std::size_t order, const RotationPlane* planes, std::size_t plane_count) {
@@ -42,28 +211,8 @@ float compute_orthogonality_drift(const float* matrix, std::size_t order) {
     return 0.0f;
   }
 
-  // Compute R^T R - I and return Frobenius norm
-  // Frobenius norm: sqrt(sum of squared elements)
-  float drift = 0.0f;
-
-  for (std::size_t i = 0; i < order; ++i) {
-    for (std::size_t j = 0; j < order; ++j) {
-      // Compute (R^T R)_ij = sum_k R[k,i] * R[k,j]
-      float rtR_ij = 0.0f;
-      for (std::size_t k = 0; k < order; ++k) {
-        rtR_ij += matrix[k * order + i] * matrix[k * order + j];
-      }
-
-      // Subtract I_ij (1 if i==j, else 0)
-      if (i == j) {
-        rtR_ij -= 1.0f;
-      }
-
-      drift += rtR_ij * rtR_ij;
-    }
-  }
-
-  return __builtin_sqrtf(drift);
+  // Compute R^T R - I and return Frobenius norm, unrolled for orders 2..16.
+  return detail::select_for_dimension<DriftMaker>(order)(matrix, order);
 }
 
 }  // namespace ndvis
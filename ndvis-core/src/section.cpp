@@ -0,0 +1,157 @@
+#include "ndvis/section.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "ndvis/detail/slice_rules.hpp"
+
+namespace ndvis {
+
+namespace {
+
+constexpr index_type kNoSectionVertex = std::numeric_limits<index_type>::max();
+
+// Where a section vertex sits: a polytope vertex (v0 == v1) or a point along edge v0 -> v1.
+struct SectionSource {
+  index_type v0;
+  index_type v1;
+  float t;
+  index_type edge;
+};
+
+}  // namespace
+
+SectionResult slice_section(ConstBufferView vertices, std::size_t vertex_count, std::size_t dimension,
+                            ConstIndexBufferView edges, ConstFaceView faces, const Hyperplane& hyperplane,
+                            BufferView out_points, IndexBufferView out_edges, IndexBufferView out_vertex_edges) {
+  SectionResult result{};
+  if (vertices.data == nullptr || edges.data == nullptr || faces.offsets.data == nullptr ||
+      faces.offsets.length == 0 || out_points.data == nullptr || dimension == 0 || hyperplane.normal == nullptr ||
+      vertices.length < dimension * vertex_count) {
+    return result;
+  }
+  const std::size_t edge_count = edges.length / 2;
+  const std::size_t face_count = faces.offsets.length - 1;
+  for (std::size_t i = 0; i < 2 * edge_count; ++i) {
+    if (edges.data[i] >= vertex_count) {
+      return result;
+    }
+  }
+  // CSR offsets start at zero; any listed face edge needs an edge list long enough to hold it.
+  const std::size_t face_edge_count = faces.offsets.data[face_count];
+  if (faces.offsets.data[0] != 0 ||
+      (face_edge_count > 0 && (faces.edges.data == nullptr || face_edge_count > faces.edges.length))) {
+    return result;
+  }
+  for (std::size_t face = 0; face < face_count; ++face) {
+    if (faces.offsets.data[face] > faces.offsets.data[face + 1]) {
+      return result;
+    }
+  }
+  for (std::size_t i = 0; i < face_edge_count; ++i) {
+    if (faces.edges.data[i] >= edge_count) {
+      return result;
+    }
+  }
+
+  std::vector<float> distances(vertex_count);
+  compute_signed_distances(vertices, vertex_count, dimension, hyperplane, distances.data());
+
+  std::size_t capacity = out_points.length / dimension;
+  if (out_vertex_edges.data && out_vertex_edges.length < capacity) {
+    capacity = out_vertex_edges.length;
+  }
+
+  // Section vertex per crossing edge: on-plane endpoints are keyed by the polytope vertex, so every edge
+  // through it shares one section vertex.
+  std::vector<index_type> edge_section(edge_count, kNoSectionVertex);
+  std::vector<index_type> vertex_section(vertex_count, kNoSectionVertex);
+  std::vector<SectionSource> sources;
+  for (std::size_t e = 0; e < edge_count; ++e) {
+    const index_type v0 = edges.data[2 * e];
+    const index_type v1 = edges.data[2 * e + 1];
+    const int class0 = detail::classify_distance(distances[v0]);
+    const int class1 = detail::classify_distance(distances[v1]);
+    if (!detail::edge_crosses(class0, class1)) {
+      continue;
+    }
+    if (class0 == 0 || class1 == 0) {
+      const index_type on_plane = class0 == 0 ? v0 : v1;
+      index_type& section = vertex_section[on_plane];
+      if (section == kNoSectionVertex && sources.size() < capacity) {
+        section = static_cast<index_type>(sources.size());
+        sources.push_back(SectionSource{on_plane, on_plane, 0.0f, static_cast<index_type>(e)});
+      }
+      result.truncated = result.truncated || section == kNoSectionVertex;
+      edge_section[e] = section;
+      continue;
+    }
+    if (sources.size() >= capacity) {
+      result.truncated = true;
+      continue;
+    }
+    edge_section[e] = static_cast<index_type>(sources.size());
+    sources.push_back(SectionSource{v0, v1, detail::crossing_parameter(distances[v0], distances[v1]),
+                                    static_cast<index_type>(e)});
+  }
+
+  const std::size_t section_vertices = sources.size();
+  for (std::size_t s = 0; s < section_vertices; ++s) {
+    const SectionSource& source = sources[s];
+    for (std::size_t d = 0; d < dimension; ++d) {
+      const float a = vertices.data[d * vertex_count + source.v0];
+      const float b = vertices.data[d * vertex_count + source.v1];
+      out_points.data[d * section_vertices + s] = source.v0 == source.v1 ? a : a + source.t * (b - a);
+    }
+    if (out_vertex_edges.data) {
+      out_vertex_edges.data[s] = source.edge;
+    }
+  }
+
+  // A convex face meets the hyperplane in a segment, a single point or not at all (faces in the plane
+  // contribute nothing here), so a face with exactly two distinct section vertices yields one edge.
+  std::vector<std::pair<index_type, index_type>> pairs;
+  for (std::size_t face = 0; face < face_count; ++face) {
+    index_type first = kNoSectionVertex;
+    index_type second = kNoSectionVertex;
+    bool extra = false;
+    for (index_type i = faces.offsets.data[face]; i < faces.offsets.data[face + 1]; ++i) {
+      const index_type section = edge_section[faces.edges.data[i]];
+      if (section == kNoSectionVertex || section == first || section == second) {
+        continue;
+      }
+      if (first == kNoSectionVertex) {
+        first = section;
+      } else if (second == kNoSectionVertex) {
+        second = section;
+      } else {
+        extra = true;  // only with near-epsilon rounding; the face is ambiguous, so skip it
+      }
+    }
+    if (second != kNoSectionVertex && !extra) {
+      pairs.emplace_back(std::min(first, second), std::max(first, second));
+    }
+  }
+  std::sort(pairs.begin(), pairs.end());
+  pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+  std::size_t section_edges = 0;
+  if (out_edges.data) {
+    section_edges = std::min(pairs.size(), out_edges.length / 2);
+    result.truncated = result.truncated || section_edges < pairs.size();
+  }
+  for (std::size_t i = 0; i < section_edges; ++i) {
+    out_edges.data[2 * i] = pairs[i].first;
+    out_edges.data[2 * i + 1] = pairs[i].second;
+  }
+
+  result.vertex_count = section_vertices;
+  result.edge_count = section_edges;
+  result.points = BufferView{out_points.data, dimension * section_vertices};
+  result.edges = IndexBufferView{out_edges.data, 2 * section_edges};
+  return result;
+}
+
+}  // namespace ndvis
@@ -0,0 +1,97 @@
+#include "ndvis/detail/simd.hpp"
+
+#include <atomic>
+
+namespace ndvis::detail {
+
+namespace {
+
+constexpr int kUnset = -1;
+
+std::atomic<int> g_active_level{kUnset};
+
+SimdLevel probe_cpu() {
+#if defined(__wasm_simd128__)
+  return SimdLevel::kWasmSimd128;
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  return SimdLevel::kNeon;
+#elif (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return SimdLevel::kAvx512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return SimdLevel::kAvx2;
+  }
+  if (__builtin_cpu_supports("sse4.1")) {
+    return SimdLevel::kSse41;
+  }
+  return SimdLevel::kScalar;
+#else
+  return SimdLevel::kScalar;
+#endif
+}
+
+}  // namespace
+
+SimdLevel detect_simd_level() {
+  static const SimdLevel detected = probe_cpu();
+  return detected;
+}
+
+bool simd_level_supported(SimdLevel level) {
+  if (level == SimdLevel::kScalar) {
+    return true;
+  }
+  const SimdLevel detected = detect_simd_level();
+  switch (level) {
+    case SimdLevel::kSse41:
+    case SimdLevel::kAvx2:
+    case SimdLevel::kAvx512:
+      // x86 tiers are nested: AVX-512 hosts can run the AVX2 and SSE4.1 kernels too.
+      return (detected == SimdLevel::kSse41 || detected == SimdLevel::kAvx2 || detected == SimdLevel::kAvx512) &&
+             static_cast<int>(level) <= static_cast<int>(detected);
+    case SimdLevel::kNeon:
+    case SimdLevel::kWasmSimd128:
+      return level == detected;
+    case SimdLevel::kScalar:
+      break;
+  }
+  return true;
+}
+
+SimdLevel active_simd_level() {
+  int level = g_active_level.load(std::memory_order_relaxed);
+  if (level == kUnset) {
+    level = static_cast<int>(detect_simd_level());
+    g_active_level.store(level, std::memory_order_relaxed);
+  }
+  return static_cast<SimdLevel>(level);
+}
+
+void set_simd_level(SimdLevel level) {
+  if (!simd_level_supported(level)) {
+    level = detect_simd_level();
+  }
+  g_active_level.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+const char* simd_level_name(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::kScalar:
+      return "scalar";
+    case SimdLevel::kSse41:
+      return "sse4.1";
+    case SimdLevel::kAvx2:
+      return "avx2";
+    case SimdLevel::kAvx512:
+      return "avx512";
+    case SimdLevel::kNeon:
+      return "neon";
+    case SimdLevel::kWasmSimd128:
+      return "wasm-simd128";
+  }
+  return "unknown";
+}
+
+}  // namespace ndvis::detail
@@ -0,0 +1,164 @@
+#include "ndvis/slice_sweep.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "ndvis/detail/slice_rules.hpp"
+
+namespace ndvis {
+
+bool SliceSweepIndex::build(ConstBufferView vertices, std::size_t vertex_count, std::size_t dimension,
+                            ConstIndexBufferView edges, const float* normal) {
+  *this = SliceSweepIndex{};
+  if (vertices.data == nullptr || normal == nullptr || dimension == 0 || vertices.length < dimension * vertex_count) {
+    return false;
+  }
+  const std::size_t edge_count = edges.length / 2;
+  if (edge_count > 0 && edges.data == nullptr) {
+    return false;
+  }
+  if (edge_count > std::numeric_limits<std::uint32_t>::max()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < 2 * edge_count; ++i) {
+    if (edges.data[i] >= vertex_count) {
+      return false;
+    }
+  }
+
+  // Offset 0 through the shared kernel: slice() subtracts b from the same bits compute_signed_distances
+  // would have produced before its own subtraction.
+  dots_.resize(vertex_count);
+  compute_signed_distances(vertices, vertex_count, dimension, Hyperplane{normal, dimension, 0.0f}, dots_.data());
+  for (const float dot : dots_) {
+    if (!std::isfinite(dot)) {
+      *this = SliceSweepIndex{};
+      return false;
+    }
+  }
+
+  lower_.resize(edge_count);
+  upper_.resize(edge_count);
+  std::vector<index_type> order(edge_count);
+  for (std::size_t e = 0; e < edge_count; ++e) {
+    const float d0 = dots_[edges.data[2 * e]];
+    const float d1 = dots_[edges.data[2 * e + 1]];
+    const float lo = d0 < d1 ? d0 : d1;
+    const float hi = d0 < d1 ? d1 : d0;
+    lower_[e] = lo - detail::crossing_slack(lo);
+    upper_[e] = hi + detail::crossing_slack(hi);
+    order[e] = static_cast<index_type>(e);
+  }
+  by_lo_.reserve(edge_count);
+  by_hi_.reserve(edge_count);
+  build_node(order.data(), order.data() + edge_count);
+
+  vertices_ = vertices.data;
+  edges_ = edges.data;
+  vertex_count_ = vertex_count;
+  dimension_ = dimension;
+  edge_count_ = edge_count;
+  return true;
+}
+
+std::int32_t SliceSweepIndex::build_node(index_type* first, index_type* last) {
+  if (first == last) {
+    return -1;
+  }
+  // Center on the median interval midpoint: at most half the intervals lie wholly on either side, so the
+  // depth stays below log2(E) + 1, and the median interval itself always stays at this node.
+  auto midpoint = [this](index_type e) { return 0.5f * lower_[e] + 0.5f * upper_[e]; };
+  index_type* median = first + (last - first) / 2;
+  std::nth_element(first, median, last, [&](index_type a, index_type b) { return midpoint(a) < midpoint(b); });
+  const float center = midpoint(*median);
+
+  index_type* left_end = std::partition(first, last, [&](index_type e) { return upper_[e] < center; });
+  index_type* middle_end = std::partition(left_end, last, [&](index_type e) { return lower_[e] <= center; });
+
+  const std::int32_t index = static_cast<std::int32_t>(nodes_.size());
+  const auto begin = static_cast<std::uint32_t>(by_lo_.size());
+  for (const index_type* e = left_end; e != middle_end; ++e) {
+    by_lo_.push_back(Bound{lower_[*e], *e});
+    by_hi_.push_back(Bound{upper_[*e], *e});
+  }
+  const auto end = static_cast<std::uint32_t>(by_lo_.size());
+  std::sort(by_lo_.begin() + begin, by_lo_.end(), [](const Bound& a, const Bound& b) { return a.key < b.key; });
+  std::sort(by_hi_.begin() + begin, by_hi_.end(), [](const Bound& a, const Bound& b) { return a.key > b.key; });
+  nodes_.push_back(Node{center, begin, end, -1, -1});
+
+  const std::int32_t left = build_node(first, left_end);
+  const std::int32_t right = build_node(middle_end, last);
+  nodes_[static_cast<std::size_t>(index)].left = left;
+  nodes_[static_cast<std::size_t>(index)].right = right;
+  return index;
+}
+
+void SliceSweepIndex::collect_crossings(float offset) {
+  hits_.clear();
+  auto report = [&](index_type e) {
+    const float d0 = dots_[edges_[2 * e]] - offset;
+    const float d1 = dots_[edges_[2 * e + 1]] - offset;
+    if (detail::edge_crosses_distances(d0, d1)) {
+      hits_.push_back(e);
+    }
+  };
+
+  std::int32_t node = nodes_.empty() ? -1 : 0;
+  while (node >= 0) {
+    const Node& current = nodes_[static_cast<std::size_t>(node)];
+    if (offset < current.center) {
+      for (std::uint32_t i = current.begin; i < current.end && by_lo_[i].key <= offset; ++i) {
+        report(by_lo_[i].edge);
+      }
+      node = current.left;
+    } else if (offset > current.center) {
+      for (std::uint32_t i = current.begin; i < current.end && by_hi_[i].key >= offset; ++i) {
+        report(by_hi_[i].edge);
+      }
+      node = current.right;
+    } else {
+      for (std::uint32_t i = current.begin; i < current.end; ++i) {
+        report(by_lo_[i].edge);
+      }
+      break;
+    }
+  }
+  // slice_polytope reports in edge order
+  std::sort(hits_.begin(), hits_.end());
+}
+
+SliceResult SliceSweepIndex::slice(float offset, BufferView out_points, IndexBufferView out_edge_indices) {
+  SliceResult result{};
+  if (!built() || out_points.data == nullptr) {
+    return result;
+  }
+  collect_crossings(offset);
+
+  std::size_t capacity = out_points.length / dimension_;
+  if (out_edge_indices.data && out_edge_indices.length < capacity) {
+    capacity = out_edge_indices.length;
+  }
+  const std::size_t count = std::min(hits_.size(), capacity);
+  for (std::size_t slot = 0; slot < count; ++slot) {
+    const index_type e = hits_[slot];
+    const index_type v0 = edges_[2 * e];
+    const index_type v1 = edges_[2 * e + 1];
+    const float t = detail::crossing_parameter(dots_[v0] - offset, dots_[v1] - offset);
+    for (std::size_t d = 0; d < dimension_; ++d) {
+      const float a = vertices_[d * vertex_count_ + v0];
+      const float b = vertices_[d * vertex_count_ + v1];
+      out_points.data[d * count + slot] = a + t * (b - a);
+    }
+    if (out_edge_indices.data) {
+      out_edge_indices.data[slot] = e;
+    }
+  }
+
+  result.intersection_count = count;
+  result.intersection_points = BufferView{out_points.data, dimension_ * count};
+  result.intersection_edges = IndexBufferView{out_edge_indices.data, count};
+  return result;
+}
+
+}  // namespace ndvis
@@ -0,0 +1,161 @@
+#include "ndvis/streaming_pca.hpp"
+
+#include "ndvis/detail/covariance.hpp"
+#include "ndvis/detail/jacobi.hpp"
+
+namespace ndvis {
+
+StreamingPca::StreamingPca(std::size_t dimension)
+    : dimension_(dimension),
+      mean_(dimension, 0.0),
+      scatter_(dimension * dimension, 0.0),
+      eigenvectors_(dimension * dimension, 0.0),
+      eigenvalues_(dimension, 0.0),
+      work_(dimension * dimension, 0.0),
+      rotated_(dimension * dimension, 0.0),
+      change_(dimension * dimension, 0.0),
+      batch_mean_(dimension, 0.0),
+      batch_covariance_(dimension * dimension, 0.0),
+      covariance_scratch_(detail::covariance_workspace_size(dimension), 0.0) {
+  reset();
+}
+
+void StreamingPca::reset() {
+  count_ = 0;
+  for (std::size_t i = 0; i < dimension_; ++i) {
+    mean_[i] = 0.0;
+  }
+  for (std::size_t i = 0; i < dimension_ * dimension_; ++i) {
+    scatter_[i] = 0.0;
+    eigenvectors_[i] = (i % (dimension_ + 1) == 0) ? 1.0 : 0.0;
+  }
+}
+
+void StreamingPca::add_batch(const float* vertices, std::size_t vertex_count) {
+  merge(vertices, vertex_count, vertex_count, 1.0);
+}
+
+void StreamingPca::add_batch(const float* vertices, std::size_t vertex_count, std::size_t stride) {
+  merge(vertices, vertex_count, stride, 1.0);
+}
+
+void StreamingPca::remove_batch(const float* vertices, std::size_t vertex_count) {
+  if (vertex_count >= count_) {
+    reset();
+    return;
+  }
+  merge(vertices, vertex_count, vertex_count, -1.0);
+}
+
+// Pairwise update with batch statistics (n_b, m_b, S_b) and delta = m_b - m_a:
+//   n = n_a + n_b,  m = m_a + delta * n_b / n,  S = S_a + S_b + delta delta^T * n_a * n_b / n.
+// Removal solves the same relation for the remaining set a.
+void StreamingPca::merge(const float* vertices, std::size_t vertex_count, std::size_t stride, double sign) {
+  if (vertices == nullptr || vertex_count == 0 || dimension_ == 0 || stride < vertex_count) {
+    return;
+  }
+  const std::size_t n = dimension_;
+  detail::compute_covariance_strided(vertices, vertex_count, stride, n, batch_mean_.data(), batch_covariance_.data(),
+                                     covariance_scratch_.data());
+  const double batch_count = static_cast<double>(vertex_count);
+  const double batch_dof = static_cast<double>(vertex_count - 1);
+
+  if (sign > 0.0) {
+    const double kept = static_cast<double>(count_);
+    const double total = kept + batch_count;
+    const double weight = kept * batch_count / total;
+    for (std::size_t i = 0; i < n; ++i) {
+      const double delta_i = batch_mean_[i] - mean_[i];
+      for (std::size_t j = 0; j < n; ++j) {
+        const double delta_j = batch_mean_[j] - mean_[j];
+        scatter_[i * n + j] += batch_covariance_[i * n + j] * batch_dof + delta_i * delta_j * weight;
+      }
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      mean_[i] += (batch_mean_[i] - mean_[i]) * batch_count / total;
+    }
+    count_ += vertex_count;
+    return;
+  }
+
+  const double total = static_cast<double>(count_);
+  const double remaining = total - batch_count;
+  for (std::size_t i = 0; i < n; ++i) {
+    mean_[i] = (mean_[i] * total - batch_mean_[i] * batch_count) / remaining;
+  }
+  const double weight = remaining * batch_count / total;
+  for (std::size_t i = 0; i < n; ++i) {
+    const double delta_i = batch_mean_[i] - mean_[i];
+    for (std::size_t j = 0; j < n; ++j) {
+      const double delta_j = batch_mean_[j] - mean_[j];
+      scatter_[i * n + j] -= batch_covariance_[i * n + j] * batch_dof + delta_i * delta_j * weight;
+    }
+  }
+  count_ -= vertex_count;
+}
+
+void StreamingPca::compute_basis(float* out_basis, float* out_eigenvalues, JacobiReport* out_report) {
+  const std::size_t n = dimension_;
+  if (out_basis == nullptr || n == 0) {
+    return;
+  }
+  const double normalizer = count_ > 1 ? 1.0 / static_cast<double>(count_ - 1) : 1.0;
+  const double* v = eigenvectors_.data();
+
+  // Warm start: A = V^T C V in the previous eigenbasis, then V <- V W for A = W diag W^T.
+  for (std::size_t row = 0; row < n; ++row) {
+    for (std::size_t col = 0; col < n; ++col) {
+      double sum = 0.0;
+      for (std::size_t k = 0; k < n; ++k) {
+        sum += scatter_[row * n + k] * v[k * n + col];
+      }
+      rotated_[row * n + col] = sum * normalizer;  // C V
+    }
+  }
+  for (std::size_t row = 0; row < n; ++row) {
+    for (std::size_t col = 0; col <= row; ++col) {
+      double sum = 0.0;
+      for (std::size_t k = 0; k < n; ++k) {
+        sum += v[k * n + row] * rotated_[k * n + col];
+      }
+      work_[row * n + col] = sum;
+      work_[col * n + row] = sum;
+    }
+  }
+
+  detail::JacobiParams params{};
+  detail::jacobi_symmetric(work_.data(), change_.data(), n, params, out_report);
+  for (std::size_t i = 0; i < n; ++i) {
+    eigenvalues_[i] = work_[i * n + i];
+  }
+  detail::sort_eigenpairs(eigenvalues_.data(), change_.data(), n);
+
+  for (std::size_t row = 0; row < n; ++row) {
+    for (std::size_t col = 0; col < n; ++col) {
+      double sum = 0.0;
+      for (std::size_t k = 0; k < n; ++k) {
+        sum += v[row * n + k] * change_[k * n + col];
+      }
+      rotated_[row * n + col] = sum;
+    }
+  }
+  eigenvectors_.swap(rotated_);
+
+  for (std::size_t component = 0; component < 3; ++component) {
+    for (std::size_t axis = 0; axis < n; ++axis) {
+      if (component < n) {
+        out_basis[component * n + axis] = static_cast<float>(eigenvectors_[axis * n + component]);
+      } else {
+        out_basis[component * n + axis] = (component == axis) ? 1.0f : 0.0f;
+      }
+    }
+  }
+  if (out_eigenvalues != nullptr) {
+    for (std::size_t i = 0; i < n; ++i) {
+      const double value = eigenvalues_[i];
+      out_eigenvalues[i] = static_cast<float>(value < 0.0 ? 0.0 : value);
+    }
+  }
+}
+
+}  // namespace ndvis
@@ -0,0 +1,224 @@
+#include "ndvis/detail/subspace.hpp"
+
+#include <vector>
+
+#include "ndvis/detail/jacobi.hpp"
+
+namespace ndvis::detail {
+
+namespace {
+
+// Deterministic start perturbation in [-0.5, 0.5), so no start column is exactly orthogonal to an eigenvector.
+double start_noise(std::size_t row, std::size_t col) {
+  unsigned int state = static_cast<unsigned int>(row * 2654435761U) ^ static_cast<unsigned int>(col * 40503U + 1U);
+  state = state * 1664525U + 1013904223U;
+  state ^= state >> 16;
+  state = state * 1664525U + 1013904223U;
+  return static_cast<double>(state >> 8) / static_cast<double>(1U << 24) - 0.5;
+}
+
+// Squared norm of column `col`.
+double column_norm(const double* basis, std::size_t order, std::size_t block, std::size_t col) {
+  double norm = 0.0;
+  for (std::size_t row = 0; row < order; ++row) {
+    norm += basis[row * block + col] * basis[row * block + col];
+  }
+  return norm;
+}
+
+// Removes the components of column `col` along columns [0, col) with two passes of modified Gram-Schmidt
+// and returns its remaining squared norm.
+double orthogonalize_column(double* basis, std::size_t order, std::size_t block, std::size_t col) {
+  for (std::size_t pass = 0; pass < 2; ++pass) {
+    for (std::size_t prev = 0; prev < col; ++prev) {
+      double dot = 0.0;
+      for (std::size_t row = 0; row < order; ++row) {
+        dot += basis[row * block + prev] * basis[row * block + col];
+      }
+      for (std::size_t row = 0; row < order; ++row) {
+        basis[row * block + col] -= dot * basis[row * block + prev];
+      }
+    }
+  }
+  return column_norm(basis, order, block, col);
+}
+
+// Orthonormalize the `block` columns of `basis` (order x block, row-major) in place. A column that vanishes
+// (rank-deficient input) is replaced by a fresh noise direction, and if that vanishes too, by the coordinate
+// axis least covered by the previous columns: with col < order orthonormal columns some axis keeps at least
+// (order - col) / order of its norm, so every column leaves orthonormal.
+void orthonormalize_columns(double* basis, std::size_t order, std::size_t block) {
+  for (std::size_t col = 0; col < block; ++col) {
+    double original = column_norm(basis, order, block, col);
+    double norm = orthogonalize_column(basis, order, block, col);
+    if (!(norm > 1.0e-24 * original && norm > 0.0)) {
+      for (std::size_t row = 0; row < order; ++row) {
+        basis[row * block + col] = start_noise(row, col + block);
+      }
+      original = column_norm(basis, order, block, col);
+      norm = orthogonalize_column(basis, order, block, col);
+    }
+    if (!(norm > 1.0e-24 * original && norm > 0.0)) {
+      std::size_t best_axis = 0;
+      double best_norm = -1.0;
+      for (std::size_t axis = 0; axis < order; ++axis) {
+        double covered = 0.0;
+        for (std::size_t prev = 0; prev < col; ++prev) {
+          covered += basis[axis * block + prev] * basis[axis * block + prev];
+        }
+        if (1.0 - covered > best_norm) {
+          best_norm = 1.0 - covered;
+          best_axis = axis;
+        }
+      }
+      for (std::size_t row = 0; row < order; ++row) {
+        basis[row * block + col] = row == best_axis ? 1.0 : 0.0;
+      }
+      norm = orthogonalize_column(basis, order, block, col);
+    }
+    const double inv_norm = 1.0 / __builtin_sqrt(norm);
+    for (std::size_t row = 0; row < order; ++row) {
+      basis[row * block + col] *= inv_norm;
+    }
+  }
+}
+
+// out (order x block) = matrix (order x order) * basis (order x block); row-contiguous passes.
+void multiply_block(const double* matrix, const double* basis, std::size_t order, std::size_t block, double* out) {
+  for (std::size_t row = 0; row < order; ++row) {
+    double* out_row = out + row * block;
+    for (std::size_t col = 0; col < block; ++col) {
+      out_row[col] = 0.0;
+    }
+    const double* matrix_row = matrix + row * order;
+    for (std::size_t k = 0; k < order; ++k) {
+      const double weight = matrix_row[k];
+      const double* basis_row = basis + k * block;
+      for (std::size_t col = 0; col < block; ++col) {
+        out_row[col] += weight * basis_row[col];
+      }
+    }
+  }
+}
+
+// out (order x block) = left (order x block) * small (block x block)
+void multiply_small(const double* left, const double* small, std::size_t order, std::size_t block, double* out) {
+  for (std::size_t row = 0; row < order; ++row) {
+    for (std::size_t col = 0; col < block; ++col) {
+      double sum = 0.0;
+      for (std::size_t k = 0; k < block; ++k) {
+        sum += left[row * block + k] * small[k * block + col];
+      }
+      out[row * block + col] = sum;
+    }
+  }
+}
+
+}  // namespace
+
+bool subspace_iteration(const double* matrix, std::size_t order, std::size_t count, const SubspaceParams& params,
+                        double* out_eigenvalues, double* out_eigenvectors, SubspaceReport* report) {
+  if (matrix == nullptr || out_eigenvalues == nullptr || out_eigenvectors == nullptr || order == 0 || count == 0 ||
+      count > order) {
+    return false;
+  }
+  const std::size_t block = count + params.guard_vectors < order ? count + params.guard_vectors : order;
+
+  // Start from the highest-variance coordinate axes, slightly mixed.
+  std::vector<double> diagonal(order);
+  std::vector<std::size_t> axes(order);
+  for (std::size_t i = 0; i < order; ++i) {
+    diagonal[i] = matrix[i * order + i];
+    axes[i] = i;
+  }
+  for (std::size_t col = 0; col < block; ++col) {
+    std::size_t best = col;
+    for (std::size_t i = col + 1; i < order; ++i) {
+      if (diagonal[axes[i]] > diagonal[axes[best]]) {
+        best = i;
+      }
+    }
+    const std::size_t swap = axes[col];
+    axes[col] = axes[best];
+    axes[best] = swap;
+  }
+  std::vector<double> basis(order * block);
+  for (std::size_t row = 0; row < order; ++row) {
+    for (std::size_t col = 0; col < block; ++col) {
+      basis[row * block + col] = (axes[col] == row ? 1.0 : 0.0) + 1.0e-3 * start_noise(row, col);
+    }
+  }
+  orthonormalize_columns(basis.data(), order, block);
+
+  std::vector<double> image(order * block);
+  std::vector<double> ritz_vectors(order * block);
+  std::vector<double> projected(block * block);
+  std::vector<double> rotation(block * block);
+  std::vector<double> values(block);
+  JacobiParams jacobi{};
+
+  SubspaceReport local{};
+  for (local.iterations = 1; local.iterations <= params.max_iterations; ++local.iterations) {
+    // Rayleigh-Ritz on span(basis): H = Q^T A Q = Y diag(theta) Y^T.
+    multiply_block(matrix, basis.data(), order, block, image.data());
+    for (std::size_t i = 0; i < block; ++i) {
+      for (std::size_t j = 0; j <= i; ++j) {
+        double sum = 0.0;
+        for (std::size_t row = 0; row < order; ++row) {
+          sum += basis[row * block + i] * image[row * block + j];
+        }
+        projected[i * block + j] = sum;
+        projected[j * block + i] = sum;
+      }
+    }
+    jacobi_symmetric(projected.data(), rotation.data(), block, jacobi);
+    for (std::size_t i = 0; i < block; ++i) {
+      values[i] = projected[i * block + i];
+    }
+    sort_eigenpairs(values.data(), rotation.data(), block);
+
+    // Ritz vectors X = Q Y and their images A X = (A Q) Y.
+    multiply_small(basis.data(), rotation.data(), order, block, ritz_vectors.data());
+    multiply_small(image.data(), rotation.data(), order, block, basis.data());
+
+    const double scale = values[0] > 0.0 ? values[0] : 1.0;
+    local.max_residual = 0.0;
+    for (std::size_t col = 0; col < count; ++col) {
+      double sum = 0.0;
+      for (std::size_t row = 0; row < order; ++row) {
+        const double diff = basis[row * block + col] - values[col] * ritz_vectors[row * block + col];
+        sum += diff * diff;
+      }
+      const double residual = __builtin_sqrt(sum);
+      local.max_residual = residual > local.max_residual ? residual : local.max_residual;
+    }
+    if (local.max_residual <= params.tolerance * scale) {
+      local.converged = true;
+      break;
+    }
+
+    // Next block: orth(A X), already held in `basis`.
+    orthonormalize_columns(basis.data(), order, block);
+  }
+  if (!local.converged) {
+    local.iterations = params.max_iterations;
+  }
+  if (report != nullptr) {
+    *report = local;
+  }
+  if (!local.converged) {
+    return false;
+  }
+
+  for (std::size_t col = 0; col < count; ++col) {
+    out_eigenvalues[col] = values[col];
+  }
+  for (std::size_t row = 0; row < order; ++row) {
+    for (std::size_t col = 0; col < count; ++col) {
+      out_eigenvectors[row * count + col] = ritz_vectors[row * block + col];
+    }
+  }
+  return true;
+}
+
+}  // namespace ndvis::detail
@@ -0,0 +1,235 @@
+#include "ndvis/detail/thread_pool.hpp"
+#include "ndvis/parallel.hpp"
+
+#include <atomic>
+#include <cstddef>
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define NDVIS_HAS_THREADS 0
+#else
+#define NDVIS_HAS_THREADS 1
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+namespace ndvis {
+
+namespace {
+
+std::atomic<std::size_t> g_requested_threads{0};
+
+// Requests are capped at this many threads per hardware thread, and at kMaxThreadCount overall, so a
+// stray huge count cannot make the pool spawn threads until std::thread throws.
+constexpr std::size_t kMaxThreadsPerCore = 4;
+constexpr std::size_t kMaxThreadCount = 256;
+
+std::size_t default_thread_count() {
+#if NDVIS_HAS_THREADS
+  const unsigned int hardware = std::thread::hardware_concurrency();
+  return hardware == 0 ? 1 : static_cast<std::size_t>(hardware);
+#else
+  return 1;
+#endif
+}
+
+}  // namespace
+
+void set_thread_count(std::size_t count) {
+#if NDVIS_HAS_THREADS
+  std::size_t limit = kMaxThreadsPerCore * default_thread_count();
+  limit = limit < kMaxThreadCount ? limit : kMaxThreadCount;
+  g_requested_threads.store(count < limit ? count : limit, std::memory_order_relaxed);
+#else
+  (void)count;
+#endif
+}
+
+std::size_t thread_count() {
+  const std::size_t requested = g_requested_threads.load(std::memory_order_relaxed);
+  return requested == 0 ? default_thread_count() : requested;
+}
+
+}  // namespace ndvis
+
+namespace ndvis::detail {
+
+std::size_t parallel_chunk_count(std::size_t item_count, std::size_t min_chunk) {
+  if (min_chunk == 0) {
+    min_chunk = 1;
+  }
+  const std::size_t by_size = item_count / min_chunk;
+  const std::size_t threads = thread_count();
+  const std::size_t chunks = by_size < threads ? by_size : threads;
+  return chunks == 0 ? 1 : chunks;
+}
+
+#if NDVIS_HAS_THREADS
+
+namespace {
+
+thread_local bool t_inside_pool = false;
+
+void run_inline(std::size_t item_count, std::size_t chunk_count, ChunkFunction fn, void* context) {
+  for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+    fn(context, chunk, chunk_begin(item_count, chunk_count, chunk), chunk_begin(item_count, chunk_count, chunk + 1));
+  }
+}
+
+// Persistent workers that cooperatively drain one chunked job at a time. The dispatching thread
+// also takes chunks, so a pool sized for N threads keeps N - 1 workers.
+class ThreadPool {
+ public:
+  ~ThreadPool() { stop_workers(); }
+
+  void run(std::size_t item_count, std::size_t chunk_count, ChunkFunction fn, void* context) {
+    std::unique_lock<std::mutex> dispatch(dispatch_mutex_, std::try_to_lock);
+    if (!dispatch.owns_lock()) {
+      // Another application thread is already using the pool; don't queue behind it.
+      run_inline(item_count, chunk_count, fn, context);
+      return;
+    }
+
+    const std::size_t wanted_workers = thread_count() - 1;
+    if (wanted_workers != workers_.size()) {
+      stop_workers();
+      start_workers(wanted_workers);
+    }
+    if (workers_.empty()) {
+      run_inline(item_count, chunk_count, fn, context);
+      return;
+    }
+
+    Job job{fn, context, item_count, chunk_count};
+    job.remaining = chunk_count;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      current_ = &job;
+      ++generation_;
+    }
+    wake_.notify_all();
+
+    t_inside_pool = true;
+    drain(job);
+    t_inside_pool = false;
+
+    // Workers pin the job under mutex_, so it may only leave this frame once none of them holds it.
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [&job] { return job.remaining == 0 && job.users == 0; });
+    current_ = nullptr;
+  }
+
+ private:
+  struct Job {
+    ChunkFunction fn;
+    void* context;
+    std::size_t item_count;
+    std::size_t chunk_count;
+    std::atomic<std::size_t> next_chunk{0};
+    std::size_t remaining{0};  // guarded by mutex_
+    std::size_t users{0};      // guarded by mutex_
+  };
+
+  void start_workers(std::size_t count) {
+    stopping_ = false;
+    workers_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      workers_.emplace_back([this] { worker_loop(); });
+    }
+  }
+
+  void stop_workers() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+    workers_.clear();
+  }
+
+  void worker_loop() {
+    t_inside_pool = true;
+    std::size_t seen_generation = 0;
+    for (;;) {
+      Job* job = nullptr;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [&] { return stopping_ || (current_ != nullptr && generation_ != seen_generation); });
+        if (stopping_) {
+          return;
+        }
+        seen_generation = generation_;
+        job = current_;
+        ++job->users;
+      }
+      drain(*job);
+      std::lock_guard<std::mutex> lock(mutex_);
+      --job->users;
+      if (job->remaining == 0 && job->users == 0) {
+        done_.notify_all();
+      }
+    }
+  }
+
+  void drain(Job& job) {
+    std::size_t finished = 0;
+    for (;;) {
+      const std::size_t chunk = job.next_chunk.fetch_add(1, std::memory_order_relaxed);
+      if (chunk >= job.chunk_count) {
+        break;
+      }
+      job.fn(job.context, chunk, chunk_begin(job.item_count, job.chunk_count, chunk),
+             chunk_begin(job.item_count, job.chunk_count, chunk + 1));
+      ++finished;
+    }
+    if (finished == 0) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    job.remaining -= finished;
+    if (job.remaining == 0) {
+      done_.notify_all();
+    }
+  }
+
+  std::mutex dispatch_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  std::vector<std::thread> workers_;
+  bool stopping_{false};
+  std::size_t generation_{0};
+  Job* current_{nullptr};
+};
+
+ThreadPool& pool() {
+  static ThreadPool instance;
+  return instance;
+}
+
+}  // namespace
+
+void run_chunks(std::size_t item_count, std::size_t chunk_count, ChunkFunction fn, void* context) {
+  if (chunk_count <= 1 || t_inside_pool) {
+    // Nested parallel regions run inline on the worker that reached them.
+    run_inline(item_count, chunk_count, fn, context);
+    return;
+  }
+  pool().run(item_count, chunk_count, fn, context);
+}
+
+#else
+
+void run_chunks(std::size_t item_count, std::size_t chunk_count, ChunkFunction fn, void* context) {
+  for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+    fn(context, chunk, chunk_begin(item_count, chunk_count, chunk), chunk_begin(item_count, chunk_count, chunk + 1));
+  }
+}
+
+#endif
+
+}  // namespace ndvis::detail
@@ -1,17 +1,54 @@
 #include <stdint.h>
 #include <cassert>
+#include <atomic>
+#include <cmath>
 #include <cstddef>
+#include <cstdlib>
+#include <new>
 #include <string>
+#include <vector>
 
 #include "ndvis/api.h"
+#include "ndvis/detail/covariance.hpp"
+#include "ndvis/detail/eigen.hpp"
+#include "ndvis/detail/simd.hpp"
+#include "ndvis/detail/subspace.hpp"
+#include "ndvis/drift.hpp"
+#include "ndvis/expmap.hpp"
 #include "ndvis/geometry.hpp"
 #include "ndvis/projection.hpp"
 #include "ndvis/qr.hpp"
+#include "ndvis/rotation4.hpp"
 #include "ndvis/rotations.hpp"
+#include "ndvis/progressive_pca.hpp"
+#include "ndvis/section.hpp"
+#include "ndvis/slice_sweep.hpp"
+#include "ndvis/streaming_pca.hpp"
 #include "ndvis/types.hpp"
 #include "ndvis/pca.hpp"
 #include "ndvis/hyperplane.hpp"
 #include "ndvis/overlays.hpp"
+#include "ndvis/parallel.hpp"
+
+// Counts heap allocations so allocation-free paths can be checked.
+std::atomic<std::size_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+// Out of line so GCC does not pair the inlined free() with a new-expression (-Wmismatched-new-delete).
+[[gnu::noinline]] void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+[[gnu::noinline]] void operator delete(void* pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
 
 namespace {
 constexpr float kEpsilon = 1e-5f;
@@ -24,6 +61,43 @@ float absolute(float value) {
 bool approx_equal(float a, float b, float eps = kEpsilon) {
   return absolute(a - b) <= eps;
 }
+
+// Deterministic LCG so the randomized checks are reproducible.
+float next_random(unsigned int& state) {
+  state = state * 1664525U + 1013904223U;
+  return static_cast<float>(state >> 8) / static_cast<float>(1U << 24) * 2.0f - 1.0f;
+}
+
+void fill_random(float* values, std::size_t count, unsigned int seed) {
+  unsigned int state = seed;
+  for (std::size_t i = 0; i < count; ++i) {
+    values[i] = next_random(state);
+  }
+}
+
+void fill_identity(float* matrix, std::size_t order) {
+  for (std::size_t i = 0; i < order * order; ++i) {
+    matrix[i] = (i % (order + 1) == 0) ? 1.0f : 0.0f;
+  }
+}
+
+// Two-stage reference projection (rotate by R, then dot with basis3), matching the original kernel.
+void reference_project(const float* vertices, std::size_t dimension, std::size_t vertex_count, const float* rotation,
+                       const float* basis, float* out_positions) {
+  for (std::size_t vertex = 0; vertex < vertex_count; ++vertex) {
+    for (std::size_t component = 0; component < 3; ++component) {
+      float sum = 0.0f;
+      for (std::size_t row = 0; row < dimension; ++row) {
+        float rotated = 0.0f;
+        for (std::size_t col = 0; col < dimension; ++col) {
+          rotated += rotation[row * dimension + col] * vertices[col * vertex_count + vertex];
+        }
+        sum += rotated * basis[component * dimension + row];
+      }
+      out_positions[vertex * 3 + component] = sum;
+    }
+  }
+}
 }  // namespace
 
 int main() {
@@ -943,5 +1017,2351 @@ int main() {
     }
   }
 
+  // Fused projection operator matches the two-stage rotate-then-project path
+  {
+    const std::size_t dimension = 7;
+    const std::size_t vertex_count = 131;  // not a multiple of the tile width
+
+    float vertices[dimension * vertex_count];
+    fill_random(vertices, dimension * vertex_count, 17U);
+
+    float rotation[dimension * dimension];
+    fill_identity(rotation, dimension);
+    ndvis::RotationPlane planes[4] = {{0U, 3U, 0.4f}, {1U, 6U, -0.9f}, {2U, 5U, 1.3f}, {4U, 0U, 0.2f}};
+    ndvis::apply_rotations(rotation, dimension, planes, 4);
+
+    float basis[dimension * 3];
+    fill_random(basis, dimension * 3, 29U);
+
+    float expected[vertex_count * 3];
+    reference_project(vertices, dimension, vertex_count, rotation, basis, expected);
+
+    float projected[vertex_count * 3];
+    ndvis::project_to_3d(ndvis::ConstBufferView{vertices, dimension * vertex_count}, dimension, vertex_count, rotation, 0,
+                         ndvis::ConstBasis3{basis, dimension, dimension}, projected);
+    for (std::size_t i = 0; i < vertex_count * 3; ++i) {
+      assert(approx_equal(projected[i], expected[i], 1e-4f));
+    }
+
+    float projection_operator[3 * dimension];
+    ndvis::build_projection_operator(rotation, dimension, ndvis::ConstBasis3{basis, dimension, dimension},
+                                     projection_operator);
+    float point[dimension];
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      point[axis] = vertices[axis * vertex_count + 5];
+    }
+    float single[3];
+    ndvis::project_point_with_operator(point, dimension, projection_operator, single);
+    for (std::size_t component = 0; component < 3; ++component) {
+      assert(approx_equal(single[component], expected[5 * 3 + component], 1e-4f));
+    }
+  }
+
+  // SIMD projection kernels agree with the original scalar implementation at every supported level
+  {
+    const std::size_t dimension = 12;
+    const std::size_t vertex_count = 203;  // exercises full vectors and the scalar tail
+
+    float vertices[dimension * vertex_count];
+    fill_random(vertices, dimension * vertex_count, 41U);
+
+    float rotation[dimension * dimension];
+    fill_identity(rotation, dimension);
+    ndvis::RotationPlane planes[3] = {{0U, 11U, 0.7f}, {3U, 8U, -1.1f}, {5U, 6U, 0.3f}};
+    ndvis::apply_rotations(rotation, dimension, planes, 3);
+
+    float basis[dimension * 3];
+    fill_random(basis, dimension * 3, 43U);
+
+    float expected[vertex_count * 3];
+    reference_project(vertices, dimension, vertex_count, rotation, basis, expected);
+
+    const ndvis::detail::SimdLevel levels[] = {
+        ndvis::detail::SimdLevel::kScalar, ndvis::detail::SimdLevel::kSse41,
+        ndvis::detail::SimdLevel::kAvx2,   ndvis::detail::SimdLevel::kAvx512,
+        ndvis::detail::SimdLevel::kNeon,   ndvis::detail::SimdLevel::kWasmSimd128,
+    };
+    for (const auto level : levels) {
+      if (!ndvis::detail::simd_level_supported(level)) {
+        continue;
+      }
+      ndvis::detail::set_simd_level(level);
+      assert(ndvis::detail::active_simd_level() == level);
+
+      float projected[vertex_count * 3] = {0.0f};
+      ndvis::project_to_3d(ndvis::ConstBufferView{vertices, dimension * vertex_count}, dimension, vertex_count,
+                           rotation, 0, ndvis::ConstBasis3{basis, dimension, dimension}, projected);
+      for (std::size_t i = 0; i < vertex_count * 3; ++i) {
+        assert(approx_equal(projected[i], expected[i], 1e-4f));
+      }
+    }
+    ndvis::detail::set_simd_level(ndvis::detail::detect_simd_level());
+  }
+
+  // Worker pool: projection, classification and slicing are identical for 1 and 4 threads
+  {
+    const std::size_t dimension = 6;
+    const std::size_t vertex_count = 70000;
+    const std::size_t edge_count = 40000;
+
+    std::vector<float> vertices(dimension * vertex_count);
+    fill_random(vertices.data(), vertices.size(), 57U);
+    std::vector<unsigned int> edges(edge_count * 2);
+    unsigned int state = 61U;
+    for (auto& index : edges) {
+      state = state * 1664525U + 1013904223U;
+      index = (state >> 8) % static_cast<unsigned int>(vertex_count);
+    }
+
+    float rotation[dimension * dimension];
+    fill_identity(rotation, dimension);
+    float basis[dimension * 3];
+    fill_random(basis, dimension * 3, 67U);
+    float normal[dimension] = {0.5f, -0.5f, 0.5f, 0.0f, 0.5f, 0.0f};
+    ndvis::Hyperplane hyperplane{normal, dimension, 0.1f};
+
+    struct Outputs {
+      std::vector<float> projected;
+      std::vector<int> classes;
+      std::vector<float> points;
+      std::vector<unsigned int> edge_ids;
+      std::size_t count{0};
+    };
+    auto run = [&](std::size_t threads) {
+      ndvis_set_thread_count(threads);
+      assert(ndvis_get_thread_count() == threads);
+      Outputs out;
+      out.projected.assign(vertex_count * 3, 0.0f);
+      out.classes.assign(vertex_count, 2);
+      out.points.assign(dimension * edge_count, 0.0f);
+      out.edge_ids.assign(edge_count, 0U);
+      const ndvis::ConstBufferView view{vertices.data(), vertices.size()};
+      ndvis::project_to_3d(view, dimension, vertex_count, rotation, 0, ndvis::ConstBasis3{basis, dimension, dimension},
+                           out.projected.data());
+      ndvis::classify_vertices(view, vertex_count, dimension, hyperplane, out.classes.data());
+      const auto result = ndvis::slice_polytope(view, vertex_count, dimension,
+                                                ndvis::ConstIndexBufferView{edges.data(), edges.size()}, hyperplane,
+                                                ndvis::BufferView{out.points.data(), out.points.size()},
+                                                ndvis::IndexBufferView{out.edge_ids.data(), out.edge_ids.size()});
+      out.count = result.intersection_count;
+      return out;
+    };
+
+    const Outputs serial = run(1);
+    const Outputs threaded = run(4);
+    assert(serial.count > 0);
+    assert(serial.count == threaded.count);
+    assert(serial.projected == threaded.projected);
+    assert(serial.classes == threaded.classes);
+    assert(serial.points == threaded.points);
+    assert(serial.edge_ids == threaded.edge_ids);
+    for (std::size_t i = 1; i < serial.count; ++i) {
+      assert(serial.edge_ids[i - 1] < serial.edge_ids[i]);  // deterministic edge order
+    }
+
+    // Capacity smaller than the hit count keeps the first intersections in edge order
+    std::vector<float> small_points(dimension * 5, 0.0f);
+    std::vector<unsigned int> small_edges(5, 0U);
+    const auto truncated = ndvis::slice_polytope(
+        ndvis::ConstBufferView{vertices.data(), vertices.size()}, vertex_count, dimension,
+        ndvis::ConstIndexBufferView{edges.data(), edges.size()}, hyperplane,
+        ndvis::BufferView{small_points.data(), small_points.size()},
+        ndvis::IndexBufferView{small_edges.data(), small_edges.size()});
+    assert(truncated.intersection_count == 5);
+    for (std::size_t i = 0; i < 5; ++i) {
+      assert(small_edges[i] == serial.edge_ids[i]);
+    }
+    ndvis_set_thread_count(0);
+  }
+
+  // Oversized thread counts are clamped instead of spawning that many workers
+  {
+    ndvis_set_thread_count(static_cast<size_t>(-1));
+    const std::size_t clamped = ndvis_get_thread_count();
+    assert(clamped >= 1 && clamped <= 256);
+    ndvis::set_thread_count(0);
+    assert(clamped <= 4 * ndvis::thread_count());
+    ndvis::set_thread_count(static_cast<size_t>(-1));
+    std::vector<float> distances(40000);
+    std::vector<float> column(distances.size(), 2.0f);
+    const float unit = 1.0f;
+    ndvis::compute_signed_distances(ndvis::ConstBufferView{column.data(), column.size()}, column.size(), 1,
+                                    ndvis::Hyperplane{&unit, 1, 0.5f}, distances.data());
+    for (const float distance : distances) {
+      assert(distance == 1.5f);
+    }
+    ndvis::set_thread_count(0);
+  }
+
+  // Incremental rank-2 projection updates track a full re-projection across many frames
+  {
+    const std::size_t dimension = 8;
+    const std::size_t vertex_count = 300;
+
+    float vertices[dimension * vertex_count];
+    fill_random(vertices, dimension * vertex_count, 71U);
+    float rotation[dimension * dimension];
+    fill_identity(rotation, dimension);
+    ndvis::RotationPlane initial[2] = {{0U, 4U, 0.8f}, {2U, 7U, -0.5f}};
+    ndvis::apply_rotations(rotation, dimension, initial, 2);
+    float basis[dimension * 3];
+    fill_random(basis, dimension * 3, 73U);
+    const ndvis::ConstBufferView view{vertices, dimension * vertex_count};
+    const ndvis::ConstBasis3 basis_view{basis, dimension, dimension};
+
+    float projection_operator[3 * dimension];
+    ndvis_build_projection_operator(rotation, dimension, basis, dimension, dimension, projection_operator);
+    float positions[vertex_count * 3];
+    ndvis::project_with_operator(view, dimension, vertex_count, projection_operator, positions);
+
+    float expected[vertex_count * 3];
+    const std::size_t allocations_before = g_allocations.load();
+    for (std::size_t frame = 0; frame < 120; ++frame) {
+      NdvisRotationPlane planes[2] = {{1U, 5U, 0.013f}, {5U, 6U, -0.021f}};
+      ndvis_apply_rotations(rotation, dimension, planes, 2);
+      ndvis_project_geometry_incremental(vertices, vertex_count, dimension, projection_operator, planes, 2, positions,
+                                         vertex_count * 3);
+    }
+    // The per-frame drag path keeps its scratch on the stack
+    assert(g_allocations.load() == allocations_before);
+    ndvis::project_to_3d(view, dimension, vertex_count, rotation, 0, basis_view, expected);
+    for (std::size_t i = 0; i < vertex_count * 3; ++i) {
+      assert(approx_equal(positions[i], expected[i], 1e-3f));
+    }
+
+    // A plane outside the dimension is ignored, matching apply_givens
+    float before[vertex_count * 3];
+    for (std::size_t i = 0; i < vertex_count * 3; ++i) {
+      before[i] = positions[i];
+    }
+    ndvis::RotationPlane invalid{3U, 9U, 0.5f};
+    ndvis::update_projection_incremental(view, dimension, vertex_count, projection_operator, &invalid, 1, positions);
+    for (std::size_t i = 0; i < vertex_count * 3; ++i) {
+      assert(positions[i] == before[i]);
+    }
+
+    // Dimensions past the stack scratch still track a full re-projection
+    const std::size_t wide = 80;
+    std::vector<float> wide_vertices(wide * vertex_count);
+    fill_random(wide_vertices.data(), wide_vertices.size(), 75U);
+    std::vector<float> wide_rotation(wide * wide);
+    fill_identity(wide_rotation.data(), wide);
+    std::vector<float> wide_basis(wide * 3);
+    fill_random(wide_basis.data(), wide_basis.size(), 77U);
+    const ndvis::ConstBufferView wide_view{wide_vertices.data(), wide_vertices.size()};
+    std::vector<float> wide_operator(3 * wide);
+    ndvis::build_projection_operator(wide_rotation.data(), wide, ndvis::ConstBasis3{wide_basis.data(), wide, wide},
+                                     wide_operator.data());
+    std::vector<float> wide_positions(vertex_count * 3);
+    ndvis::project_with_operator(wide_view, wide, vertex_count, wide_operator.data(), wide_positions.data());
+    ndvis::RotationPlane wide_planes[3] = {{2U, 70U, 0.3f}, {70U, 79U, -0.2f}, {66U, 5U, 0.1f}};
+    ndvis::apply_rotations(wide_rotation.data(), wide, wide_planes, 3);
+    ndvis::update_projection_incremental(wide_view, wide, vertex_count, wide_operator.data(), wide_planes, 3,
+                                         wide_positions.data());
+    std::vector<float> wide_expected(vertex_count * 3);
+    ndvis::project_to_3d(wide_view, wide, vertex_count, wide_rotation.data(), 0,
+                         ndvis::ConstBasis3{wide_basis.data(), wide, wide}, wide_expected.data());
+    for (std::size_t i = 0; i < vertex_count * 3; ++i) {
+      assert(approx_equal(wide_positions[i], wide_expected[i], 1e-3f));
+    }
+  }
+
+  // Structure-aware polytope projection matches projecting the generated vertex buffers
+  {
+    for (const int dimension : {1, 4, 12}) {
+      const std::size_t n = static_cast<std::size_t>(dimension);
+      std::vector<float> projection_operator(3 * n);
+      fill_random(projection_operator.data(), projection_operator.size(), 91U + static_cast<unsigned>(dimension));
+
+      const std::size_t cube_vertices = ndvis::hypercube_vertex_count(dimension);
+      std::vector<float> cube(cube_vertices * n);
+      std::vector<unsigned int> cube_edges(ndvis::hypercube_edge_count(dimension) * 2);
+      ndvis::generate_hypercube(dimension, ndvis::BufferView{cube.data(), cube.size()},
+                                ndvis::IndexBufferView{cube_edges.data(), cube_edges.size()});
+      std::vector<float> expected(cube_vertices * 3);
+      std::vector<float> actual(cube_vertices * 3);
+      ndvis::project_with_operator(ndvis::ConstBufferView{cube.data(), cube.size()}, n, cube_vertices,
+                                   projection_operator.data(), expected.data());
+      ndvis_project_hypercube(dimension, projection_operator.data(), actual.data(), actual.size());
+      for (std::size_t i = 0; i < actual.size(); ++i) {
+        assert(approx_equal(actual[i], expected[i], 1e-4f));
+      }
+
+      const std::size_t simplex_vertices = ndvis::simplex_vertex_count(dimension);
+      std::vector<float> simplex(simplex_vertices * n);
+      std::vector<unsigned int> simplex_edges(ndvis::simplex_edge_count(dimension) * 2);
+      ndvis::generate_simplex(dimension, ndvis::BufferView{simplex.data(), simplex.size()},
+                              ndvis::IndexBufferView{simplex_edges.data(), simplex_edges.size()});
+      expected.assign(simplex_vertices * 3, 0.0f);
+      actual.assign(simplex_vertices * 3, 1.0f);
+      ndvis::project_with_operator(ndvis::ConstBufferView{simplex.data(), simplex.size()}, n, simplex_vertices,
+                                   projection_operator.data(), expected.data());
+      ndvis_project_simplex(dimension, projection_operator.data(), actual.data(), actual.size());
+      for (std::size_t i = 0; i < actual.size(); ++i) {
+        assert(approx_equal(actual[i], expected[i]));
+      }
+
+      const std::size_t orthoplex_vertices = ndvis::orthoplex_vertex_count(dimension);
+      std::vector<float> orthoplex(orthoplex_vertices * n);
+      std::vector<unsigned int> orthoplex_edges(ndvis::orthoplex_edge_count(dimension) * 2);
+      ndvis::generate_orthoplex(dimension, ndvis::BufferView{orthoplex.data(), orthoplex.size()},
+                                ndvis::IndexBufferView{orthoplex_edges.data(), orthoplex_edges.size()});
+      expected.assign(orthoplex_vertices * 3, 0.0f);
+      actual.assign(orthoplex_vertices * 3, 1.0f);
+      ndvis::project_with_operator(ndvis::ConstBufferView{orthoplex.data(), orthoplex.size()}, n, orthoplex_vertices,
+                                   projection_operator.data(), expected.data());
+      ndvis_project_orthoplex(dimension, projection_operator.data(), actual.data(), actual.size());
+      for (std::size_t i = 0; i < actual.size(); ++i) {
+        assert(approx_equal(actual[i], expected[i]));
+      }
+    }
+  }
+
+  // Implicit hypercube slicing and overlays match the materialized hypercube
+  {
+    const int dimension = 6;
+    const std::size_t n = static_cast<std::size_t>(dimension);
+    const std::size_t vertex_count = ndvis::hypercube_vertex_count(dimension);
+    const std::size_t edge_count = ndvis::hypercube_edge_count(dimension);
+    std::vector<float> vertices(vertex_count * n);
+    std::vector<unsigned int> edges(edge_count * 2);
+    ndvis::generate_hypercube(dimension, ndvis::BufferView{vertices.data(), vertices.size()},
+                              ndvis::IndexBufferView{edges.data(), edges.size()});
+
+    for (std::size_t e = 0; e < edge_count; ++e) {
+      std::size_t v0 = 0;
+      std::size_t v1 = 0;
+      ndvis::hypercube_edge_vertices(dimension, e, &v0, &v1);
+      assert(v0 == edges[2 * e] && v1 == edges[2 * e + 1]);
+    }
+
+    std::vector<float> normal(n);
+    fill_random(normal.data(), n, 111U);
+    float norm_sq = 0.0f;
+    for (const float value : normal) {
+      norm_sq += value * value;
+    }
+    for (float& value : normal) {
+      value /= std::sqrt(norm_sq);
+    }
+    const ndvis::Hyperplane plane{normal.data(), n, 0.3f};
+
+    std::vector<float> expected_points(edge_count * n);
+    std::vector<unsigned int> expected_edges(edge_count);
+    const ndvis::SliceResult expected = ndvis::slice_polytope(
+        ndvis::ConstBufferView{vertices.data(), vertices.size()}, vertex_count, n,
+        ndvis::ConstIndexBufferView{edges.data(), edges.size()}, plane,
+        ndvis::BufferView{expected_points.data(), expected_points.size()},
+        ndvis::IndexBufferView{expected_edges.data(), expected_edges.size()});
+    assert(expected.intersection_count > 0);
+
+    // Implicit distances are summed in double from lookup tables, so points match to rounding only. This
+    // plane keeps every vertex well away from the on-plane tolerance, so the crossing edges match exactly.
+    std::vector<float> distances(vertex_count);
+    ndvis::compute_signed_distances(ndvis::ConstBufferView{vertices.data(), vertices.size()}, vertex_count, n, plane,
+                                    distances.data());
+    for (const float distance : distances) {
+      assert(std::abs(distance) > 1e-3f);
+    }
+    std::vector<float> implicit_points(edge_count * n);
+    std::vector<unsigned int> implicit_edges(edge_count);
+    const ndvis::SliceResult implicit = ndvis::slice_hypercube(
+        ndvis::ImplicitHypercube{dimension}, plane,
+        ndvis::BufferView{implicit_points.data(), implicit_points.size()},
+        ndvis::IndexBufferView{implicit_edges.data(), implicit_edges.size()});
+    assert(implicit.intersection_count == expected.intersection_count);
+    for (std::size_t i = 0; i < implicit.intersection_count; ++i) {
+      assert(implicit_edges[i] == expected_edges[i]);
+    }
+    for (std::size_t i = 0; i < implicit.intersection_count * n; ++i) {
+      assert(approx_equal(implicit_points[i], expected_points[i], 1e-4f));
+    }
+
+    // Capped output keeps the leading hits
+    std::vector<float> capped_points(3 * n);
+    const ndvis::SliceResult capped = ndvis::slice_hypercube(
+        ndvis::ImplicitHypercube{dimension}, plane, ndvis::BufferView{capped_points.data(), capped_points.size()},
+        ndvis::IndexBufferView{});
+    assert(capped.intersection_count == 3);
+    for (std::size_t axis = 0; axis < n; ++axis) {
+      for (std::size_t hit = 0; hit < 3; ++hit) {
+        assert(approx_equal(capped_points[axis * 3 + hit],
+                            expected_points[axis * expected.intersection_count + hit], 1e-4f));
+      }
+    }
+
+    float rotation[6 * 6];
+    fill_identity(rotation, n);
+    float basis[6 * 3];
+    fill_random(basis, n * 3, 113U);
+
+    ndvis::GeometryInputs explicit_geometry{vertices.data(), vertex_count, n, edges.data(), edge_count, rotation, basis};
+    ndvis::GeometryInputs implicit_geometry{nullptr, 0, n, nullptr, 0, rotation, basis};
+    implicit_geometry.implicit_hypercube = ndvis::ImplicitHypercube{dimension};
+    const ndvis::HyperplaneInputs hyperplane_inputs{normal.data(), 0.3f, true};
+    const ndvis::CalculusInputs calculus{};
+
+    std::vector<float> explicit_projected(vertex_count * 3);
+    std::vector<float> explicit_slice(edge_count * 3);
+    std::size_t explicit_slice_count = 0;
+    ndvis::OverlayBuffers explicit_buffers{};
+    explicit_buffers.projected_vertices = explicit_projected.data();
+    explicit_buffers.projected_stride = vertex_count;
+    explicit_buffers.slice_positions = explicit_slice.data();
+    explicit_buffers.slice_capacity = edge_count;
+    explicit_buffers.slice_count = &explicit_slice_count;
+    assert(ndvis::compute_overlays(explicit_geometry, hyperplane_inputs, calculus, explicit_buffers) ==
+           ndvis::OverlayResult::kSuccess);
+
+    std::vector<float> implicit_projected(vertex_count * 3);
+    std::vector<float> implicit_slice(edge_count * 3);
+    std::size_t implicit_slice_count = 0;
+    ndvis::OverlayBuffers implicit_buffers = explicit_buffers;
+    implicit_buffers.projected_vertices = implicit_projected.data();
+    implicit_buffers.slice_positions = implicit_slice.data();
+    implicit_buffers.slice_count = &implicit_slice_count;
+    assert(ndvis::compute_overlays(implicit_geometry, hyperplane_inputs, calculus, implicit_buffers) ==
+           ndvis::OverlayResult::kSuccess);
+
+    assert(implicit_slice_count == explicit_slice_count);
+    for (std::size_t i = 0; i < vertex_count * 3; ++i) {
+      assert(approx_equal(implicit_projected[i], explicit_projected[i], 1e-4f));
+    }
+    for (std::size_t i = 0; i < implicit_slice_count * 3; ++i) {
+      assert(approx_equal(implicit_slice[i], explicit_slice[i], 1e-4f));
+    }
+  }
+
+  // Explicit and implicit cubes share the epsilon slice rules and agree on level sets
+  {
+    const int dimension = 4;
+    const std::size_t n = 4;
+    const std::size_t vertex_count = ndvis::hypercube_vertex_count(dimension);
+    const std::size_t edge_count = ndvis::hypercube_edge_count(dimension);
+    std::vector<float> vertices(vertex_count * n);
+    std::vector<unsigned int> edges(edge_count * 2);
+    ndvis::generate_hypercube(dimension, ndvis::BufferView{vertices.data(), vertices.size()},
+                              ndvis::IndexBufferView{edges.data(), edges.size()});
+    float rotation[4 * 4];
+    fill_identity(rotation, n);
+    float basis[4 * 3];
+    fill_random(basis, n * 3, 139U);
+    ndvis::GeometryInputs explicit_geometry{vertices.data(), vertex_count, n, edges.data(), edge_count, rotation, basis};
+    ndvis::GeometryInputs implicit_geometry{nullptr, 0, n, nullptr, 0, rotation, basis};
+    implicit_geometry.implicit_hypercube = ndvis::ImplicitHypercube{dimension};
+
+    // x1 = 1 + 5e-6: the x1 = 1 facet sits within the slice epsilon, so its eight x1-edges count as crossings
+    const float normal[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+    const ndvis::HyperplaneInputs near_plane{normal, 1.0f + 5e-6f, true};
+    const std::string expression = "x1 + 2 * x2 - x3 * x4";
+    const float levels[2] = {0.5f, -1.0f};
+    ndvis::CalculusInputs calculus{};
+    calculus.expression_utf8 = expression.c_str();
+    calculus.expression_length = expression.size();
+    calculus.level_set_values = levels;
+    calculus.level_set_count = 2;
+    calculus.show_level_sets = true;
+
+    struct Run {
+      std::vector<float> slice;
+      std::size_t slice_count{0};
+      std::vector<float> curves[2];
+      std::size_t sizes[2]{};
+      std::size_t level_count{0};
+    };
+    const auto run = [&](const ndvis::GeometryInputs& geometry) {
+      Run out;
+      out.slice.assign(edge_count * 3, 0.0f);
+      float* curve_pointers[2];
+      for (std::size_t level = 0; level < 2; ++level) {
+        out.curves[level].assign(edge_count * 3, 0.0f);
+        curve_pointers[level] = out.curves[level].data();
+        out.sizes[level] = out.curves[level].size();
+      }
+      ndvis::OverlayBuffers buffers{};
+      buffers.slice_positions = out.slice.data();
+      buffers.slice_capacity = edge_count;
+      buffers.slice_count = &out.slice_count;
+      buffers.level_set_curves = curve_pointers;
+      buffers.level_set_sizes = out.sizes;
+      buffers.level_set_capacity = 2;
+      buffers.level_set_count = &out.level_count;
+      assert(ndvis::compute_overlays(geometry, near_plane, calculus, buffers) == ndvis::OverlayResult::kSuccess);
+      return out;
+    };
+    const Run explicit_run = run(explicit_geometry);
+    const Run implicit_run = run(implicit_geometry);
+    assert(explicit_run.slice_count == 8 && implicit_run.slice_count == 8);
+    for (std::size_t i = 0; i < 8 * 3; ++i) {
+      assert(approx_equal(implicit_run.slice[i], explicit_run.slice[i], 1e-4f));
+    }
+    assert(explicit_run.level_count == 2 && implicit_run.level_count == 2);
+    for (std::size_t level = 0; level < 2; ++level) {
+      assert(explicit_run.sizes[level] > 0 && implicit_run.sizes[level] == explicit_run.sizes[level]);
+      for (std::size_t i = 0; i < explicit_run.sizes[level]; ++i) {
+        assert(implicit_run.curves[level][i] == explicit_run.curves[level][i]);
+      }
+    }
+
+    // A curve buffer too small for its level is reported rather than overrun: earlier levels are written in
+    // full with their real sizes, the short level and later ones are left untouched
+    for (const ndvis::GeometryInputs* geometry : {&explicit_geometry, &implicit_geometry}) {
+      for (std::size_t short_level = 0; short_level < 2; ++short_level) {
+        std::vector<float> curves[2];
+        float* pointers[2];
+        std::size_t sizes[2];
+        for (std::size_t level = 0; level < 2; ++level) {
+          curves[level].assign(level == short_level ? 3 : edge_count * 3, -7.0f);
+          pointers[level] = curves[level].data();
+          sizes[level] = curves[level].size();
+        }
+        std::size_t level_count = 0;
+        ndvis::OverlayBuffers short_buffers{};
+        short_buffers.level_set_curves = pointers;
+        short_buffers.level_set_sizes = sizes;
+        short_buffers.level_set_capacity = 2;
+        short_buffers.level_set_count = &level_count;
+        assert(ndvis::compute_overlays(*geometry, near_plane, calculus, short_buffers) ==
+               ndvis::OverlayResult::kNullBuffer);
+        assert(level_count == short_level);
+        for (std::size_t level = 0; level < 2; ++level) {
+          if (level < short_level) {
+            assert(sizes[level] == explicit_run.sizes[level]);
+            for (std::size_t i = 0; i < sizes[level]; ++i) {
+              assert(curves[level][i] == explicit_run.curves[level][i]);
+            }
+          } else {
+            assert(sizes[level] == curves[level].size());
+            for (const float value : curves[level]) {
+              assert(value == -7.0f);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // Implicit slicing scales past what a materialized cube would allocate
+  {
+    const int dimension = 16;
+    const std::size_t n = static_cast<std::size_t>(dimension);
+    std::vector<float> normal(n, 1.0f / 4.0f);
+    const NdvisHyperplane plane{normal.data(), n, 0.1f};
+    std::vector<float> points(256 * n);
+    std::vector<unsigned int> edge_ids(256);
+    const NdvisSliceResult result = ndvis_slice_hypercube(dimension, plane, NdvisBuffer{points.data(), points.size()},
+                                                          NdvisIndexBuffer{edge_ids.data(), edge_ids.size()});
+    assert(result.intersection_count == 256);
+    for (std::size_t hit = 0; hit < result.intersection_count; ++hit) {
+      float dot = 0.0f;
+      for (std::size_t axis = 0; axis < n; ++axis) {
+        dot += normal[axis] * points[axis * result.intersection_count + hit];
+      }
+      assert(approx_equal(dot, 0.1f, 1e-4f));
+    }
+  }
+
+  // Fused Givens sweep matches plane-by-plane application (row tail, blocked rows, heap tile)
+  {
+    for (const std::size_t order : {std::size_t{5}, std::size_t{12}, std::size_t{20}, std::size_t{70}}) {
+      std::vector<float> fused(order * order);
+      fill_random(fused.data(), fused.size(), 131U + static_cast<unsigned>(order));
+      std::vector<float> sequential = fused;
+
+      std::vector<ndvis::RotationPlane> planes;
+      unsigned seed = 137U;
+      for (unsigned int i = 0; i < order; ++i) {
+        for (unsigned int j = i + 1; j < order; ++j) {
+          planes.push_back({i, j, next_random(seed)});
+        }
+      }
+      planes.push_back({2U, 2U, 0.4f});  // degenerate plane
+      planes.push_back({1U, static_cast<unsigned int>(order), 0.2f});  // out of range, skipped
+
+      ndvis::apply_rotations(fused.data(), order, planes.data(), planes.size());
+      for (const auto& plane : planes) {
+        ndvis::apply_givens(sequential.data(), order, plane);
+      }
+      for (std::size_t i = 0; i < fused.size(); ++i) {
+        assert(approx_equal(fused[i], sequential[i], 1e-6f));
+      }
+    }
+  }
+
+  // Exponential-map stepping from angular velocities
+  {
+    const std::size_t order = 6;
+
+    // A single plane reproduces apply_givens with angle theta * dt for both methods
+    ndvis::RotationPlane single{1U, 4U, 0.8f};
+    float generator[order * order];
+    ndvis::build_rotation_generator(&single, 1, order, generator);
+    float reference[order * order];
+    fill_random(reference, order * order, 151U);
+    float pade[order * order];
+    float cayley[order * order];
+    for (std::size_t i = 0; i < order * order; ++i) {
+      pade[i] = reference[i];
+      cayley[i] = reference[i];
+    }
+    ndvis::apply_givens(reference, order, ndvis::RotationPlane{1U, 4U, 0.8f * 0.05f});
+    assert(ndvis::apply_angular_velocity(pade, order, generator, 0.05f, ndvis::ExpMapMethod::kPade));
+    assert(ndvis::apply_angular_velocity(cayley, order, generator, 0.05f, ndvis::ExpMapMethod::kCayley));
+    for (std::size_t i = 0; i < order * order; ++i) {
+      assert(approx_equal(pade[i], reference[i], 1e-5f));
+      assert(approx_equal(cayley[i], reference[i], 1e-4f));
+    }
+
+    // Many simultaneous planes over many frames stay orthogonal without re-orthonormalization
+    std::vector<NdvisRotationPlane> velocities;
+    unsigned seed = 157U;
+    for (unsigned int i = 0; i < order; ++i) {
+      for (unsigned int j = i + 1; j < order; ++j) {
+        velocities.push_back({i, j, 2.0f * next_random(seed)});
+      }
+    }
+    for (const int method : {NDVIS_EXPMAP_CAYLEY, NDVIS_EXPMAP_PADE}) {
+      float rotation[order * order];
+      fill_identity(rotation, order);
+      for (int frame = 0; frame < 600; ++frame) {
+        assert(ndvis_apply_angular_velocity(rotation, order, velocities.data(), velocities.size(), 1.0f / 60.0f,
+                                            method) == 0);
+      }
+      assert(ndvis::compute_orthogonality_drift(rotation, order) < 1e-4f);
+    }
+
+    // The workspace overload gives the same bits without allocating; a short workspace is rejected
+    {
+      float animated_generator[order * order];
+      ndvis_build_rotation_generator(velocities.data(), velocities.size(), order, animated_generator);
+      for (const int method : {NDVIS_EXPMAP_CAYLEY, NDVIS_EXPMAP_PADE}) {
+        const auto expmap = method == NDVIS_EXPMAP_PADE ? ndvis::ExpMapMethod::kPade : ndvis::ExpMapMethod::kCayley;
+        std::vector<double> workspace(ndvis_angular_velocity_workspace_size(order, method));
+        float allocating[order * order];
+        float reused[order * order];
+        fill_identity(allocating, order);
+        fill_identity(reused, order);
+        const std::size_t before = g_allocations.load();
+        for (int frame = 0; frame < 20; ++frame) {
+          assert(ndvis_apply_angular_velocity_with_workspace(reused, order, animated_generator, 0.4f, method,
+                                                             workspace.data(), workspace.size()) == 0);
+        }
+        assert(g_allocations.load() == before);
+        for (int frame = 0; frame < 20; ++frame) {
+          assert(ndvis::apply_angular_velocity(allocating, order, animated_generator, 0.4f, expmap));
+        }
+        for (std::size_t i = 0; i < order * order; ++i) {
+          assert(reused[i] == allocating[i]);
+        }
+        assert(ndvis_apply_angular_velocity_with_workspace(reused, order, animated_generator, 0.4f, method,
+                                                           workspace.data(), workspace.size() - 1) == 1);
+        for (std::size_t i = 0; i < order * order; ++i) {
+          assert(reused[i] == allocating[i]);
+        }
+      }
+    }
+
+    // Pade agrees with many tiny Givens steps of the same generator (Lie-Trotter limit)
+    float exact[order * order];
+    fill_identity(exact, order);
+    ndvis::build_rotation_generator(reinterpret_cast<const ndvis::RotationPlane*>(velocities.data()),
+                                    velocities.size(), order, generator);
+    assert(ndvis::apply_angular_velocity(exact, order, generator, 0.5f, ndvis::ExpMapMethod::kPade));
+    float trotter[order * order];
+    fill_identity(trotter, order);
+    std::vector<ndvis::RotationPlane> substeps;
+    for (const auto& velocity : velocities) {
+      substeps.push_back({velocity.i, velocity.j, velocity.theta * 0.5f / 2000.0f});
+    }
+    for (int step = 0; step < 2000; ++step) {
+      ndvis::apply_rotations(trotter, order, substeps.data(), substeps.size());
+    }
+    for (std::size_t i = 0; i < order * order; ++i) {
+      assert(approx_equal(exact[i], trotter[i], 2e-3f));
+    }
+  }
+
+  // Sampled drift estimate and scheduled re-orthonormalization
+  {
+    const std::size_t order = 6;
+    float perturbed[order * order];
+    fill_identity(perturbed, order);
+    unsigned seed = 163U;
+    for (float& value : perturbed) {
+      value += 1e-3f * next_random(seed);
+    }
+    // Covering every column pair reproduces the full R^T R metric
+    const float exact = ndvis::compute_orthogonality_drift(perturbed, order);
+    const float full = ndvis::estimate_orthogonality_drift(perturbed, order, 0, order * (order + 1) / 2);
+    assert(approx_equal(full, exact, 1e-5f));
+    const float sampled = ndvis::estimate_orthogonality_drift(perturbed, order, 5, 2 * order);
+    assert(sampled > 0.2f * exact && sampled < 5.0f * exact);
+
+    NdvisDriftScheduler scheduler;
+    ndvis_drift_scheduler_init(&scheduler, 2e-5f);
+    float rotation[order * order];
+    fill_identity(rotation, order);
+    std::vector<NdvisRotationPlane> planes;
+    for (unsigned int i = 0; i < order; ++i) {
+      for (unsigned int j = i + 1; j < order; ++j) {
+        planes.push_back({i, j, 0.37f * next_random(seed)});
+      }
+    }
+    std::size_t fired = 0;
+    for (int frame = 0; frame < 5000; ++frame) {
+      fired += static_cast<std::size_t>(
+          ndvis_apply_rotations_scheduled(&scheduler, rotation, order, planes.data(), planes.size()));
+    }
+    assert(scheduler.steps == 5000);
+    assert(scheduler.reorthonormalizations == fired);
+    assert(scheduler.checks >= fired && scheduler.checks < scheduler.steps / 10);
+    assert(fired > 0);
+    assert(ndvis::compute_orthogonality_drift(rotation, order) < 2.0f * scheduler.threshold);
+  }
+
+  // Householder and Newton-Schulz re-orthonormalization with caller workspace
+  {
+    for (const std::size_t order : {std::size_t{4}, std::size_t{12}, std::size_t{40}}) {
+      std::vector<float> drifted(order * order);
+      fill_identity(drifted.data(), order);
+      std::vector<ndvis::RotationPlane> planes;
+      unsigned seed = 167U + static_cast<unsigned>(order);
+      for (unsigned int i = 0; i < order; ++i) {
+        for (unsigned int j = i + 1; j < order; ++j) {
+          planes.push_back({i, j, next_random(seed)});
+        }
+      }
+      ndvis::apply_rotations(drifted.data(), order, planes.data(), planes.size());
+      for (float& value : drifted) {
+        value += 1e-3f * next_random(seed);
+      }
+
+      std::vector<float> gram_schmidt = drifted;
+      ndvis::reorthonormalize(gram_schmidt.data(), order);
+
+      // Householder QR spans the same flag of subspaces as Gram-Schmidt, so Q matches it
+      std::vector<double> workspace(ndvis::reorthonormalize_workspace_size(order, ndvis::OrthonormalizeMethod::kHouseholder));
+      std::vector<float> householder = drifted;
+      assert(ndvis::reorthonormalize(householder.data(), order, ndvis::OrthonormalizeMethod::kHouseholder,
+                                     workspace.data(), workspace.size()));
+      assert(ndvis::compute_orthogonality_drift(householder.data(), order) < 1e-5f);
+      for (std::size_t i = 0; i < order * order; ++i) {
+        assert(approx_equal(householder[i], gram_schmidt[i], 1e-3f));
+      }
+
+      // Newton-Schulz converges to the polar factor, which stays closest to the drifted input
+      workspace.resize(ndvis::reorthonormalize_workspace_size(order, ndvis::OrthonormalizeMethod::kNewtonSchulz));
+      std::vector<float> polar = drifted;
+      assert(ndvis_reorthonormalize_with_workspace(polar.data(), order, NDVIS_ORTHONORMALIZE_NEWTON_SCHULZ,
+                                                   workspace.data(), workspace.size()) == 0);
+      assert(ndvis::compute_orthogonality_drift(polar.data(), order) < 1e-5f);
+      float polar_distance = 0.0f;
+      float householder_distance = 0.0f;
+      for (std::size_t i = 0; i < order * order; ++i) {
+        polar_distance += (polar[i] - drifted[i]) * (polar[i] - drifted[i]);
+        householder_distance += (householder[i] - drifted[i]) * (householder[i] - drifted[i]);
+      }
+      assert(polar_distance <= householder_distance * 1.0001f);
+
+      // Too little workspace is rejected without touching the matrix
+      std::vector<float> untouched = drifted;
+      assert(ndvis_reorthonormalize_with_workspace(untouched.data(), order, NDVIS_ORTHONORMALIZE_HOUSEHOLDER,
+                                                   workspace.data(), order) == 1);
+      assert(untouched == drifted);
+
+      // The workspace overload allocates for no method, Gram-Schmidt above the fixed orders included
+      std::vector<float> scratch_matrices[3] = {drifted, drifted, drifted};
+      const ndvis::OrthonormalizeMethod methods[3] = {ndvis::OrthonormalizeMethod::kModifiedGramSchmidt,
+                                                      ndvis::OrthonormalizeMethod::kHouseholder,
+                                                      ndvis::OrthonormalizeMethod::kNewtonSchulz};
+      const std::size_t before = g_allocations.load();
+      for (std::size_t method = 0; method < 3; ++method) {
+        assert(ndvis::reorthonormalize(scratch_matrices[method].data(), order, methods[method], workspace.data(),
+                                       workspace.size()));
+      }
+      assert(g_allocations.load() == before);
+      assert(scratch_matrices[0] == gram_schmidt);
+    }
+
+    // Far from orthogonal: Newton-Schulz falls back to Householder
+    float skewed[9] = {2.0f, 0.5f, 0.0f, 0.0f, 1.0f, 0.3f, 0.1f, 0.0f, 3.0f};
+    std::vector<double> workspace(ndvis_reorthonormalize_workspace_size(3, NDVIS_ORTHONORMALIZE_NEWTON_SCHULZ));
+    assert(ndvis_reorthonormalize_with_workspace(skewed, 3, NDVIS_ORTHONORMALIZE_NEWTON_SCHULZ, workspace.data(),
+                                                 workspace.size()) == 0);
+    assert(ndvis::compute_orthogonality_drift(skewed, 3) < 1e-5f);
+  }
+
+  // Double-quaternion 4D rotations track the Givens matrix path and stay orthogonal
+  {
+    std::vector<NdvisRotationPlane> planes;
+    unsigned seed = 173U;
+    for (unsigned int i = 0; i < 4; ++i) {
+      for (unsigned int j = 0; j < 4; ++j) {
+        if (i != j) {
+          planes.push_back({i, j, next_random(seed)});
+        }
+      }
+    }
+    planes.push_back({1U, 7U, 0.5f});  // outside n = 4, skipped by both paths
+
+    NdvisRotation4 state;
+    ndvis_rotation4_identity(&state);
+    ndvis_rotation4_apply(&state, planes.data(), planes.size());
+    float from_quaternions[16];
+    ndvis_rotation4_to_matrix(&state, from_quaternions);
+    float from_givens[16];
+    fill_identity(from_givens, 4);
+    ndvis_apply_rotations(from_givens, 4, planes.data(), planes.size());
+    for (std::size_t i = 0; i < 16; ++i) {
+      assert(approx_equal(from_quaternions[i], from_givens[i], 1e-5f));
+    }
+
+    // Long animation: no QR pass, still orthogonal to float rounding
+    ndvis::Rotation4 rotation{};
+    const ndvis::RotationPlane frame_planes[3] = {{0U, 3U, 0.011f}, {1U, 2U, -0.017f}, {0U, 1U, 0.005f}};
+    for (int frame = 0; frame < 100000; ++frame) {
+      ndvis::apply_rotations4(rotation, frame_planes, 3);
+    }
+    float matrix[16];
+    ndvis::rotation4_to_matrix(rotation, matrix);
+    assert(ndvis::compute_orthogonality_drift(matrix, 4) < 1e-5f);
+  }
+
+  // Dimension-specialized kernels (n = 2..16) agree with the generic runtime-dimension paths
+  {
+    const std::size_t vertex_count = 83;  // not a multiple of any block or vector width
+    for (std::size_t dimension = 1; dimension <= 18; ++dimension) {
+      std::vector<float> vertices(dimension * vertex_count);
+      fill_random(vertices.data(), vertices.size(), 71U + static_cast<unsigned int>(dimension));
+
+      // Blocked classification matches the per-point distance exactly
+      std::vector<float> normal(dimension);
+      fill_random(normal.data(), dimension, 79U);
+      const ndvis::Hyperplane hyperplane{normal.data(), dimension, 0.05f};
+      std::vector<int> classes(vertex_count);
+      ndvis::classify_vertices(ndvis::ConstBufferView{vertices.data(), vertices.size()}, vertex_count, dimension,
+                               hyperplane, classes.data());
+      std::vector<float> point(dimension);
+      for (std::size_t v = 0; v < vertex_count; ++v) {
+        for (std::size_t axis = 0; axis < dimension; ++axis) {
+          point[axis] = vertices[axis * vertex_count + v];
+        }
+        const float distance = ndvis::point_to_hyperplane_distance(point.data(), hyperplane);
+        const int expected = absolute(distance) < 1e-5f ? 0 : (distance > 0.0f ? 1 : -1);
+        assert(classes[v] == expected);
+      }
+
+      // Fused Givens sweep matches per-plane application bitwise
+      std::vector<ndvis::RotationPlane> planes;
+      for (unsigned int i = 0; i < dimension; ++i) {
+        for (unsigned int j = i + 1; j < dimension; ++j) {
+          planes.push_back({i, j, 0.1f * static_cast<float>(i + 2 * j)});
+        }
+      }
+      std::vector<float> matrix(dimension * dimension);
+      std::vector<float> reference(dimension * dimension);
+      fill_identity(matrix.data(), dimension);
+      fill_identity(reference.data(), dimension);
+      ndvis::apply_rotations(matrix.data(), dimension, planes.data(), planes.size());
+      for (const auto& plane : planes) {
+        ndvis::apply_givens(reference.data(), dimension, plane);
+      }
+      for (std::size_t i = 0; i < matrix.size(); ++i) {
+        assert(matrix[i] == reference[i]);
+      }
+
+      // Drift and Gram-Schmidt on a perturbed identity
+      fill_identity(matrix.data(), dimension);
+      for (std::size_t i = 0; i < matrix.size(); ++i) {
+        matrix[i] += 0.01f * vertices[i % vertices.size()];
+      }
+      double drift_squared = 0.0;
+      for (std::size_t i = 0; i < dimension; ++i) {
+        for (std::size_t j = 0; j < dimension; ++j) {
+          double gram = i == j ? -1.0 : 0.0;
+          for (std::size_t k = 0; k < dimension; ++k) {
+            gram += static_cast<double>(matrix[k * dimension + i]) * matrix[k * dimension + j];
+          }
+          drift_squared += gram * gram;
+        }
+      }
+      assert(approx_equal(ndvis::compute_orthogonality_drift(matrix.data(), dimension),
+                          static_cast<float>(std::sqrt(drift_squared)), 1e-5f));
+      ndvis::reorthonormalize(matrix.data(), dimension);
+      assert(ndvis::compute_orthogonality_drift(matrix.data(), dimension) < 1e-5f);
+      for (std::size_t i = 0; i < dimension; ++i) {
+        assert(matrix[i * dimension + i] > 0.9f);
+      }
+    }
+  }
+
+  // Cyclic Jacobi converges at n = 12 within the default sweep budget and reports it
+  {
+    const std::size_t dimension = 12;
+    const std::size_t vertex_count = 400;
+    std::vector<float> vertices(dimension * vertex_count);
+    fill_random(vertices.data(), vertices.size(), 83U);
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      const float scale = 1.0f + static_cast<float>(axis);  // distinct spreads per axis
+      for (std::size_t v = 0; v < vertex_count; ++v) {
+        vertices[axis * vertex_count + v] *= scale;
+      }
+    }
+
+    std::vector<float> basis(dimension * 3);
+    std::vector<float> eigenvalues(dimension);
+    ndvis::JacobiReport report{};
+    ndvis::EigenParams jacobi{};
+    jacobi.solver = ndvis::EigenSolver::kJacobi;
+    ndvis::compute_pca_basis_with_values(vertices.data(), vertex_count, dimension, basis.data(), eigenvalues.data(),
+                                         jacobi, &report);
+    assert(report.converged);
+    assert(report.sweeps > 0 && report.sweeps < 16);
+    assert(report.rotations > 0);
+    assert(report.off_norm <= 1e-10 * 200.0);
+    assert(report.max_residual < 1e-9);
+    for (std::size_t i = 1; i < dimension; ++i) {
+      assert(eigenvalues[i - 1] >= eigenvalues[i]);
+    }
+
+    // The report matches a direct solve of a known spectrum: Q diag(1..n) Q^T
+    std::vector<double> q(dimension * dimension);
+    std::vector<float> rotation(dimension * dimension);
+    fill_identity(rotation.data(), dimension);
+    for (unsigned int i = 0; i + 1 < dimension; ++i) {
+      ndvis::apply_givens(rotation.data(), dimension, {i, i + 1, 0.3f + 0.1f * static_cast<float>(i)});
+    }
+    for (std::size_t i = 0; i < q.size(); ++i) {
+      q[i] = rotation[i];
+    }
+    std::vector<double> matrix(dimension * dimension, 0.0);
+    for (std::size_t r = 0; r < dimension; ++r) {
+      for (std::size_t c = 0; c < dimension; ++c) {
+        for (std::size_t k = 0; k < dimension; ++k) {
+          matrix[r * dimension + c] += q[r * dimension + k] * static_cast<double>(k + 1) * q[c * dimension + k];
+        }
+      }
+    }
+    std::vector<double> eigenvectors(dimension * dimension);
+    ndvis::detail::JacobiReport direct{};
+    ndvis::detail::jacobi_symmetric(matrix.data(), eigenvectors.data(), dimension, ndvis::detail::JacobiParams{},
+                                    &direct);
+    assert(direct.converged);
+    assert(direct.max_residual < 1e-8);
+    std::vector<double> values(dimension);
+    for (std::size_t i = 0; i < dimension; ++i) {
+      values[i] = matrix[i * dimension + i];
+    }
+    ndvis::detail::sort_eigenpairs(values.data(), eigenvectors.data(), dimension);
+    for (std::size_t i = 0; i < dimension; ++i) {
+      assert(std::abs(values[i] - static_cast<double>(dimension - i)) < 1e-5);  // Q is float-orthogonal
+    }
+
+    // One sweep is not enough; the report says so
+    std::vector<double> copy(dimension * dimension, 0.0);
+    for (std::size_t r = 0; r < dimension; ++r) {
+      for (std::size_t c = 0; c < dimension; ++c) {
+        for (std::size_t k = 0; k < dimension; ++k) {
+          copy[r * dimension + c] += q[r * dimension + k] * static_cast<double>(k + 1) * q[c * dimension + k];
+        }
+      }
+    }
+    ndvis::detail::JacobiParams one_sweep{};
+    one_sweep.max_sweeps = 1;
+    ndvis::detail::JacobiReport partial{};
+    ndvis::detail::jacobi_symmetric(copy.data(), eigenvectors.data(), dimension, one_sweep, &partial);
+    assert(!partial.converged);
+    assert(partial.sweeps == 1);
+    assert(partial.off_norm > 0.0);
+
+    NdvisJacobiReport c_report{};
+    std::vector<float> c_basis(dimension * 3);
+    ndvis_compute_pca_with_report(NdvisBuffer{vertices.data(), vertices.size()}, vertex_count, dimension,
+                                  NdvisBasis3{c_basis.data(), dimension, dimension},
+                                  NdvisBuffer{eigenvalues.data(), dimension}, &c_report);
+    assert(c_report.converged == 1);
+    ndvis_compute_pca_with_solver(NdvisBuffer{vertices.data(), vertices.size()}, vertex_count, dimension,
+                                  NdvisBasis3{c_basis.data(), dimension, dimension},
+                                  NdvisBuffer{eigenvalues.data(), dimension}, NDVIS_EIGEN_SOLVER_JACOBI, &c_report);
+    assert(c_report.sweeps == report.sweeps);
+    assert(c_report.max_residual == report.max_residual);
+  }
+
+  // Top-k PCA by subspace iteration matches the leading part of the full Jacobi solve
+  {
+    const std::size_t dimension = 48;
+    const std::size_t vertex_count = 600;
+    std::vector<float> vertices(dimension * vertex_count);
+    fill_random(vertices.data(), vertices.size(), 89U);
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      const float scale = 1.0f + 0.1f * static_cast<float>(axis);
+      for (std::size_t v = 0; v < vertex_count; ++v) {
+        // Mix neighbouring axes so the components are not coordinate axes
+        vertices[axis * vertex_count + v] =
+            scale * vertices[axis * vertex_count + v] + 0.5f * vertices[((axis + 1) % dimension) * vertex_count + v];
+      }
+    }
+
+    std::vector<float> full_basis(dimension * 3);
+    std::vector<float> full_values(dimension);
+    ndvis::compute_pca_basis_with_values(vertices.data(), vertex_count, dimension, full_basis.data(),
+                                         full_values.data());
+
+    const std::size_t count = 4;
+    std::vector<float> components(count * dimension);
+    std::vector<float> values(count);
+    ndvis::compute_pca_components(vertices.data(), vertex_count, dimension, count, components.data(), values.data());
+    std::vector<float> basis(dimension * 3);
+    ndvis::compute_pca_basis(vertices.data(), vertex_count, dimension, basis.data());
+
+    for (std::size_t component = 0; component < count; ++component) {
+      assert(approx_equal(values[component], full_values[component], 1e-4f * full_values[0]));
+    }
+    for (std::size_t component = 0; component < 3; ++component) {
+      float dot_components = 0.0f;
+      float dot_basis = 0.0f;
+      for (std::size_t axis = 0; axis < dimension; ++axis) {
+        dot_components += components[component * dimension + axis] * full_basis[component * dimension + axis];
+        dot_basis += basis[component * dimension + axis] * full_basis[component * dimension + axis];
+      }
+      assert(approx_equal(absolute(dot_components), 1.0f, 1e-4f));
+      assert(approx_equal(absolute(dot_basis), 1.0f, 1e-4f));
+    }
+
+    // Rank-deficient covariance: points on a 2-plane in n = 40
+    const std::size_t flat_dimension = 40;
+    std::vector<float> flat(flat_dimension * vertex_count, 0.0f);
+    fill_random(flat.data() + 3 * vertex_count, vertex_count, 97U);
+    fill_random(flat.data() + 17 * vertex_count, vertex_count, 101U);
+    for (std::size_t v = 0; v < vertex_count; ++v) {
+      flat[3 * vertex_count + v] *= 3.0f;
+    }
+    std::vector<float> flat_components(3 * flat_dimension);
+    std::vector<float> flat_values(3);
+    ndvis_compute_pca_components(NdvisBuffer{flat.data(), flat.size()}, vertex_count, flat_dimension, 3,
+                                 NdvisBuffer{flat_components.data(), flat_components.size()},
+                                 NdvisBuffer{flat_values.data(), 3});
+    assert(absolute(flat_components[0 * flat_dimension + 3]) > 0.99f);
+    assert(absolute(flat_components[1 * flat_dimension + 17]) > 0.99f);
+    assert(flat_values[0] > flat_values[1] && flat_values[1] > 0.0f);
+    assert(flat_values[2] < 1e-6f);
+  }
+
+  // Subspace iteration on rank-deficient matrices keeps an orthonormal basis once A X collapses
+  {
+    for (const std::size_t order : {std::size_t{6}, std::size_t{40}}) {
+      // A = 4 u u^T + w w^T with orthogonal u, w: rank 2, so most of the block's images vanish
+      std::vector<double> u(order, 0.0);
+      std::vector<double> w(order, 0.0);
+      for (std::size_t i = 0; i < order; ++i) {
+        u[i] = 1.0 / std::sqrt(static_cast<double>(order));
+        w[i] = (i % 2 == 0 ? 1.0 : -1.0) / std::sqrt(static_cast<double>(order));
+      }
+      std::vector<double> matrix(order * order);
+      for (std::size_t i = 0; i < order; ++i) {
+        for (std::size_t j = 0; j < order; ++j) {
+          matrix[i * order + j] = 4.0 * u[i] * u[j] + w[i] * w[j];
+        }
+      }
+      const std::size_t count = 3;
+      std::vector<double> values(count);
+      std::vector<double> vectors(order * count);
+      ndvis::detail::SubspaceReport report{};
+      assert(ndvis::detail::subspace_iteration(matrix.data(), order, count, ndvis::detail::SubspaceParams{},
+                                               values.data(), vectors.data(), &report));
+      assert(report.converged);
+      assert(std::abs(values[0] - 4.0) < 1e-10 && std::abs(values[1] - 1.0) < 1e-10 && std::abs(values[2]) < 1e-10);
+      for (std::size_t a = 0; a < count; ++a) {
+        for (std::size_t b = 0; b < count; ++b) {
+          double dot = 0.0;
+          for (std::size_t row = 0; row < order; ++row) {
+            dot += vectors[row * count + a] * vectors[row * count + b];
+          }
+          assert(std::abs(dot - (a == b ? 1.0 : 0.0)) < 1e-10);
+        }
+      }
+      double along_u = 0.0;
+      for (std::size_t row = 0; row < order; ++row) {
+        along_u += vectors[row * count] * u[row];
+      }
+      assert(std::abs(std::abs(along_u) - 1.0) < 1e-10);
+    }
+  }
+
+  // Subspace iteration converges to the leading eigenpairs, and reports failure after the iteration cap
+  {
+    const std::size_t order = 64;
+    // A = H diag(lambda) H with the reflector H = I - 2 h h^T, so the eigenvectors are the columns of H
+    std::vector<float> noise(order);
+    fill_random(noise.data(), order, 131U);
+    std::vector<double> h(order);
+    double h_norm = 0.0;
+    for (std::size_t i = 0; i < order; ++i) {
+      h[i] = noise[i];
+      h_norm += h[i] * h[i];
+    }
+    for (std::size_t i = 0; i < order; ++i) {
+      h[i] /= std::sqrt(h_norm);
+    }
+    std::vector<double> reflector(order * order);
+    for (std::size_t i = 0; i < order; ++i) {
+      for (std::size_t j = 0; j < order; ++j) {
+        reflector[i * order + j] = (i == j ? 1.0 : 0.0) - 2.0 * h[i] * h[j];
+      }
+    }
+    const auto build = [&](const std::vector<double>& lambda) {
+      std::vector<double> matrix(order * order, 0.0);
+      for (std::size_t i = 0; i < order; ++i) {
+        for (std::size_t j = 0; j < order; ++j) {
+          double sum = 0.0;
+          for (std::size_t k = 0; k < order; ++k) {
+            sum += reflector[i * order + k] * lambda[k] * reflector[k * order + j];
+          }
+          matrix[i * order + j] = sum;
+        }
+      }
+      return matrix;
+    };
+
+    std::vector<double> lambda(order);
+    for (std::size_t i = 0; i < order; ++i) {
+      lambda[i] = 1.0 / static_cast<double>(1 + i);
+    }
+    const std::vector<double> matrix = build(lambda);
+    const std::size_t count = 3;
+    std::vector<double> values(count);
+    std::vector<double> vectors(order * count);
+    ndvis::detail::SubspaceReport report{};
+    assert(ndvis::detail::subspace_iteration(matrix.data(), order, count, ndvis::detail::SubspaceParams{},
+                                             values.data(), vectors.data(), &report));
+    assert(report.converged && report.iterations < 200);
+    assert(report.max_residual <= 1e-8 * values[0]);
+    for (std::size_t col = 0; col < count; ++col) {
+      assert(std::abs(values[col] - lambda[col]) < 1e-9);
+      double dot = 0.0;
+      for (std::size_t row = 0; row < order; ++row) {
+        dot += vectors[row * count + col] * reflector[row * order + col];
+      }
+      assert(std::abs(std::abs(dot) - 1.0) < 1e-8);
+    }
+
+    // Leading eigenvalues packed within 1e-6 of each other: (lambda_{k+6} / lambda_k)^200 stays near 1
+    for (std::size_t i = 0; i < order; ++i) {
+      lambda[i] = 1.0 - 1.0e-8 * static_cast<double>(i);
+    }
+    const std::vector<double> clustered = build(lambda);
+    std::vector<double> untouched_values(count, -1.0);
+    std::vector<double> untouched_vectors(order * count, -1.0);
+    ndvis::detail::SubspaceReport stalled{};
+    assert(!ndvis::detail::subspace_iteration(clustered.data(), order, count, ndvis::detail::SubspaceParams{},
+                                              untouched_values.data(), untouched_vectors.data(), &stalled));
+    assert(!stalled.converged && stalled.iterations == 200);
+    for (const double value : untouched_values) {
+      assert(value == -1.0);
+    }
+    for (const double value : untouched_vectors) {
+      assert(value == -1.0);
+    }
+  }
+
+  // Blocked covariance matches a direct two-pass sum and is identical for 1 and 4 threads
+  {
+    const std::size_t dimension = 7;
+    const std::size_t vertex_count = 40003;  // three partials, ragged final block
+    std::vector<float> vertices(dimension * vertex_count);
+    fill_random(vertices.data(), vertices.size(), 103U);
+    for (std::size_t v = 0; v < vertex_count; ++v) {
+      vertices[2 * vertex_count + v] = 100.0f + 0.5f * vertices[v];  // offset and correlated axis
+    }
+
+    std::vector<double> mean(dimension);
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      for (std::size_t v = 0; v < vertex_count; ++v) {
+        mean[axis] += vertices[axis * vertex_count + v];
+      }
+      mean[axis] /= static_cast<double>(vertex_count);
+    }
+    std::vector<double> expected(dimension * dimension, 0.0);
+    for (std::size_t i = 0; i < dimension; ++i) {
+      for (std::size_t j = 0; j < dimension; ++j) {
+        for (std::size_t v = 0; v < vertex_count; ++v) {
+          expected[i * dimension + j] +=
+              (vertices[i * vertex_count + v] - mean[i]) * (vertices[j * vertex_count + v] - mean[j]);
+        }
+        expected[i * dimension + j] /= static_cast<double>(vertex_count - 1);
+      }
+    }
+
+    std::vector<double> results[2];
+    const std::size_t thread_counts[2] = {1, 4};
+    for (std::size_t run = 0; run < 2; ++run) {
+      ndvis::set_thread_count(thread_counts[run]);
+      std::vector<double> computed_mean(dimension);
+      results[run].resize(dimension * dimension);
+      ndvis::detail::compute_covariance(vertices.data(), vertex_count, dimension, computed_mean.data(),
+                                        results[run].data());
+      for (std::size_t axis = 0; axis < dimension; ++axis) {
+        assert(std::abs(computed_mean[axis] - mean[axis]) < 1e-9);
+      }
+    }
+    ndvis::set_thread_count(0);
+    for (std::size_t i = 0; i < dimension * dimension; ++i) {
+      assert(results[0][i] == results[1][i]);
+      assert(std::abs(results[0][i] - expected[i]) < 1e-9);
+    }
+
+    ndvis::detail::set_simd_level(ndvis::detail::SimdLevel::kScalar);
+    std::vector<double> scalar_mean(dimension);
+    std::vector<double> scalar(dimension * dimension);
+    ndvis::detail::compute_covariance(vertices.data(), vertex_count, dimension, scalar_mean.data(), scalar.data());
+    ndvis::detail::set_simd_level(ndvis::detail::detect_simd_level());
+    for (std::size_t i = 0; i < dimension * dimension; ++i) {
+      assert(std::abs(scalar[i] - expected[i]) < 1e-9);
+    }
+  }
+
+  // Streaming PCA: batch merges match a from-scratch PCA, and warm-started solves need few sweeps
+  {
+    const std::size_t dimension = 6;
+    const std::size_t batch = 500;
+    const std::size_t batch_count = 4;
+    std::vector<std::vector<float>> batches(batch_count, std::vector<float>(dimension * batch));
+    for (std::size_t b = 0; b < batch_count; ++b) {
+      fill_random(batches[b].data(), batches[b].size(), 107U + static_cast<unsigned int>(b));
+      for (std::size_t axis = 0; axis < dimension; ++axis) {
+        for (std::size_t v = 0; v < batch; ++v) {
+          float& value = batches[b][axis * batch + v];
+          value = value * (1.0f + static_cast<float>(axis)) + 0.3f * static_cast<float>(b);  // drifting mean
+        }
+      }
+    }
+    // SoA concatenation of batches [first, last)
+    auto concatenate = [&](std::size_t first, std::size_t last) {
+      const std::size_t total = (last - first) * batch;
+      std::vector<float> all(dimension * total);
+      for (std::size_t b = first; b < last; ++b) {
+        for (std::size_t axis = 0; axis < dimension; ++axis) {
+          for (std::size_t v = 0; v < batch; ++v) {
+            all[axis * total + (b - first) * batch + v] = batches[b][axis * batch + v];
+          }
+        }
+      }
+      return all;
+    };
+    auto check_against_scratch = [&](ndvis::StreamingPca& pca, std::size_t first, std::size_t last) {
+      const std::vector<float> all = concatenate(first, last);
+      float expected_basis[dimension * 3];
+      float expected_values[dimension];
+      ndvis::compute_pca_basis_with_values(all.data(), (last - first) * batch, dimension, expected_basis,
+                                           expected_values);
+      float basis[dimension * 3];
+      float values[dimension];
+      ndvis::JacobiReport report{};
+      pca.compute_basis(basis, values, &report);
+      assert(report.converged);
+      for (std::size_t i = 0; i < dimension; ++i) {
+        assert(approx_equal(values[i], expected_values[i], 1e-4f * expected_values[0]));
+      }
+      for (std::size_t component = 0; component < 3; ++component) {
+        float dot = 0.0f;
+        for (std::size_t axis = 0; axis < dimension; ++axis) {
+          dot += basis[component * dimension + axis] * expected_basis[component * dimension + axis];
+        }
+        assert(approx_equal(absolute(dot), 1.0f, 1e-4f));
+      }
+      return report;
+    };
+
+    ndvis::StreamingPca pca(dimension);
+    for (std::size_t b = 0; b < 3; ++b) {
+      pca.add_batch(batches[b].data(), batch);
+    }
+    assert(pca.count() == 3 * batch);
+    check_against_scratch(pca, 0, 3);
+
+    pca.add_batch(batches[3].data(), batch);
+    check_against_scratch(pca, 0, 4);
+
+    // A live-feed sized append barely moves the basis: the warm-started solve is nearly diagonal already
+    const std::size_t small = 8;
+    std::vector<float> small_batch(dimension * small);
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      for (std::size_t v = 0; v < small; ++v) {
+        small_batch[axis * small + v] = batches[2][axis * batch + v];
+      }
+    }
+    pca.add_batch(small_batch.data(), small);
+    float scratch_basis[dimension * 3];
+    ndvis::JacobiReport warm{};
+    pca.compute_basis(scratch_basis, nullptr, &warm);
+    assert(warm.converged);
+    const std::vector<float> fed = concatenate(0, 4);
+    std::vector<float> fed_all(dimension * (4 * batch + small));
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      for (std::size_t v = 0; v < 4 * batch; ++v) {
+        fed_all[axis * (4 * batch + small) + v] = fed[axis * 4 * batch + v];
+      }
+      for (std::size_t v = 0; v < small; ++v) {
+        fed_all[axis * (4 * batch + small) + 4 * batch + v] = small_batch[axis * small + v];
+      }
+    }
+    ndvis::JacobiReport cold{};
+    ndvis::EigenParams jacobi{};
+    jacobi.solver = ndvis::EigenSolver::kJacobi;
+    ndvis::compute_pca_basis_with_values(fed_all.data(), 4 * batch + small, dimension, scratch_basis, nullptr, jacobi,
+                                         &cold);
+    assert(warm.rotations < cold.rotations);
+    assert(warm.sweeps < cold.sweeps);
+    pca.remove_batch(small_batch.data(), small);
+
+    pca.remove_batch(batches[0].data(), batch);
+    check_against_scratch(pca, 1, 4);
+    const std::vector<float> remaining = concatenate(1, 4);
+    std::vector<double> mean(dimension);
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      for (std::size_t v = 0; v < 3 * batch; ++v) {
+        mean[axis] += remaining[axis * 3 * batch + v];
+      }
+      assert(std::abs(pca.mean()[axis] - mean[axis] / static_cast<double>(3 * batch)) < 1e-6);
+    }
+
+    // C handle
+    NdvisStreamingPca* handle = ndvis_streaming_pca_create(dimension);
+    assert(handle != nullptr);
+    for (std::size_t b = 0; b < batch_count; ++b) {
+      ndvis_streaming_pca_add(handle, NdvisBuffer{batches[b].data(), batches[b].size()}, batch);
+    }
+    assert(ndvis_streaming_pca_count(handle) == batch_count * batch);
+    float c_basis[dimension * 3];
+    float c_values[dimension];
+    NdvisJacobiReport c_report{};
+    ndvis_streaming_pca_compute(handle, NdvisBasis3{c_basis, dimension, dimension}, NdvisBuffer{c_values, dimension},
+                                &c_report);
+    assert(c_report.converged == 1);
+    ndvis_streaming_pca_reset(handle);
+    assert(ndvis_streaming_pca_count(handle) == 0);
+    ndvis_streaming_pca_destroy(handle);
+  }
+
+  // Workspace PCA: same result as the allocating path and no heap allocation per call
+  {
+    const std::size_t dimension = 9;
+    const std::size_t vertex_count = 50000;
+    std::vector<float> vertices(dimension * vertex_count);
+    fill_random(vertices.data(), vertices.size(), 109U);
+    for (std::size_t v = 0; v < vertex_count; ++v) {
+      vertices[4 * vertex_count + v] += 2.0f * vertices[v];
+    }
+
+    std::vector<float> expected_basis(dimension * 3);
+    std::vector<float> expected_values(dimension);
+    ndvis::compute_pca_basis_with_values(vertices.data(), vertex_count, dimension, expected_basis.data(),
+                                         expected_values.data());
+
+    std::vector<double> workspace(ndvis_pca_workspace_size(dimension));
+    std::vector<float> basis(dimension * 3);
+    std::vector<float> values(dimension);
+    assert(!ndvis::compute_pca_basis_with_workspace(vertices.data(), vertex_count, dimension, basis.data(),
+                                                    values.data(), workspace.data(), workspace.size() - 1));
+
+    ndvis::set_thread_count(4);
+    // First call warms the worker pool (thread creation allocates once).
+    assert(ndvis::compute_pca_basis_with_workspace(vertices.data(), vertex_count, dimension, basis.data(),
+                                                   values.data(), workspace.data(), workspace.size()));
+    const std::size_t before = g_allocations.load();
+    for (int repeat = 0; repeat < 3; ++repeat) {
+      const int status = ndvis_compute_pca_with_workspace(
+          NdvisBuffer{vertices.data(), vertices.size()}, vertex_count, dimension,
+          NdvisBasis3{basis.data(), dimension, dimension}, NdvisBuffer{values.data(), dimension}, workspace.data(),
+          workspace.size());
+      assert(status == 0);
+    }
+    assert(g_allocations.load() == before);
+    ndvis::set_thread_count(0);
+
+    for (std::size_t i = 0; i < dimension; ++i) {
+      assert(values[i] == expected_values[i]);
+    }
+    for (std::size_t i = 0; i < dimension * 3; ++i) {
+      assert(basis[i] == expected_basis[i]);
+    }
+  }
+
+  // Progressive PCA: sample basis within its Davis-Kahan bound, chunked refinement matches the exact PCA
+  {
+    const std::size_t dimension = 8;
+    const std::size_t vertex_count = 200000;
+    std::vector<float> vertices(dimension * vertex_count);
+    fill_random(vertices.data(), vertices.size(), 113U);
+    const float scales[dimension] = {3.0f, 2.0f, 1.4f, 0.6f, 0.5f, 0.4f, 0.3f, 0.2f};
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      for (std::size_t v = 0; v < vertex_count; ++v) {
+        vertices[axis * vertex_count + v] *= scales[axis];
+      }
+    }
+    for (std::size_t v = 0; v < vertex_count; ++v) {
+      vertices[5 * vertex_count + v] += 0.5f * vertices[v];
+    }
+
+    std::vector<float> exact_basis(dimension * 3);
+    std::vector<float> exact_values(dimension);
+    ndvis::compute_pca_basis_with_values(vertices.data(), vertex_count, dimension, exact_basis.data(),
+                                         exact_values.data());
+
+    ndvis::ProgressivePcaParams params{};
+    params.sample_size = 4096;
+    ndvis::ProgressivePca pca(dimension, params);
+    pca.begin(vertices.data(), vertex_count);
+    assert(!pca.refined());
+
+    std::vector<float> basis(dimension * 3);
+    std::vector<float> values(dimension);
+    ndvis::PcaConfidence confidence{};
+    pca.approximate_basis(basis.data(), values.data(), &confidence);
+    assert(confidence.sample_count == params.sample_size);
+    assert(confidence.vertex_count == vertex_count);
+    assert(!confidence.exact);
+    assert(confidence.perturbation > 0.0);
+    assert(confidence.eigengap > 0.0 && confidence.min_gap <= confidence.eigengap);
+    assert(confidence.subspace_error > 0.0 && confidence.subspace_error < 0.5);
+    assert(confidence.component_error >= confidence.subspace_error);
+
+    // Largest principal angle between the sample and exact x/y/z subspaces stays under the estimate.
+    double worst_sine = 0.0;
+    for (std::size_t i = 0; i < 3; ++i) {
+      double captured = 0.0;
+      for (std::size_t j = 0; j < 3; ++j) {
+        double dot = 0.0;
+        for (std::size_t axis = 0; axis < dimension; ++axis) {
+          dot += static_cast<double>(basis[j * dimension + axis]) * exact_basis[i * dimension + axis];
+        }
+        captured += dot * dot;
+      }
+      const double sine = std::sqrt(captured < 1.0 ? 1.0 - captured : 0.0);
+      worst_sine = sine > worst_sine ? sine : worst_sine;
+    }
+    assert(worst_sine <= confidence.subspace_error);
+    for (std::size_t i = 0; i < 3; ++i) {
+      assert(std::abs(values[i] - exact_values[i]) < 0.1f * exact_values[i]);
+    }
+
+    std::vector<float> refined_basis(dimension * 3);
+    std::vector<float> refined_values(dimension);
+    assert(!pca.refined_basis(refined_basis.data(), refined_values.data()));
+    std::size_t steps = 0;
+    while (!pca.refine_step(30000)) {
+      ++steps;
+      assert(pca.progress() < 1.0);
+    }
+    assert(steps == 6);
+    assert(pca.progress() == 1.0);
+    assert(pca.refined_basis(refined_basis.data(), refined_values.data()));
+    for (std::size_t i = 0; i < dimension; ++i) {
+      assert(std::abs(refined_values[i] - exact_values[i]) <= 1e-4f * exact_values[0]);
+    }
+    for (std::size_t component = 0; component < 3; ++component) {
+      double dot = 0.0;
+      for (std::size_t axis = 0; axis < dimension; ++axis) {
+        dot += static_cast<double>(refined_basis[component * dimension + axis]) *
+               exact_basis[component * dimension + axis];
+      }
+      assert(std::abs(dot) > 0.9999);
+    }
+    // The sample result stays available after refinement.
+    std::vector<float> again(dimension * 3);
+    pca.approximate_basis(again.data(), nullptr, nullptr);
+    assert(again == basis);
+
+    // A sample covering every vertex is exact immediately.
+    params.sample_size = vertex_count;
+    ndvis::ProgressivePca full(dimension, params);
+    full.begin(vertices.data(), vertex_count);
+    assert(full.refined());
+    full.approximate_basis(basis.data(), values.data(), &confidence);
+    assert(confidence.exact && confidence.subspace_error == 0.0);
+    assert(confidence.perturbation == 0.0 && confidence.component_error == 0.0);
+    assert(confidence.eigengap > 0.0 && confidence.min_gap > 0.0);
+    for (std::size_t i = 0; i < dimension; ++i) {
+      assert(values[i] == exact_values[i]);
+    }
+
+    // C handle
+    NdvisProgressivePca* handle = ndvis_progressive_pca_create(dimension, 2048, 7ULL);
+    assert(handle != nullptr);
+    assert(ndvis_progressive_pca_begin(handle, NdvisBuffer{vertices.data(), vertices.size() - 1}, vertex_count) == 1);
+    assert(ndvis_progressive_pca_begin(handle, NdvisBuffer{vertices.data(), vertices.size()}, vertex_count) == 0);
+    NdvisPcaConfidence c_confidence{};
+    assert(ndvis_progressive_pca_approximate(handle, NdvisBasis3{basis.data(), dimension, dimension},
+                                             NdvisBuffer{values.data(), dimension}, &c_confidence) == 0);
+    assert(c_confidence.sample_count == 2048 && c_confidence.exact == 0);
+    assert(ndvis_progressive_pca_refined(handle, NdvisBasis3{basis.data(), dimension, dimension},
+                                         NdvisBuffer{nullptr, 0}) == 1);
+    assert(ndvis_progressive_pca_refine(handle, vertex_count) == 1);
+    assert(ndvis_progressive_pca_progress(handle) == 1.0);
+    assert(ndvis_progressive_pca_refined(handle, NdvisBasis3{basis.data(), dimension, dimension},
+                                         NdvisBuffer{nullptr, 0}) == 0);
+    ndvis_progressive_pca_destroy(handle);
+  }
+
+  // Cluster PCA: one pass matches per-cluster gathers, independent of the thread count
+  {
+    const std::size_t dimension = 6;
+    const std::size_t vertex_count = 60000;
+    const std::size_t label_count = 5;
+    std::vector<float> vertices(dimension * vertex_count);
+    fill_random(vertices.data(), vertices.size(), 127U);
+    std::vector<ndvis::index_type> labels(vertex_count);
+    unsigned int state = 131U;
+    for (std::size_t v = 0; v < vertex_count; ++v) {
+      // Label 3 stays empty and label_count marks unlabeled vertices.
+      state = state * 1664525U + 1013904223U;
+      ndvis::index_type label = static_cast<ndvis::index_type>((state >> 8) % (label_count + 1));
+      label = label == 3 ? static_cast<ndvis::index_type>(label_count) : label;
+      labels[v] = label;
+      for (std::size_t axis = 0; axis < dimension; ++axis) {
+        const float scale = 1.0f + static_cast<float>((axis + label) % dimension);
+        vertices[axis * vertex_count + v] = vertices[axis * vertex_count + v] * scale + 500.0f * label;
+      }
+    }
+
+    std::vector<float> bases(label_count * 3 * dimension);
+    std::vector<float> means(label_count * dimension);
+    std::vector<float> covariances(label_count * dimension * dimension);
+    std::vector<float> values(label_count * dimension);
+    std::vector<std::size_t> counts(label_count);
+    const ndvis::ClusterPcaOutputs outputs{bases.data(), means.data(), covariances.data(), values.data(),
+                                           counts.data()};
+    ndvis::set_thread_count(1);
+    assert(ndvis::compute_cluster_pca(vertices.data(), vertex_count, dimension, labels.data(), label_count, outputs));
+
+    std::size_t labeled = 0;
+    for (std::size_t label = 0; label < label_count; ++label) {
+      std::vector<float> gathered;
+      for (std::size_t axis = 0; axis < dimension; ++axis) {
+        for (std::size_t v = 0; v < vertex_count; ++v) {
+          if (labels[v] == label) {
+            gathered.push_back(vertices[axis * vertex_count + v]);
+          }
+        }
+      }
+      const std::size_t count = gathered.size() / dimension;
+      assert(counts[label] == count);
+      labeled += count;
+      if (count == 0) {
+        assert(label == 3);
+        for (std::size_t i = 0; i < dimension; ++i) {
+          assert(values[label * dimension + i] == 0.0f);
+          assert(bases[label * 3 * dimension + i] == (i == 0 ? 1.0f : 0.0f));
+        }
+        continue;
+      }
+      std::vector<double> expected_mean(dimension);
+      std::vector<double> expected_covariance(dimension * dimension);
+      ndvis::detail::compute_covariance(gathered.data(), count, dimension, expected_mean.data(),
+                                        expected_covariance.data());
+      for (std::size_t i = 0; i < dimension; ++i) {
+        assert(std::abs(means[label * dimension + i] - expected_mean[i]) < 1e-3);
+      }
+      for (std::size_t i = 0; i < dimension * dimension; ++i) {
+        assert(std::abs(covariances[label * dimension * dimension + i] - expected_covariance[i]) < 1e-4);
+      }
+      std::vector<float> expected_basis(3 * dimension);
+      std::vector<float> expected_values(dimension);
+      ndvis::compute_pca_basis_with_values(gathered.data(), count, dimension, expected_basis.data(),
+                                           expected_values.data());
+      for (std::size_t i = 0; i < dimension; ++i) {
+        assert(std::abs(values[label * dimension + i] - expected_values[i]) <= 1e-5f * expected_values[0]);
+      }
+      for (std::size_t component = 0; component < 3; ++component) {
+        double dot = 0.0;
+        for (std::size_t axis = 0; axis < dimension; ++axis) {
+          dot += static_cast<double>(bases[label * 3 * dimension + component * dimension + axis]) *
+                 expected_basis[component * dimension + axis];
+        }
+        assert(std::abs(dot) > 0.9999);
+      }
+    }
+    assert(labeled < vertex_count);
+
+    ndvis::set_thread_count(4);
+    std::vector<float> threaded_bases(bases.size());
+    std::vector<float> threaded_covariances(covariances.size());
+    std::vector<unsigned int> c_counts(label_count);
+    NdvisClusterPcaOutputs c_outputs{NdvisBuffer{threaded_bases.data(), threaded_bases.size()},
+                                     NdvisBuffer{},
+                                     NdvisBuffer{threaded_covariances.data(), threaded_covariances.size()},
+                                     NdvisBuffer{},
+                                     NdvisIndexBuffer{c_counts.data(), c_counts.size()}};
+    const NdvisBuffer c_vertices{vertices.data(), vertices.size()};
+    const NdvisIndexBuffer c_labels{labels.data(), labels.size()};
+    assert(ndvis_compute_cluster_pca(c_vertices, vertex_count, dimension, c_labels, label_count, c_outputs) == 0);
+    assert(threaded_bases == bases);
+    assert(threaded_covariances == covariances);
+    for (std::size_t label = 0; label < label_count; ++label) {
+      assert(c_counts[label] == counts[label]);
+    }
+    assert(ndvis_compute_cluster_pca(c_vertices, vertex_count, dimension, c_labels, 0, c_outputs) == 1);
+
+    // Every requested output and the label array are checked against their lengths
+    std::vector<float> untouched(threaded_bases.size(), -1.0f);
+    NdvisClusterPcaOutputs short_outputs = c_outputs;
+    short_outputs.bases = NdvisBuffer{untouched.data(), untouched.size() - 1};
+    assert(ndvis_compute_cluster_pca(c_vertices, vertex_count, dimension, c_labels, label_count, short_outputs) == 1);
+    short_outputs = c_outputs;
+    short_outputs.bases = NdvisBuffer{untouched.data(), untouched.size()};
+    short_outputs.covariances.length -= 1;
+    assert(ndvis_compute_cluster_pca(c_vertices, vertex_count, dimension, c_labels, label_count, short_outputs) == 1);
+    short_outputs = c_outputs;
+    short_outputs.bases = NdvisBuffer{untouched.data(), untouched.size()};
+    short_outputs.counts.length = label_count - 1;
+    assert(ndvis_compute_cluster_pca(c_vertices, vertex_count, dimension, c_labels, label_count, short_outputs) == 1);
+    short_outputs = c_outputs;
+    short_outputs.bases = NdvisBuffer{untouched.data(), untouched.size()};
+    assert(ndvis_compute_cluster_pca(c_vertices, vertex_count, dimension,
+                                     NdvisIndexBuffer{labels.data(), vertex_count - 1}, label_count,
+                                     short_outputs) == 1);
+    for (const float value : untouched) {
+      assert(value == -1.0f);
+    }
+    ndvis::set_thread_count(0);
+  }
+
+  // Cluster PCA with many labels drops to fewer moment partials and still matches direct sums
+  {
+    const std::size_t dimension = 8;
+    const std::size_t vertex_count = 50000;  // four partials by size
+    const std::size_t label_count = 20000;   // one partial of moments already fills the budget
+    std::vector<float> vertices(dimension * vertex_count);
+    fill_random(vertices.data(), vertices.size(), 139U);
+    std::vector<ndvis::index_type> labels(vertex_count);
+    for (std::size_t v = 0; v < vertex_count; ++v) {
+      labels[v] = static_cast<ndvis::index_type>((v * 7919U) % label_count);
+    }
+    std::vector<float> bases(label_count * 3 * dimension);
+    std::vector<float> means(label_count * dimension);
+    std::vector<std::size_t> counts(label_count);
+    ndvis::set_thread_count(4);
+    assert(ndvis::compute_cluster_pca(vertices.data(), vertex_count, dimension, labels.data(), label_count,
+                                      ndvis::ClusterPcaOutputs{bases.data(), means.data(), nullptr, nullptr,
+                                                               counts.data()}));
+    std::vector<double> expected_means(label_count * dimension, 0.0);
+    std::vector<std::size_t> expected_counts(label_count, 0);
+    for (std::size_t v = 0; v < vertex_count; ++v) {
+      ++expected_counts[labels[v]];
+      for (std::size_t axis = 0; axis < dimension; ++axis) {
+        expected_means[labels[v] * dimension + axis] += vertices[axis * vertex_count + v];
+      }
+    }
+    for (std::size_t label = 0; label < label_count; ++label) {
+      assert(counts[label] == expected_counts[label]);
+      for (std::size_t axis = 0; axis < dimension; ++axis) {
+        const double expected = expected_means[label * dimension + axis] / static_cast<double>(counts[label]);
+        assert(std::abs(means[label * dimension + axis] - expected) < 1e-5);
+      }
+    }
+    ndvis::set_thread_count(1);
+    std::vector<float> serial_bases(bases.size());
+    assert(ndvis::compute_cluster_pca(vertices.data(), vertex_count, dimension, labels.data(), label_count,
+                                      ndvis::ClusterPcaOutputs{serial_bases.data()}));
+    assert(serial_bases == bases);
+    ndvis::set_thread_count(0);
+  }
+
+  // Householder + QL matches Jacobi, including diagonal, repeated and zero spectra
+  {
+    for (const std::size_t order : {1U, 2U, 3U, 5U, 12U, 64U, 130U}) {
+      for (int kind = 0; kind < 4; ++kind) {
+        std::vector<double> matrix(order * order, 0.0);
+        if (kind == 0) {
+          std::vector<float> samples(order * 2 * order);
+          fill_random(samples.data(), samples.size(), 137U + static_cast<unsigned int>(order));
+          for (std::size_t r = 0; r < order; ++r) {
+            for (std::size_t c = 0; c < order; ++c) {
+              for (std::size_t k = 0; k < 2 * order; ++k) {
+                matrix[r * order + c] += static_cast<double>(samples[r * 2 * order + k]) * samples[c * 2 * order + k];
+              }
+            }
+          }
+        } else if (kind == 1) {
+          for (std::size_t i = 0; i < order; ++i) {
+            matrix[i * order + i] = static_cast<double>(order - i);
+          }
+        } else if (kind == 2) {
+          // Spectrum {2 (x half), 1}: all-ones block plus identity.
+          for (std::size_t r = 0; r < order; ++r) {
+            for (std::size_t c = 0; c < order; ++c) {
+              matrix[r * order + c] = (r == c ? 1.0 : 0.0) + (r < order / 2 && c < order / 2 ? 1.0 : 0.0);
+            }
+          }
+        }
+        const std::vector<double> input = matrix;
+        std::vector<double> jacobi_matrix = matrix;
+        std::vector<double> ql_vectors(order * order);
+        std::vector<double> jacobi_vectors(order * order);
+        ndvis::detail::JacobiReport report{};
+        ndvis::detail::tridiagonal_ql_symmetric(matrix.data(), ql_vectors.data(), order, 30, &report);
+        ndvis::detail::jacobi_symmetric(jacobi_matrix.data(), jacobi_vectors.data(), order,
+                                        ndvis::detail::JacobiParams{});
+        assert(report.converged);
+        double scale = 1.0;
+        for (const double value : input) {
+          scale = std::abs(value) > scale ? std::abs(value) : scale;
+        }
+        assert(report.max_residual < 1e-12 * scale * static_cast<double>(order));
+
+        std::vector<double> ql_values(order);
+        std::vector<double> jacobi_values(order);
+        for (std::size_t i = 0; i < order; ++i) {
+          ql_values[i] = matrix[i * order + i];
+          jacobi_values[i] = jacobi_matrix[i * order + i];
+          for (std::size_t j = 0; j < order; ++j) {
+            assert(i == j || matrix[i * order + j] == 0.0);
+          }
+        }
+        ndvis::detail::sort_eigenpairs(ql_values.data(), ql_vectors.data(), order);
+        ndvis::detail::sort_eigenpairs(jacobi_values.data(), jacobi_vectors.data(), order);
+        for (std::size_t i = 0; i < order; ++i) {
+          assert(std::abs(ql_values[i] - jacobi_values[i]) < 1e-10 * scale * static_cast<double>(order));
+          for (std::size_t j = 0; j < order; ++j) {
+            double dot = 0.0;
+            for (std::size_t k = 0; k < order; ++k) {
+              dot += ql_vectors[k * order + i] * ql_vectors[k * order + j];
+            }
+            assert(std::abs(dot - (i == j ? 1.0 : 0.0)) < 1e-12 * static_cast<double>(order));
+          }
+        }
+      }
+    }
+
+    // PCA through either solver agrees on a well-separated spectrum.
+    const std::size_t dimension = 20;
+    const std::size_t vertex_count = 3000;
+    std::vector<float> vertices(dimension * vertex_count);
+    fill_random(vertices.data(), vertices.size(), 139U);
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      for (std::size_t v = 0; v < vertex_count; ++v) {
+        vertices[axis * vertex_count + v] *= 1.0f + 0.5f * static_cast<float>(axis);
+      }
+    }
+    std::vector<float> jacobi_basis(dimension * 3);
+    std::vector<float> ql_basis(dimension * 3);
+    std::vector<float> jacobi_values(dimension);
+    std::vector<float> ql_values(dimension);
+    ndvis::EigenParams params{};
+    params.solver = ndvis::EigenSolver::kJacobi;
+    ndvis::compute_pca_basis_with_values(vertices.data(), vertex_count, dimension, jacobi_basis.data(),
+                                         jacobi_values.data(), params, nullptr);
+    params.solver = ndvis::EigenSolver::kTridiagonalQl;
+    ndvis::JacobiReport report{};
+    ndvis::compute_pca_basis_with_values(vertices.data(), vertex_count, dimension, ql_basis.data(), ql_values.data(),
+                                         params, &report);
+    assert(report.converged && report.sweeps > 0 && report.off_norm == 0.0);
+    for (std::size_t i = 0; i < dimension; ++i) {
+      assert(std::abs(ql_values[i] - jacobi_values[i]) <= 1e-5f * jacobi_values[0]);
+    }
+    for (std::size_t component = 0; component < 3; ++component) {
+      double dot = 0.0;
+      for (std::size_t axis = 0; axis < dimension; ++axis) {
+        dot += static_cast<double>(ql_basis[component * dimension + axis]) * jacobi_basis[component * dimension + axis];
+      }
+      assert(std::abs(dot) > 0.99999);
+    }
+  }
+
+  // Workspace slicing matches an independent per-edge reference at several thread counts and does not
+  // allocate once the pool is warm
+  {
+    // Known cut: x1 = 0.25 through the 3-cube crosses the four x1-edges, which come first in edge order
+    {
+      std::vector<float> cube(8 * 3);
+      std::vector<unsigned int> cube_edges(12 * 2);
+      ndvis::generate_hypercube(3, ndvis::BufferView{cube.data(), cube.size()},
+                                ndvis::IndexBufferView{cube_edges.data(), cube_edges.size()});
+      const float x_axis[3] = {1.0f, 0.0f, 0.0f};
+      std::vector<float> cube_workspace(ndvis::slice_workspace_size(8));
+      std::vector<float> cut(12 * 3);
+      std::vector<unsigned int> cut_edges(12);
+      const ndvis::SliceResult known = ndvis::slice_polytope(
+          ndvis::ConstBufferView{cube.data(), cube.size()}, 8, 3,
+          ndvis::ConstIndexBufferView{cube_edges.data(), cube_edges.size()}, ndvis::Hyperplane{x_axis, 3, 0.25f},
+          ndvis::BufferView{cut.data(), cut.size()}, ndvis::IndexBufferView{cut_edges.data(), cut_edges.size()},
+          cube_workspace.data(), cube_workspace.size());
+      assert(known.intersection_count == 4);
+      const float expected_yz[4][2] = {{-1.0f, -1.0f}, {1.0f, -1.0f}, {-1.0f, 1.0f}, {1.0f, 1.0f}};
+      for (std::size_t hit = 0; hit < 4; ++hit) {
+        assert(cut_edges[hit] == hit);
+        assert(cut[hit] == 0.25f);
+        assert(cut[4 + hit] == expected_yz[hit][0]);
+        assert(cut[8 + hit] == expected_yz[hit][1]);
+      }
+    }
+
+    const int dimension = 12;
+    const std::size_t n = static_cast<std::size_t>(dimension);
+    const std::size_t vertex_count = ndvis::hypercube_vertex_count(dimension);
+    const std::size_t edge_count = ndvis::hypercube_edge_count(dimension);
+    std::vector<float> vertices(vertex_count * n);
+    std::vector<unsigned int> edges(edge_count * 2);
+    ndvis::generate_hypercube(dimension, ndvis::BufferView{vertices.data(), vertices.size()},
+                              ndvis::IndexBufferView{edges.data(), edges.size()});
+    std::vector<float> normal(n);
+    fill_random(normal.data(), n, 149U);
+    const ndvis::Hyperplane plane{normal.data(), n, 0.2f};
+    const ndvis::ConstBufferView view{vertices.data(), vertices.size()};
+    const ndvis::ConstIndexBufferView edge_view{edges.data(), edges.size()};
+
+    // Serial reference: double distances, the epsilon rules spelled out, hits appended in edge order
+    std::vector<double> reference_distances(vertex_count);
+    for (std::size_t v = 0; v < vertex_count; ++v) {
+      double dot = 0.0;
+      for (std::size_t axis = 0; axis < n; ++axis) {
+        dot += static_cast<double>(normal[axis]) * vertices[axis * vertex_count + v];
+      }
+      reference_distances[v] = dot - 0.2;
+    }
+    const auto side = [](double distance) { return std::abs(distance) < 1e-5 ? 0 : (distance > 0.0 ? 1 : -1); };
+    std::vector<unsigned int> expected_edges;
+    std::vector<std::vector<float>> expected_hits;
+    for (std::size_t e = 0; e < edge_count; ++e) {
+      const unsigned int v0 = edges[2 * e];
+      const unsigned int v1 = edges[2 * e + 1];
+      const int side0 = side(reference_distances[v0]);
+      const int side1 = side(reference_distances[v1]);
+      if (!(side0 * side1 < 0 || (side0 == 0) != (side1 == 0))) {
+        continue;
+      }
+      const double d0 = reference_distances[v0];
+      const double d1 = reference_distances[v1];
+      const double t = std::abs(d0 - d1) > 1e-5 ? d0 / (d0 - d1) : (std::abs(d0) < 1e-5 ? 0.0 : 1.0);
+      std::vector<float> hit(n);
+      for (std::size_t axis = 0; axis < n; ++axis) {
+        const double a = vertices[axis * vertex_count + v0];
+        const double b = vertices[axis * vertex_count + v1];
+        hit[axis] = static_cast<float>(a + t * (b - a));
+      }
+      expected_edges.push_back(static_cast<unsigned int>(e));
+      expected_hits.push_back(hit);
+    }
+    const std::size_t expected_count = expected_edges.size();
+    assert(expected_count > 0);
+
+    std::vector<float> workspace(ndvis_slice_workspace_size(vertex_count));
+    std::vector<float> points(edge_count * n);
+    std::vector<unsigned int> edge_ids(edge_count);
+    const ndvis::SliceResult short_workspace =
+        ndvis::slice_polytope(view, vertex_count, n, edge_view, plane, ndvis::BufferView{points.data(), points.size()},
+                              ndvis::IndexBufferView{edge_ids.data(), edge_ids.size()}, workspace.data(),
+                              workspace.size() - 1);
+    assert(short_workspace.intersection_count == 0);
+
+    for (const std::size_t threads : {std::size_t{1}, std::size_t{3}, std::size_t{4}}) {
+      ndvis::set_thread_count(threads);
+      std::fill(points.begin(), points.end(), 0.0f);
+      std::fill(edge_ids.begin(), edge_ids.end(), 0U);
+      ndvis::slice_polytope(view, vertex_count, n, edge_view, plane, ndvis::BufferView{points.data(), points.size()},
+                            ndvis::IndexBufferView{edge_ids.data(), edge_ids.size()}, workspace.data(),
+                            workspace.size());
+      const std::size_t before = g_allocations.load();
+      NdvisSliceResult result{};
+      for (int repeat = 0; repeat < 3; ++repeat) {
+        result = ndvis_slice_polytope_with_workspace(
+            NdvisBuffer{vertices.data(), vertices.size()}, vertex_count, n,
+            NdvisIndexBuffer{edges.data(), edges.size()}, NdvisHyperplane{normal.data(), n, 0.2f},
+            NdvisBuffer{points.data(), points.size()}, NdvisIndexBuffer{edge_ids.data(), edge_ids.size()},
+            workspace.data(), workspace.size());
+      }
+      assert(g_allocations.load() == before);
+
+      assert(result.intersection_count == expected_count);
+      for (std::size_t hit = 0; hit < expected_count; ++hit) {
+        assert(edge_ids[hit] == expected_edges[hit]);
+        for (std::size_t axis = 0; axis < n; ++axis) {
+          assert(approx_equal(points[axis * expected_count + hit], expected_hits[hit][axis], 1e-5f));
+        }
+      }
+    }
+    ndvis::set_thread_count(0);
+
+    // Capacity smaller than the hit count keeps the leading hits
+    std::vector<float> capped_points(4 * n);
+    const ndvis::SliceResult capped = ndvis::slice_polytope(
+        view, vertex_count, n, edge_view, plane, ndvis::BufferView{capped_points.data(), capped_points.size()},
+        ndvis::IndexBufferView{}, workspace.data(), workspace.size());
+    assert(capped.intersection_count == 4);
+    for (std::size_t axis = 0; axis < n; ++axis) {
+      for (std::size_t hit = 0; hit < 4; ++hit) {
+        assert(capped_points[axis * 4 + hit] == points[axis * expected_count + hit]);
+      }
+    }
+  }
+
+  // Signed distances are identical at every SIMD level and feed classification and slicing
+  {
+    const std::size_t dimension = 7;
+    const std::size_t vertex_count = 1000;  // not a multiple of any vector width
+    std::vector<float> vertices(dimension * vertex_count);
+    fill_random(vertices.data(), vertices.size(), 151U);
+    std::vector<float> normal(dimension);
+    fill_random(normal.data(), dimension, 157U);
+    const ndvis::Hyperplane plane{normal.data(), dimension, 0.1f};
+    const ndvis::ConstBufferView view{vertices.data(), vertices.size()};
+
+    std::vector<float> expected(vertex_count);
+    std::vector<float> point(dimension);
+    for (std::size_t v = 0; v < vertex_count; ++v) {
+      for (std::size_t axis = 0; axis < dimension; ++axis) {
+        point[axis] = vertices[axis * vertex_count + v];
+      }
+      expected[v] = ndvis::point_to_hyperplane_distance(point.data(), plane);
+    }
+
+    const ndvis::detail::SimdLevel levels[] = {
+        ndvis::detail::SimdLevel::kScalar, ndvis::detail::SimdLevel::kSse41,
+        ndvis::detail::SimdLevel::kAvx2,   ndvis::detail::SimdLevel::kAvx512,
+        ndvis::detail::SimdLevel::kNeon,   ndvis::detail::SimdLevel::kWasmSimd128,
+    };
+    std::vector<float> distances(vertex_count);
+    for (const auto level : levels) {
+      if (!ndvis::detail::simd_level_supported(level)) {
+        continue;
+      }
+      ndvis::detail::set_simd_level(level);
+      std::fill(distances.begin(), distances.end(), 0.0f);
+      ndvis::compute_signed_distances(view, vertex_count, dimension, plane, distances.data());
+      assert(distances == expected);
+    }
+    ndvis::detail::set_simd_level(ndvis::detail::detect_simd_level());
+
+    std::vector<int> from_vertices(vertex_count);
+    std::vector<int> from_distances(vertex_count);
+    ndvis::classify_vertices(view, vertex_count, dimension, plane, from_vertices.data());
+    ndvis_classify_distances(distances.data(), vertex_count, from_distances.data());
+    assert(from_vertices == from_distances);
+
+    // Random edges; slicing from the kept distances matches slicing from scratch
+    const std::size_t edge_count = 3000;
+    std::vector<unsigned int> edges(edge_count * 2);
+    unsigned int state = 163U;
+    for (unsigned int& index : edges) {
+      state = state * 1664525U + 1013904223U;
+      index = (state >> 8) % static_cast<unsigned int>(vertex_count);
+    }
+    std::vector<float> expected_points(edge_count * dimension);
+    std::vector<unsigned int> expected_edges(edge_count);
+    const ndvis::SliceResult reference = ndvis::slice_polytope(
+        view, vertex_count, dimension, ndvis::ConstIndexBufferView{edges.data(), edges.size()}, plane,
+        ndvis::BufferView{expected_points.data(), expected_points.size()},
+        ndvis::IndexBufferView{expected_edges.data(), expected_edges.size()});
+    assert(reference.intersection_count > 0);
+
+    std::vector<float> points(edge_count * dimension);
+    std::vector<unsigned int> edge_ids(edge_count);
+    const NdvisSliceResult result = ndvis_slice_polytope_with_distances(
+        NdvisBuffer{vertices.data(), vertices.size()}, vertex_count, dimension,
+        NdvisIndexBuffer{edges.data(), edges.size()}, distances.data(), NdvisBuffer{points.data(), points.size()},
+        NdvisIndexBuffer{edge_ids.data(), edge_ids.size()});
+    assert(result.intersection_count == reference.intersection_count);
+    assert(points == expected_points);
+    assert(edge_ids == expected_edges);
+
+    const NdvisSliceResult missing = ndvis_slice_polytope_with_distances(
+        NdvisBuffer{vertices.data(), vertices.size()}, vertex_count, dimension,
+        NdvisIndexBuffer{edges.data(), edges.size()}, nullptr, NdvisBuffer{points.data(), points.size()},
+        NdvisIndexBuffer{edge_ids.data(), edge_ids.size()});
+    assert(missing.intersection_count == 0);
+  }
+
+  // Offset sweep index reproduces slice_polytope at every offset
+  {
+    const std::size_t dimension = 6;
+    const std::size_t vertex_count = 2000;
+    const std::size_t edge_count = 6000;
+    std::vector<float> vertices(dimension * vertex_count);
+    fill_random(vertices.data(), vertices.size(), 167U);
+    std::vector<unsigned int> edges(edge_count * 2);
+    unsigned int state = 173U;
+    for (unsigned int& index : edges) {
+      state = state * 1664525U + 1013904223U;
+      index = (state >> 8) % static_cast<unsigned int>(vertex_count);
+    }
+    std::vector<float> normal(dimension);
+    fill_random(normal.data(), dimension, 179U);
+    const ndvis::ConstBufferView view{vertices.data(), vertices.size()};
+    const ndvis::ConstIndexBufferView edge_view{edges.data(), edges.size()};
+
+    ndvis::SliceSweepIndex index;
+    assert(!index.built());
+    assert(index.build(view, vertex_count, dimension, edge_view, normal.data()));
+    assert(index.edge_count() == edge_count);
+
+    std::vector<float> expected_points(edge_count * dimension);
+    std::vector<unsigned int> expected_edges(edge_count);
+    std::vector<float> points(edge_count * dimension);
+    std::vector<unsigned int> edge_ids(edge_count);
+    auto check = [&](const float* plane_normal, float offset, ndvis::SliceSweepIndex& sweep,
+                     const ndvis::ConstBufferView& vertex_view, std::size_t vertices_in, std::size_t dims,
+                     const ndvis::ConstIndexBufferView& edges_in) {
+      const ndvis::SliceResult expected = ndvis::slice_polytope(
+          vertex_view, vertices_in, dims, edges_in, ndvis::Hyperplane{plane_normal, dims, offset},
+          ndvis::BufferView{expected_points.data(), expected_points.size()},
+          ndvis::IndexBufferView{expected_edges.data(), expected_edges.size()});
+      const ndvis::SliceResult actual =
+          sweep.slice(offset, ndvis::BufferView{points.data(), points.size()},
+                      ndvis::IndexBufferView{edge_ids.data(), edge_ids.size()});
+      assert(actual.intersection_count == expected.intersection_count);
+      for (std::size_t i = 0; i < actual.intersection_count; ++i) {
+        assert(edge_ids[i] == expected_edges[i]);
+      }
+      for (std::size_t i = 0; i < actual.intersection_count * dims; ++i) {
+        assert(points[i] == expected_points[i]);
+      }
+      return actual.intersection_count;
+    };
+
+    std::size_t total_hits = 0;
+    for (int step = -30; step <= 30; ++step) {
+      total_hits += check(normal.data(), 0.05f * static_cast<float>(step), index, view, vertex_count, dimension,
+                          edge_view);
+    }
+    assert(total_hits > 0);
+
+    // Vertices exactly on (and within epsilon of) the plane follow the same rules
+    const int cube_dimension = 5;
+    const std::size_t cube_vertices = ndvis::hypercube_vertex_count(cube_dimension);
+    std::vector<float> cube(cube_vertices * cube_dimension);
+    std::vector<unsigned int> cube_edges(ndvis::hypercube_edge_count(cube_dimension) * 2);
+    ndvis::generate_hypercube(cube_dimension, ndvis::BufferView{cube.data(), cube.size()},
+                              ndvis::IndexBufferView{cube_edges.data(), cube_edges.size()});
+    const float axis_normal[cube_dimension] = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    ndvis::SliceSweepIndex cube_index;
+    const ndvis::ConstBufferView cube_view{cube.data(), cube.size()};
+    const ndvis::ConstIndexBufferView cube_edge_view{cube_edges.data(), cube_edges.size()};
+    assert(cube_index.build(cube_view, cube_vertices, cube_dimension, cube_edge_view, axis_normal));
+    const float cube_offsets[] = {1.0f, 1.0f - 5e-6f, 1.0f + 5e-6f, 1.0f - 2e-5f, -1.0f, 0.0f, 2.0f};
+    for (const float offset : cube_offsets) {
+      check(axis_normal, offset, cube_index, cube_view, cube_vertices, cube_dimension, cube_edge_view);
+    }
+
+    // Capacity keeps the leading hits; repeated slices reuse the scratch
+    std::vector<float> capped_points(3 * dimension);
+    std::vector<unsigned int> capped_edges(8);
+    const ndvis::SliceResult full = index.slice(0.1f, ndvis::BufferView{points.data(), points.size()},
+                                                ndvis::IndexBufferView{edge_ids.data(), edge_ids.size()});
+    assert(full.intersection_count > 3);
+    const std::size_t before = g_allocations.load();
+    NdvisSliceSweep* sweep = ndvis_slice_sweep_create();
+    assert(ndvis_slice_sweep_build(sweep, NdvisBuffer{vertices.data(), vertices.size()}, vertex_count, dimension,
+                                   NdvisIndexBuffer{edges.data(), edges.size()}, normal.data()) == 0);
+    ndvis_slice_sweep_slice(sweep, 0.1f, NdvisBuffer{points.data(), points.size()}, NdvisIndexBuffer{});
+    const std::size_t warm = g_allocations.load();
+    assert(warm > before);
+    const NdvisSliceResult capped =
+        ndvis_slice_sweep_slice(sweep, 0.1f, NdvisBuffer{capped_points.data(), capped_points.size()},
+                                NdvisIndexBuffer{capped_edges.data(), capped_edges.size()});
+    assert(g_allocations.load() == warm);
+    assert(capped.intersection_count == 3);
+    for (std::size_t hit = 0; hit < 3; ++hit) {
+      assert(capped_edges[hit] == edge_ids[hit]);
+      for (std::size_t axis = 0; axis < dimension; ++axis) {
+        assert(capped_points[axis * 3 + hit] == points[axis * full.intersection_count + hit]);
+      }
+    }
+
+    // An edge naming a missing vertex is rejected
+    edges[7] = static_cast<unsigned int>(vertex_count);
+    assert(ndvis_slice_sweep_build(sweep, NdvisBuffer{vertices.data(), vertices.size()}, vertex_count, dimension,
+                                   NdvisIndexBuffer{edges.data(), edges.size()}, normal.data()) == 1);
+    assert(ndvis_slice_sweep_slice(sweep, 0.1f, NdvisBuffer{points.data(), points.size()}, NdvisIndexBuffer{})
+               .intersection_count == 0);
+    ndvis_slice_sweep_destroy(sweep);
+  }
+
+  // Batch slicing at many offsets matches one slice_polytope call per offset
+  {
+    const std::size_t dimension = 5;
+    const std::size_t vertex_count = 1500;
+    const std::size_t edge_count = 20000;
+    std::vector<float> vertices(dimension * vertex_count);
+    fill_random(vertices.data(), vertices.size(), 181U);
+    std::vector<unsigned int> edges(edge_count * 2);
+    unsigned int state = 191U;
+    for (unsigned int& index : edges) {
+      state = state * 1664525U + 1013904223U;
+      index = (state >> 8) % static_cast<unsigned int>(vertex_count);
+    }
+    std::vector<float> normal(dimension);
+    fill_random(normal.data(), dimension, 193U);
+    // Unsorted, with a duplicate and offsets outside the geometry
+    const float offsets[] = {0.3f, -0.2f, 0.0f, 0.3f, 5.0f, -0.75f, 0.1f, -5.0f};
+    const std::size_t offset_count = sizeof(offsets) / sizeof(offsets[0]);
+    const ndvis::ConstBufferView view{vertices.data(), vertices.size()};
+    const ndvis::ConstIndexBufferView edge_view{edges.data(), edges.size()};
+
+    std::vector<std::vector<float>> expected_points(offset_count);
+    std::vector<std::vector<unsigned int>> expected_edges(offset_count);
+    std::size_t expected_total = 0;
+    for (std::size_t k = 0; k < offset_count; ++k) {
+      expected_points[k].assign(edge_count * dimension, 0.0f);
+      expected_edges[k].assign(edge_count, 0U);
+      const ndvis::SliceResult single = ndvis::slice_polytope(
+          view, vertex_count, dimension, edge_view, ndvis::Hyperplane{normal.data(), dimension, offsets[k]},
+          ndvis::BufferView{expected_points[k].data(), expected_points[k].size()},
+          ndvis::IndexBufferView{expected_edges[k].data(), expected_edges[k].size()});
+      expected_points[k].resize(single.intersection_count * dimension);
+      expected_edges[k].resize(single.intersection_count);
+      expected_total += single.intersection_count;
+    }
+    assert(expected_edges[4].empty() && expected_edges[7].empty());
+
+    std::vector<float> points(expected_total * dimension);
+    std::vector<unsigned int> edge_ids(expected_total);
+    std::size_t starts[offset_count + 1];
+    for (const std::size_t threads : {std::size_t{1}, std::size_t{4}}) {
+      ndvis::set_thread_count(threads);
+      const std::size_t total = ndvis_slice_polytope_batch(
+          NdvisBuffer{vertices.data(), vertices.size()}, vertex_count, dimension,
+          NdvisIndexBuffer{edges.data(), edges.size()}, normal.data(), offsets, offset_count,
+          NdvisBuffer{points.data(), points.size()}, NdvisIndexBuffer{edge_ids.data(), edge_ids.size()}, starts);
+      assert(total == expected_total);
+      assert(starts[0] == 0 && starts[offset_count] == total);
+      for (std::size_t k = 0; k < offset_count; ++k) {
+        const std::size_t count = starts[k + 1] - starts[k];
+        assert(count == expected_edges[k].size());
+        for (std::size_t i = 0; i < count; ++i) {
+          assert(edge_ids[starts[k] + i] == expected_edges[k][i]);
+        }
+        for (std::size_t i = 0; i < count * dimension; ++i) {
+          assert(points[starts[k] * dimension + i] == expected_points[k][i]);
+        }
+      }
+    }
+    ndvis::set_thread_count(0);
+
+    // Capacity ends partway through the second slice: the first is whole, the rest is cut from the end
+    const std::size_t first = expected_edges[0].size();
+    const std::size_t capacity = first + 3;
+    std::vector<float> capped_points(capacity * dimension);
+    const std::size_t capped_total = ndvis::slice_polytope_batch(
+        view, vertex_count, dimension, edge_view, normal.data(), offsets, offset_count,
+        ndvis::BufferView{capped_points.data(), capped_points.size()}, ndvis::IndexBufferView{}, starts);
+    assert(capped_total == capacity);
+    assert(starts[1] == first && starts[2] == capacity && starts[offset_count] == capacity);
+    for (std::size_t axis = 0; axis < dimension; ++axis) {
+      for (std::size_t hit = 0; hit < 3; ++hit) {
+        assert(capped_points[first * dimension + axis * 3 + hit] ==
+               expected_points[1][axis * expected_edges[1].size() + hit]);
+      }
+    }
+
+    const float bad_offsets[] = {0.0f, std::nanf("")};
+    assert(ndvis::slice_polytope_batch(view, vertex_count, dimension, edge_view, normal.data(), bad_offsets, 2,
+                                       ndvis::BufferView{points.data(), points.size()}, ndvis::IndexBufferView{},
+                                       starts) == 0);
+    assert(starts[0] == 0 && starts[1] == 0 && starts[2] == 0);
+  }
+
+  // Generated 2-faces are closed edge cycles of the generated polytopes
+  {
+    struct Case {
+      int dimension;
+      std::size_t (*vertex_count)(int);
+      std::size_t (*edge_count)(int);
+      std::size_t (*face_count)(int);
+      ndvis::PolytopeBuffers (*generate)(int, ndvis::BufferView, ndvis::IndexBufferView);
+      ndvis::FaceBuffers (*generate_faces)(int, ndvis::IndexBufferView, ndvis::IndexBufferView);
+      std::size_t expected_faces;
+    };
+    const Case cases[] = {
+        {2, ndvis::hypercube_vertex_count, ndvis::hypercube_edge_count, ndvis::hypercube_face_count,
+         ndvis::generate_hypercube, ndvis::generate_hypercube_faces, 1},
+        {5, ndvis::hypercube_vertex_count, ndvis::hypercube_edge_count, ndvis::hypercube_face_count,
+         ndvis::generate_hypercube, ndvis::generate_hypercube_faces, 80},
+        {4, ndvis::simplex_vertex_count, ndvis::simplex_edge_count, ndvis::simplex_face_count,
+         ndvis::generate_simplex, ndvis::generate_simplex_faces, 10},
+        {2, ndvis::orthoplex_vertex_count, ndvis::orthoplex_edge_count, ndvis::orthoplex_face_count,
+         ndvis::generate_orthoplex, ndvis::generate_orthoplex_faces, 1},
+        {4, ndvis::orthoplex_vertex_count, ndvis::orthoplex_edge_count, ndvis::orthoplex_face_count,
+         ndvis::generate_orthoplex, ndvis::generate_orthoplex_faces, 32},
+    };
+    for (const Case& c : cases) {
+      const std::size_t n = static_cast<std::size_t>(c.dimension);
+      std::vector<float> vertices(c.vertex_count(c.dimension) * n);
+      std::vector<unsigned int> edges(c.edge_count(c.dimension) * 2);
+      c.generate(c.dimension, ndvis::BufferView{vertices.data(), vertices.size()},
+                 ndvis::IndexBufferView{edges.data(), edges.size()});
+      const std::size_t face_count = c.face_count(c.dimension);
+      assert(face_count == c.expected_faces);
+      std::vector<unsigned int> offsets(face_count + 1);
+      std::vector<unsigned int> face_edges(face_count * 4);
+      const ndvis::FaceBuffers faces = c.generate_faces(c.dimension, ndvis::IndexBufferView{offsets.data(), offsets.size()},
+                                                        ndvis::IndexBufferView{face_edges.data(), face_edges.size()});
+      assert(faces.face_count == face_count);
+      for (std::size_t f = 0; f < face_count; ++f) {
+        const std::size_t begin = offsets[f];
+        const std::size_t size = offsets[f + 1] - begin;
+        assert(size == 3 || size == 4);
+        for (std::size_t i = 0; i < size; ++i) {
+          const unsigned int e0 = face_edges[begin + i];
+          const unsigned int e1 = face_edges[begin + (i + 1) % size];
+          assert(e0 < edges.size() / 2 && e1 < edges.size() / 2 && e0 != e1);
+          const bool shared = edges[2 * e0] == edges[2 * e1] || edges[2 * e0] == edges[2 * e1 + 1] ||
+                              edges[2 * e0 + 1] == edges[2 * e1] || edges[2 * e0 + 1] == edges[2 * e1 + 1];
+          assert(shared);
+        }
+      }
+    }
+    std::vector<unsigned int> short_offsets(2);
+    std::vector<unsigned int> short_edges(3);
+    assert(ndvis::generate_hypercube_faces(2, ndvis::IndexBufferView{short_offsets.data(), short_offsets.size()},
+                                           ndvis::IndexBufferView{short_edges.data(), short_edges.size()})
+               .face_count == 0);
+  }
+
+  // Cross-section topology: generic cuts give a simple polytope, vertex cuts dedupe onto the vertices
+  {
+    const int dimension = 4;
+    const std::size_t n = 4;
+    const std::size_t vertex_count = ndvis::hypercube_vertex_count(dimension);
+    const std::size_t edge_count = ndvis::hypercube_edge_count(dimension);
+    std::vector<float> vertices(vertex_count * n);
+    std::vector<unsigned int> edges(edge_count * 2);
+    ndvis::generate_hypercube(dimension, ndvis::BufferView{vertices.data(), vertices.size()},
+                              ndvis::IndexBufferView{edges.data(), edges.size()});
+    const std::size_t face_count = ndvis::hypercube_face_count(dimension);
+    std::vector<unsigned int> offsets(face_count + 1);
+    std::vector<unsigned int> face_edges(face_count * 4);
+    ndvis::generate_hypercube_faces(dimension, ndvis::IndexBufferView{offsets.data(), offsets.size()},
+                                    ndvis::IndexBufferView{face_edges.data(), face_edges.size()});
+    const ndvis::ConstBufferView view{vertices.data(), vertices.size()};
+    const ndvis::ConstIndexBufferView edge_view{edges.data(), edges.size()};
+    const ndvis::ConstFaceView face_view{ndvis::ConstIndexBufferView{offsets.data(), offsets.size()},
+                                         ndvis::ConstIndexBufferView{face_edges.data(), face_edges.size()}};
+
+    const float normal[n] = {0.5f, 0.3f, -0.6f, 0.2f};
+    const ndvis::Hyperplane plane{normal, n, 0.15f};
+    std::vector<float> slice_points(edge_count * n);
+    std::vector<unsigned int> slice_edges(edge_count);
+    const ndvis::SliceResult slice = ndvis::slice_polytope(view, vertex_count, n, edge_view, plane,
+                                                           ndvis::BufferView{slice_points.data(), slice_points.size()},
+                                                           ndvis::IndexBufferView{slice_edges.data(), slice_edges.size()});
+
+    std::vector<float> points(edge_count * n);
+    std::vector<unsigned int> section_edges(edge_count * 4);
+    std::vector<unsigned int> sources(edge_count);
+    const ndvis::SectionResult section = ndvis::slice_section(
+        view, vertex_count, n, edge_view, face_view, plane, ndvis::BufferView{points.data(), points.size()},
+        ndvis::IndexBufferView{section_edges.data(), section_edges.size()},
+        ndvis::IndexBufferView{sources.data(), sources.size()});
+    assert(!section.truncated);
+    // No vertex on the plane: one section vertex per crossing edge, as slice_polytope reports them
+    assert(section.vertex_count == slice.intersection_count);
+    for (std::size_t i = 0; i < section.vertex_count; ++i) {
+      assert(sources[i] == slice_edges[i]);
+    }
+    for (std::size_t i = 0; i < section.vertex_count * n; ++i) {
+      assert(points[i] == slice_points[i]);
+    }
+    // A generic cut of the 4-cube is a simple 3-polytope: every section vertex lies on three 2-faces
+    std::vector<int> degree(section.vertex_count, 0);
+    for (std::size_t i = 0; i < section.edge_count; ++i) {
+      assert(section_edges[2 * i] < section_edges[2 * i + 1]);
+      ++degree[section_edges[2 * i]];
+      ++degree[section_edges[2 * i + 1]];
+    }
+    for (const int d : degree) {
+      assert(d == 3);
+    }
+    assert(2 * section.edge_count == 3 * section.vertex_count);
+
+    // x + y = 0 through the 3-cube passes four vertices; the section is the rectangle on them
+    const int cube_dimension = 3;
+    const std::size_t cube_vertices = ndvis::hypercube_vertex_count(cube_dimension);
+    std::vector<float> cube(cube_vertices * 3);
+    std::vector<unsigned int> cube_edges(ndvis::hypercube_edge_count(cube_dimension) * 2);
+    ndvis_generate_hypercube(cube_dimension, NdvisBuffer{cube.data(), cube.size()},
+                             NdvisIndexBuffer{cube_edges.data(), cube_edges.size()});
+    std::vector<unsigned int> cube_offsets(ndvis_hypercube_face_count(cube_dimension) + 1);
+    std::vector<unsigned int> cube_faces(ndvis_hypercube_face_count(cube_dimension) * 4);
+    ndvis_generate_hypercube_faces(cube_dimension, NdvisIndexBuffer{cube_offsets.data(), cube_offsets.size()},
+                                   NdvisIndexBuffer{cube_faces.data(), cube_faces.size()});
+    float diagonal[3] = {1.0f, 1.0f, 0.0f};
+    std::vector<float> rectangle(12 * 3);
+    std::vector<unsigned int> rectangle_edges(24);
+    const NdvisSectionResult touching = ndvis_slice_section(
+        NdvisBuffer{cube.data(), cube.size()}, cube_vertices, 3, NdvisIndexBuffer{cube_edges.data(), cube_edges.size()},
+        NdvisIndexBuffer{cube_offsets.data(), cube_offsets.size()}, NdvisIndexBuffer{cube_faces.data(), cube_faces.size()},
+        NdvisHyperplane{diagonal, 3, 0.0f}, NdvisBuffer{rectangle.data(), rectangle.size()},
+        NdvisIndexBuffer{rectangle_edges.data(), rectangle_edges.size()}, NdvisIndexBuffer{});
+    assert(touching.truncated == 0);
+    assert(touching.vertex_count == 4 && touching.edge_count == 4);
+    for (std::size_t i = 0; i < touching.vertex_count; ++i) {
+      // Snapped exactly onto the cube vertex
+      const float x = rectangle[i];
+      const float y = rectangle[touching.vertex_count + i];
+      const float z = rectangle[2 * touching.vertex_count + i];
+      assert(x == -y && std::abs(x) == 1.0f && std::abs(z) == 1.0f);
+    }
+    std::vector<int> rectangle_degree(4, 0);
+    for (std::size_t i = 0; i < 2 * touching.edge_count; ++i) {
+      ++rectangle_degree[rectangle_edges[i]];
+    }
+    for (const int d : rectangle_degree) {
+      assert(d == 2);
+    }
+
+    // Short buffers truncate; kept edges only join kept vertices
+    std::vector<float> few_points(3 * n);
+    std::vector<unsigned int> few_edges(4);
+    const ndvis::SectionResult capped = ndvis::slice_section(
+        view, vertex_count, n, edge_view, face_view, plane, ndvis::BufferView{few_points.data(), few_points.size()},
+        ndvis::IndexBufferView{few_edges.data(), few_edges.size()}, ndvis::IndexBufferView{});
+    assert(capped.truncated && capped.vertex_count == 3);
+    for (std::size_t i = 0; i < 2 * capped.edge_count; ++i) {
+      assert(few_edges[i] < 3);
+    }
+
+    // Face edges out of range are rejected
+    face_edges[5] = static_cast<unsigned int>(edge_count);
+    assert(ndvis::slice_section(view, vertex_count, n, edge_view, face_view, plane,
+                                ndvis::BufferView{points.data(), points.size()}, ndvis::IndexBufferView{},
+                                ndvis::IndexBufferView{})
+               .vertex_count == 0);
+    face_edges[5] = 0;
+
+    // Offsets must hold at least the leading zero, and listed face edges need an edge list
+    const auto section_vertices = [&](const ndvis::ConstFaceView& faces) {
+      return ndvis::slice_section(view, vertex_count, n, edge_view, faces, plane,
+                                  ndvis::BufferView{points.data(), points.size()}, ndvis::IndexBufferView{},
+                                  ndvis::IndexBufferView{})
+          .vertex_count;
+    };
+    const ndvis::ConstIndexBufferView face_edge_view{face_edges.data(), face_edges.size()};
+    assert(section_vertices(ndvis::ConstFaceView{ndvis::ConstIndexBufferView{offsets.data(), 0}, face_edge_view}) ==
+           0);
+    assert(ndvis_slice_section(NdvisBuffer{vertices.data(), vertices.size()}, vertex_count, n,
+                               NdvisIndexBuffer{edges.data(), edges.size()}, NdvisIndexBuffer{offsets.data(), 0},
+                               NdvisIndexBuffer{face_edges.data(), face_edges.size()},
+                               NdvisHyperplane{normal, n, 0.15f}, NdvisBuffer{points.data(), points.size()},
+                               NdvisIndexBuffer{}, NdvisIndexBuffer{})
+               .vertex_count == 0);
+    const unsigned int shifted_offsets[2] = {4, 8};
+    assert(section_vertices(ndvis::ConstFaceView{ndvis::ConstIndexBufferView{shifted_offsets, 2}, face_edge_view}) ==
+           0);
+    const unsigned int trailing_edges[1] = {4};
+    assert(section_vertices(ndvis::ConstFaceView{ndvis::ConstIndexBufferView{trailing_edges, 1},
+                                                 ndvis::ConstIndexBufferView{}}) == 0);
+    assert(section_vertices(ndvis::ConstFaceView{ndvis::ConstIndexBufferView{offsets.data(), offsets.size()},
+                                                 ndvis::ConstIndexBufferView{}}) == 0);
+    // No faces at all: the section vertices without edges
+    const unsigned int no_faces[1] = {0};
+    std::vector<unsigned int> unused_edges(8);
+    const ndvis::SectionResult bare = ndvis::slice_section(
+        view, vertex_count, n, edge_view,
+        ndvis::ConstFaceView{ndvis::ConstIndexBufferView{no_faces, 1}, ndvis::ConstIndexBufferView{}}, plane,
+        ndvis::BufferView{points.data(), points.size()},
+        ndvis::IndexBufferView{unused_edges.data(), unused_edges.size()}, ndvis::IndexBufferView{});
+    assert(bare.vertex_count == slice.intersection_count && bare.edge_count == 0 && !bare.truncated);
+  }
+
   return 0;
 }
@@ -23,7 +23,7 @@ emcc \
   -sWASM=1 -O3 -flto -msimd128 \
   -sMODULARIZE=1 -sEXPORT_ES6=1 -sENVIRONMENT=web \
   -sALLOW_MEMORY_GROWTH=1 \
-  -sEXPORTED_FUNCTIONS='["_malloc","_free","_ndvis_compute_pca_with_values","_ndvis_compute_overlays","_ndvis_project_geometry","_ndvis_apply_rotations","_ndvis_compute_orthogonality_drift","_ndvis_reorthonormalize","_ndvis_generate_hypercube"]' \
+  -sEXPORTED_FUNCTIONS='["_malloc","_free","_ndvis_compute_pca_with_values","_ndvis_compute_overlays","_ndvis_project_geometry","_ndvis_apply_rotations","_ndvis_compute_orthogonality_drift","_ndvis_reorthonormalize","_ndvis_generate_hypercube","_ndvis_set_thread_count","_ndvis_build_projection_operator","_ndvis_project_geometry_incremental","_ndvis_project_hypercube","_ndvis_project_simplex","_ndvis_project_orthoplex","_ndvis_slice_hypercube","_ndvis_apply_angular_velocity","_ndvis_drift_scheduler_init","_ndvis_apply_rotations_scheduled","_ndvis_reorthonormalize_workspace_size","_ndvis_reorthonormalize_with_workspace","_ndvis_rotation4_identity","_ndvis_rotation4_apply","_ndvis_rotation4_to_matrix","_ndvis_compute_pca_with_report","_ndvis_compute_pca_components","_ndvis_streaming_pca_create","_ndvis_streaming_pca_destroy","_ndvis_streaming_pca_reset","_ndvis_streaming_pca_add","_ndvis_streaming_pca_remove","_ndvis_streaming_pca_count","_ndvis_streaming_pca_compute","_ndvis_pca_workspace_size","_ndvis_compute_pca_with_workspace","_ndvis_progressive_pca_create","_ndvis_progressive_pca_destroy","_ndvis_progressive_pca_begin","_ndvis_progressive_pca_refine","_ndvis_progressive_pca_progress","_ndvis_progressive_pca_approximate","_ndvis_progressive_pca_refined","_ndvis_compute_cluster_pca","_ndvis_compute_pca_with_solver","_ndvis_slice_workspace_size","_ndvis_slice_polytope_with_workspace","_ndvis_compute_signed_distances","_ndvis_classify_distances","_ndvis_slice_polytope_with_distances","_ndvis_slice_sweep_create","_ndvis_slice_sweep_destroy","_ndvis_slice_sweep_build","_ndvis_slice_sweep_slice","_ndvis_slice_polytope_batch","_ndvis_hypercube_face_count","_ndvis_generate_hypercube_faces","_ndvis_simplex_face_count","_ndvis_generate_simplex_faces","_ndvis_orthoplex_face_count","_ndvis_generate_orthoplex_faces","_ndvis_slice_section"]' \
   -sEXPORTED_RUNTIME_METHODS=ccall,cwrap,stringToUTF8,lengthBytesUTF8,HEAPF32,HEAPU8,HEAPU32,HEAP32 \
   "${THREAD_FLAGS[@]}"
 